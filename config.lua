@@ -4,11 +4,14 @@
 size = 8
 --size = {16, 1, 1}
 --size = 64
+-- a sequence of sizes, each solved from the last one's solution.  entries can be per-axis too
+--sizes = {16, 32, 64}
 -- 10*8^3 = 5120
 
 -- body specifies the radius of the problem, and the initial stress energy primitives
 --body = 'Null'
 body = 'earth'
+--body = 'earth_prem'	-- PREM layered density and pressure, from prem.txt
 --body = 'sun'
 --body = 'EMUniformField'
 --body = 'em_line'
@@ -19,6 +22,7 @@ bodyRadii = 2
 -- initCond specifies the inital metric primitives
 initCond = 'flat'
 --initCond = 'stellar_schwarzschild'
+--initCond = 'stellar_tov'	-- TOV integration of the body's density, with hydrostatic pressure
 --initCond = 'stellar_kerr_newman'
 --initCond = 'EMUniformField'
 --initCond = 'em_line'
@@ -27,6 +31,35 @@ initCond = 'flat'
 --solver = 'conjres'
 --solver = 'gmres'
 solver = 'jfnk'
+--solver = 'broyden'	-- limited-memory Broyden, seeded by a couple of jfnk steps
+--solver = 'pseudotime'	-- relaxation with local time steps and Anderson mixing
+--solver = 'fas'	-- nonlinear multigrid.  coarsens while the grid size stays even
+--solver = 'linearized'	-- weak-field Poisson solves about flat space.  stationary metrics only
+--solver = 'cfc'	-- conformally flat psi, alpha, beta by nonlinear Poisson solves.  stationary metrics only
+
+-- how the jfnk picks its step length along the Newton direction
+lineSearch = 'bisect'
+--lineSearch = 'none'
+--lineSearch = 'armijo'	-- backtracking with parabolic interpolation
+--lineSearch = 'trust_region'
+--lineSearch = 'parallel'	-- backtracking that tries several step lengths at once, each on its own share of the threads
+
+-- how many vectors the jfnk's GMRES recycles across restarts and Newton steps.  0 = plain GMRES
+gmresRecycle = 0
+--gmresRecycle = 10
+
+-- preconditioner for the jfnk's GMRES
+preconditioner = 'none'
+--preconditioner = 'schwarz'	-- overlapping boxes, one per thread, each solving its own linearized EFE
+--preconditioner = 'ilu'	-- block ILU(0) of the colored jacobian below
+
+-- how the jfnk's GMRES gets its Jacobian-vector products
+jacobian = 'matrixfree'	-- an F evaluation each
+--jacobian = 'colored'	-- sparse products with a Jacobian assembled from 27 * 10 F evaluations
+
+-- how many Newton steps an assembled Jacobian is used for
+jacobianReuse = 1
+--jacobianReuse = 3
 
 -- how many solver iterations to run.
 -- right now all linear solvers fail (maybe because I'm adjusting b mid-step?)
@@ -35,4 +68,62 @@ solver = 'jfnk'
 -- ... I think fixing that last one will help the results converge.
 maxiter = 1000
 
+-- only recompute the residual around cells whose metric changed since the last evaluation
+dirtyRegions = false
+--dirtyRegions = true
+-- cells that moved less than this count as unchanged.  0 = exact
+dirtyRegionTolerance = 0
+
+-- pseudo-time relaxation steps to run before the solver, as a cheap warm start
+--warmStartSteps = 20
+
+-- start from the weak-field (linearized) solution, before the warm start steps and the solver
+linearizedWarmStart = false
+--linearizedWarmStart = true
+
+-- mass continuation: ramp the sources from 0 to 1, starting from the init cond (and any warm start), with the solver taking each step
+-- the step size adapts to how quickly the solver converges.  with a sequence of sizes only the first is ramped
+continuation = false
+--continuation = true
+continuationStep = .1
+-- start the ramp from flat space instead.  this ignores initCond, linearizedWarmStart, warmStartSteps and the last grid's or run's solution
+continuationFlatStart = false
+--continuationFlatStart = true
+
+-- jfnk solves for the lapse only, holding the rest of the metric fixed
+convergeAlphaOnly = true
+--convergeAlphaOnly = false
+
+-- time each step of the jfnk's F evaluations
+printTime = false
+--printTime = true
+
+-- print the range of g_ab, g^ab, Gamma^a_bc and the EFE after each jfnk iteration
+printRanges = true
+--printRanges = false
+
+-- E and B from the charge and current densities, through A^a, instead of given directly.  doesn't work with fas or ensembleMasses
+useChargeCurrentForEM = false
+--useChargeCurrentForEM = true
+
+-- how G_ab is computed
+einstein = 'generated'	-- the kernel from generate_EinsteinLL.lua
+--einstein = 'Ricci'	-- loop over every index, R_ab from Gamma^a_bc and Gamma^a_bc,d
+--einstein = 'Riemann'	-- loop over every index, R^a_bcd first
+
+-- how the Ricci and Riemann paths get Gamma^a_bc,d
+dGamma = 'metric'	-- from g_ab,cd
+--dGamma = 'Gamma'	-- finite difference of Gamma^a_bc
+
 outputFilename = 'out.txt'
+
+-- batch of runs: each entry overrides any of the keys above (plus mass in kg and radius in m for uniform spherical bodies)
+-- same-sized grids are reused, each run starts from the nearest solved one of the same body, and the output files get numbered
+--runs = {{body='earth'}, {body='earth', mass=1.2e+25}, {body='sun', size=16}, {body='earth', bodyRadii=4}}
+
+-- after solving, solve the same uniform spherical body for each of these masses (kg), several at a time in the lanes of one residual evaluation
+-- this relaxes the whole metric, whatever convergeAlphaOnly is
+--ensembleMasses = {5.9e+24, 5.95e+24, 6e+24, 6.05e+24}
+-- pseudo-time steps the ensemble takes at most, and the fraction of its starting residual it stops at
+--ensembleMaxIter = 1000
+--ensembleTolerance = 1e-6
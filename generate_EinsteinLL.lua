@@ -0,0 +1,340 @@
+#!/usr/bin/env luajit
+--[[
+generates src/EinsteinLL.h
+usage: ./generate_EinsteinLL.lua > src/EinsteinLL.h
+
+calc_EinsteinLL with loops does ~7000 multiplies per cell, mostly building Gamma^a_bc,d.
+Instead, expand the Ricci tensor in terms of what we already store per cell:
+
+Gamma^a_bc,d = -g^ae g_ef,d Gamma^f_bc + 1/2 g^ae (g_eb,cd + g_ec,bd - g_bc,ed)
+R_ab = Gamma^c_ab,c - Gamma^c_ac,b + Gamma^c_ab Gamma^d_dc - Gamma^d_ac Gamma^c_bd
+split g_ef,c = Gamma_efc + Gamma_fec and the Gamma^c_fc Gamma^f_ab and Gamma^c_fb Gamma^f_ac terms cancel, leaving
+R_ab = 1/2 g^ce (g_eb,ac + g_ac,eb - g_ab,ce - g_ce,ab) - g^ce Gamma_fce Gamma^f_ab + Gamma^f_ac g^ce Gamma_feb
+
+Every expression is kept as a sum of products of named scalars.
+Symmetric indexes are sorted before naming, so like terms combine on their own.
+Scalars that are known to be zero drop whatever term they are in.
+--]]
+
+local dim = 4
+
+local function sym(a,b)
+	if a > b then a,b = b,a end
+	return a..b
+end
+
+local function fmtnum(x)
+	return ('%g'):format(x)
+end
+
+-- expression = sum of coeff * product of factors
+local Expr = {}
+Expr.__index = Expr
+
+local function newExpr()
+	return setmetatable({keys={}, terms={}}, Expr)
+end
+
+-- the generator state: which scalars are zero, which are aliased, which inputs are used, and the emitted lines
+local Gen = {}
+Gen.__index = Gen
+
+local function newGen(zeros)
+	return setmetatable({
+		zeros = zeros,
+		aliases = {},
+		inputs = {},
+		inputSet = {},
+		lines = {},
+		muls = 0,
+		adds = 0,
+	}, Gen)
+end
+
+function Gen:input(name, access)
+	if self.zeros[name] then return nil end
+	if not self.inputSet[name] then
+		self.inputSet[name] = access
+	end
+	return name
+end
+
+-- add coeff * factors... to the expression.  nil factors are zero.
+function Gen:add(expr, coeff, ...)
+	local factors = {}
+	for i=1,select('#', ...) do
+		local f = select(i, ...)
+		if f == nil then return end
+		f = self.aliases[f] or f
+		if self.zeros[f] then return end
+		factors[#factors+1] = f
+	end
+	table.sort(factors)
+	local key = table.concat(factors, '*')
+	local term = expr.terms[key]
+	if term then
+		term.coeff = term.coeff + coeff
+	else
+		expr.keys[#expr.keys+1] = key
+		expr.terms[key] = {coeff=coeff, factors=factors}
+	end
+end
+
+-- emit 'const Real name = expr;'
+-- returns the name to use for this value, or nil if it is zero
+function Gen:define(name, expr, lhs)
+	local terms = {}
+	for _,key in ipairs(expr.keys) do
+		local term = expr.terms[key]
+		if term.coeff ~= 0 then terms[#terms+1] = term end
+	end
+	if #terms == 0 then
+		self.zeros[name] = true
+		return nil
+	end
+	if not lhs and #terms == 1 and terms[1].coeff == 1 and #terms[1].factors == 1 then
+		self.aliases[name] = terms[1].factors[1]
+		return terms[1].factors[1]
+	end
+	for _,term in ipairs(terms) do
+		for _,f in ipairs(term.factors) do
+			if self.inputSet[f] and not self.inputs[f] then
+				self.inputs[f] = true
+				self.inputs[#self.inputs+1] = f
+			end
+		end
+	end
+	-- factor out the last factor of products that share it, i.e. g^ce (g_ab,ce + ...)
+	local groups = {}
+	local groupOf = {}
+	for _,term in ipairs(terms) do
+		local last = #term.factors > 1 and term.factors[#term.factors] or ''
+		if not groupOf[last] then
+			groupOf[last] = {}
+			groups[#groups+1] = {last=last, terms=groupOf[last]}
+		end
+		local group = groupOf[last]
+		group[#group+1] = term
+	end
+	local s = {}
+	for _,group in ipairs(groups) do
+		local last = group.last
+		if last ~= '' and #group.terms > 1 then
+			-- and factor out the coefficient if they all share it
+			local c = math.abs(group.terms[1].coeff)
+			for _,term in ipairs(group.terms) do
+				if math.abs(term.coeff) ~= c then c = 1 end
+			end
+			local inner = {}
+			for j,term in ipairs(group.terms) do
+				local tc = term.coeff / c
+				local prefix
+				if j == 1 then
+					prefix = tc < 0 and '-' or ''
+				else
+					prefix = tc < 0 and ' - ' or ' + '
+				end
+				tc = math.abs(tc)
+				local product = table.concat(term.factors, ' * ', 1, #term.factors-1)
+				self.muls = self.muls + #term.factors - 2
+				if tc ~= 1 then
+					product = fmtnum(tc)..' * '..product
+					self.muls = self.muls + 1
+				end
+				inner[#inner+1] = prefix..product
+			end
+			self.adds = self.adds + #group.terms - 1
+			local product = last..' * ('..table.concat(inner)..')'
+			self.muls = self.muls + 1
+			if c ~= 1 then
+				product = fmtnum(c)..' * '..product
+				self.muls = self.muls + 1
+			end
+			s[#s+1] = (#s > 0 and '\n\t\t+ ' or '')..product
+		else
+			for _,term in ipairs(group.terms) do
+				local c = term.coeff
+				local prefix
+				if #s == 0 then
+					prefix = c < 0 and '-' or ''
+				else
+					prefix = c < 0 and '\n\t\t- ' or '\n\t\t+ '
+				end
+				c = math.abs(c)
+				local product = table.concat(term.factors, ' * ')
+				self.muls = self.muls + #term.factors - 1
+				if c ~= 1 then
+					product = fmtnum(c)..' * '..product
+					self.muls = self.muls + 1
+				end
+				s[#s+1] = prefix..product
+			end
+		end
+	end
+	self.adds = self.adds + #s - 1
+	self.lines[#self.lines+1] = '\t'..(lhs or ('const Real '..name))..' = '..table.concat(s)..';'
+	return name
+end
+
+function Gen:gUU(a,b) return self:input('gUU_'..sym(a,b), 'gUU('..a..','..b..')') end
+function Gen:gLL(a,b) return self:input('gLL_'..sym(a,b), 'gLL('..a..','..b..')') end
+function Gen:GammaULL(a,b,c) return self:input('GammaULL_'..a..'_'..sym(b,c), 'GammaULL('..a..','..b..','..c..')') end
+function Gen:dgLLL(a,b,c) return self:input('dgLLL_'..sym(a,b)..'_'..c, 'dgLLL('..a..','..b..','..c..')') end
+function Gen:d2gLLLL(a,b,c,d) return self:input('d2gLLLL_'..sym(a,b)..'_'..sym(c,d), 'd2gLLLL('..a..','..b..','..c..','..d..')') end
+
+-- returns the body of the function, and the multiply and add counts
+local function generateBody(zeros)
+	local gen = newGen(zeros)
+
+	-- Gamma_abc = 1/2 (g_ab,c + g_ac,b - g_bc,a)
+	local GammaLLL = {}
+	for a=0,dim-1 do
+		GammaLLL[a] = {}
+		for b=0,dim-1 do
+			GammaLLL[a][b] = {}
+		end
+		for b=0,dim-1 do
+			for c=b,dim-1 do
+				local expr = newExpr()
+				gen:add(expr, .5, gen:dgLLL(a,b,c))
+				gen:add(expr, .5, gen:dgLLL(a,c,b))
+				gen:add(expr, -.5, gen:dgLLL(b,c,a))
+				local v = gen:define('GammaLLL_'..a..'_'..sym(b,c), expr)
+				GammaLLL[a][b][c] = v
+				GammaLLL[a][c][b] = v
+			end
+		end
+	end
+
+	-- g^bc Gamma_abc
+	local trGammaL = {}
+	for a=0,dim-1 do
+		local expr = newExpr()
+		for b=0,dim-1 do
+			for c=0,dim-1 do
+				gen:add(expr, 1, gen:gUU(b,c), GammaLLL[a][b][c])
+			end
+		end
+		trGammaL[a] = gen:define('trGammaL_'..a, expr)
+	end
+
+	-- Gamma_a^b_c = g^bd Gamma_adc
+	local GammaLUL = {}
+	for a=0,dim-1 do
+		GammaLUL[a] = {}
+		for b=0,dim-1 do
+			GammaLUL[a][b] = {}
+			for c=0,dim-1 do
+				local expr = newExpr()
+				for d=0,dim-1 do
+					gen:add(expr, 1, gen:gUU(b,d), GammaLLL[a][d][c])
+				end
+				GammaLUL[a][b][c] = gen:define('GammaLUL_'..a..'_'..b..'_'..c, expr)
+			end
+		end
+	end
+
+	-- R_ab = 1/2 g^ce (g_eb,ac + g_ac,eb - g_ab,ce - g_ce,ab) - g^ce Gamma_fce Gamma^f_ab + Gamma^f_ac Gamma_f^c_b
+	local RicciLL = {}
+	for a=0,dim-1 do
+		RicciLL[a] = {}
+	end
+	for a=0,dim-1 do
+		for b=a,dim-1 do
+			local expr = newExpr()
+			for c=0,dim-1 do
+				for e=0,dim-1 do
+					gen:add(expr, .5, gen:gUU(c,e), gen:d2gLLLL(e,b,a,c))
+					gen:add(expr, .5, gen:gUU(c,e), gen:d2gLLLL(a,c,e,b))
+					gen:add(expr, -.5, gen:gUU(c,e), gen:d2gLLLL(a,b,c,e))
+					gen:add(expr, -.5, gen:gUU(c,e), gen:d2gLLLL(c,e,a,b))
+				end
+			end
+			for f=0,dim-1 do
+				gen:add(expr, -1, trGammaL[f], gen:GammaULL(f,a,b))
+				for c=0,dim-1 do
+					gen:add(expr, 1, gen:GammaULL(f,a,c), GammaLUL[f][c][b])
+				end
+			end
+			local v = gen:define('RicciLL_'..sym(a,b), expr)
+			RicciLL[a][b] = v
+			RicciLL[b][a] = v
+		end
+	end
+
+	-- R = g^ab R_ab
+	local expr = newExpr()
+	for a=0,dim-1 do
+		for b=0,dim-1 do
+			gen:add(expr, 1, gen:gUU(a,b), RicciLL[a][b])
+		end
+	end
+	local Gaussian = gen:define('Gaussian', expr)
+
+	-- G_ab = R_ab - 1/2 R g_ab
+	for a=0,dim-1 do
+		for b=a,dim-1 do
+			local expr = newExpr()
+			gen:add(expr, 1, RicciLL[a][b])
+			gen:add(expr, -.5, Gaussian, gen:gLL(a,b))
+			if not gen:define('EinsteinLL_'..sym(a,b), expr, 'EinsteinLL('..a..','..b..')') then
+				gen.lines[#gen.lines+1] = '\tEinsteinLL('..a..','..b..') = 0;'
+			end
+		end
+	end
+
+	local lines = {}
+	for _,name in ipairs(gen.inputs) do
+		lines[#lines+1] = '\tconst Real '..name..' = '..gen.inputSet[name]..';'
+	end
+	lines[#lines+1] = ''
+	for _,line in ipairs(gen.lines) do
+		lines[#lines+1] = line
+	end
+	return table.concat(lines, '\n'), gen.muls, gen.adds
+end
+
+local function generateFunction(name, description, zeros)
+	local body, muls, adds = generateBody(zeros)
+	return table.concat({
+		'/*',
+		description,
+		muls..' multiplies, '..adds..' adds',
+		'*/',
+		'template<typename Real>',
+		'inline TensorSLOf<Real> '..name..'(',
+		'\tconst TensorSLOf<Real>& gLL,',
+		'\tconst TensorSUOf<Real>& gUU,',
+		'\tconst TensorUSLOf<Real>& GammaULL,',
+		'\tconst TensorSLLOf<Real>& dgLLL,',
+		'\tconst TensorSLSLOf<Real>& d2gLLLL',
+		') {',
+		'\tTensorSLOf<Real> EinsteinLL;',
+		body,
+		'\treturn EinsteinLL;',
+		'}',
+	}, '\n')
+end
+
+-- stationary: g_ab,t = 0 and g_ab,tc = 0
+local stationaryZeros = {}
+for a=0,dim-1 do
+	for b=a,dim-1 do
+		stationaryZeros['dgLLL_'..sym(a,b)..'_0'] = true
+		for c=0,dim-1 do
+			stationaryZeros['d2gLLLL_'..sym(a,b)..'_'..sym(0,c)] = true
+		end
+	end
+end
+
+print(table.concat({
+	'//generated by generate_EinsteinLL.lua -- do not edit',
+	'//included from main.cpp after the Tensor typedefs',
+	'//Real is real, or an Ensemble of them',
+	'',
+	'#pragma once',
+	'',
+	generateFunction('calc_EinsteinLL_generated', 'G_ab from g_ab, g^ab, Gamma^a_bc, g_ab,c, g_ab,cd', {}),
+	'',
+	generateFunction('calc_EinsteinLL_stationary_generated', 'G_ab for a stationary metric, i.e. g_ab,t = 0 and g_ab,tc = 0', stationaryZeros),
+}, '\n'))
@@ -0,0 +1,3 @@
+//the library is the app without main().  programs that link it include src/SolverContext.h
+#define EFESOLN_LIBRARY
+#include "../../src/main.cpp"
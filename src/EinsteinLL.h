@@ -0,0 +1,1637 @@
+//generated by generate_EinsteinLL.lua -- do not edit
+//included from main.cpp after the Tensor typedefs
+//Real is real, or an Ensemble of them
+
+#pragma once
+
+/*
+G_ab from g_ab, g^ab, Gamma^a_bc, g_ab,c, g_ab,cd
+788 multiplies, 755 adds
+*/
+template<typename Real>
+inline TensorSLOf<Real> calc_EinsteinLL_generated(
+	const TensorSLOf<Real>& gLL,
+	const TensorSUOf<Real>& gUU,
+	const TensorUSLOf<Real>& GammaULL,
+	const TensorSLLOf<Real>& dgLLL,
+	const TensorSLSLOf<Real>& d2gLLLL
+) {
+	TensorSLOf<Real> EinsteinLL;
+	const Real dgLLL_00_0 = dgLLL(0,0,0);
+	const Real dgLLL_00_1 = dgLLL(0,0,1);
+	const Real dgLLL_00_2 = dgLLL(0,0,2);
+	const Real dgLLL_00_3 = dgLLL(0,0,3);
+	const Real dgLLL_01_1 = dgLLL(0,1,1);
+	const Real dgLLL_11_0 = dgLLL(1,1,0);
+	const Real dgLLL_01_2 = dgLLL(0,1,2);
+	const Real dgLLL_02_1 = dgLLL(0,2,1);
+	const Real dgLLL_12_0 = dgLLL(1,2,0);
+	const Real dgLLL_01_3 = dgLLL(0,1,3);
+	const Real dgLLL_03_1 = dgLLL(0,3,1);
+	const Real dgLLL_13_0 = dgLLL(1,3,0);
+	const Real dgLLL_02_2 = dgLLL(0,2,2);
+	const Real dgLLL_22_0 = dgLLL(2,2,0);
+	const Real dgLLL_02_3 = dgLLL(0,2,3);
+	const Real dgLLL_03_2 = dgLLL(0,3,2);
+	const Real dgLLL_23_0 = dgLLL(2,3,0);
+	const Real dgLLL_03_3 = dgLLL(0,3,3);
+	const Real dgLLL_33_0 = dgLLL(3,3,0);
+	const Real dgLLL_01_0 = dgLLL(0,1,0);
+	const Real dgLLL_11_1 = dgLLL(1,1,1);
+	const Real dgLLL_11_2 = dgLLL(1,1,2);
+	const Real dgLLL_11_3 = dgLLL(1,1,3);
+	const Real dgLLL_12_2 = dgLLL(1,2,2);
+	const Real dgLLL_22_1 = dgLLL(2,2,1);
+	const Real dgLLL_12_3 = dgLLL(1,2,3);
+	const Real dgLLL_13_2 = dgLLL(1,3,2);
+	const Real dgLLL_23_1 = dgLLL(2,3,1);
+	const Real dgLLL_13_3 = dgLLL(1,3,3);
+	const Real dgLLL_33_1 = dgLLL(3,3,1);
+	const Real dgLLL_02_0 = dgLLL(0,2,0);
+	const Real dgLLL_12_1 = dgLLL(1,2,1);
+	const Real dgLLL_22_2 = dgLLL(2,2,2);
+	const Real dgLLL_22_3 = dgLLL(2,2,3);
+	const Real dgLLL_23_3 = dgLLL(2,3,3);
+	const Real dgLLL_33_2 = dgLLL(3,3,2);
+	const Real dgLLL_03_0 = dgLLL(0,3,0);
+	const Real dgLLL_13_1 = dgLLL(1,3,1);
+	const Real dgLLL_23_2 = dgLLL(2,3,2);
+	const Real dgLLL_33_3 = dgLLL(3,3,3);
+	const Real gUU_00 = gUU(0,0);
+	const Real gUU_01 = gUU(0,1);
+	const Real gUU_02 = gUU(0,2);
+	const Real gUU_03 = gUU(0,3);
+	const Real gUU_11 = gUU(1,1);
+	const Real gUU_12 = gUU(1,2);
+	const Real gUU_13 = gUU(1,3);
+	const Real gUU_22 = gUU(2,2);
+	const Real gUU_23 = gUU(2,3);
+	const Real gUU_33 = gUU(3,3);
+	const Real d2gLLLL_01_01 = d2gLLLL(1,0,0,1);
+	const Real d2gLLLL_00_11 = d2gLLLL(0,0,1,1);
+	const Real d2gLLLL_11_00 = d2gLLLL(1,1,0,0);
+	const Real d2gLLLL_02_01 = d2gLLLL(2,0,0,1);
+	const Real d2gLLLL_01_02 = d2gLLLL(0,1,2,0);
+	const Real d2gLLLL_00_12 = d2gLLLL(0,0,1,2);
+	const Real d2gLLLL_12_00 = d2gLLLL(1,2,0,0);
+	const Real d2gLLLL_03_01 = d2gLLLL(3,0,0,1);
+	const Real d2gLLLL_01_03 = d2gLLLL(0,1,3,0);
+	const Real d2gLLLL_00_13 = d2gLLLL(0,0,1,3);
+	const Real d2gLLLL_13_00 = d2gLLLL(1,3,0,0);
+	const Real d2gLLLL_02_02 = d2gLLLL(2,0,0,2);
+	const Real d2gLLLL_00_22 = d2gLLLL(0,0,2,2);
+	const Real d2gLLLL_22_00 = d2gLLLL(2,2,0,0);
+	const Real d2gLLLL_03_02 = d2gLLLL(3,0,0,2);
+	const Real d2gLLLL_02_03 = d2gLLLL(0,2,3,0);
+	const Real d2gLLLL_00_23 = d2gLLLL(0,0,2,3);
+	const Real d2gLLLL_23_00 = d2gLLLL(2,3,0,0);
+	const Real d2gLLLL_03_03 = d2gLLLL(3,0,0,3);
+	const Real d2gLLLL_00_33 = d2gLLLL(0,0,3,3);
+	const Real d2gLLLL_33_00 = d2gLLLL(3,3,0,0);
+	const Real GammaULL_0_00 = GammaULL(0,0,0);
+	const Real GammaULL_0_01 = GammaULL(0,0,1);
+	const Real GammaULL_0_02 = GammaULL(0,0,2);
+	const Real GammaULL_0_03 = GammaULL(0,0,3);
+	const Real GammaULL_1_00 = GammaULL(1,0,0);
+	const Real GammaULL_1_01 = GammaULL(1,0,1);
+	const Real GammaULL_1_02 = GammaULL(1,0,2);
+	const Real GammaULL_1_03 = GammaULL(1,0,3);
+	const Real GammaULL_2_00 = GammaULL(2,0,0);
+	const Real GammaULL_2_01 = GammaULL(2,0,1);
+	const Real GammaULL_2_02 = GammaULL(2,0,2);
+	const Real GammaULL_2_03 = GammaULL(2,0,3);
+	const Real GammaULL_3_00 = GammaULL(3,0,0);
+	const Real GammaULL_3_01 = GammaULL(3,0,1);
+	const Real GammaULL_3_02 = GammaULL(3,0,2);
+	const Real GammaULL_3_03 = GammaULL(3,0,3);
+	const Real d2gLLLL_12_01 = d2gLLLL(2,1,0,1);
+	const Real d2gLLLL_01_12 = d2gLLLL(0,1,2,1);
+	const Real d2gLLLL_13_01 = d2gLLLL(3,1,0,1);
+	const Real d2gLLLL_01_13 = d2gLLLL(0,1,3,1);
+	const Real d2gLLLL_11_02 = d2gLLLL(1,1,0,2);
+	const Real d2gLLLL_02_11 = d2gLLLL(0,2,1,1);
+	const Real d2gLLLL_12_02 = d2gLLLL(2,1,0,2);
+	const Real d2gLLLL_02_12 = d2gLLLL(0,2,2,1);
+	const Real d2gLLLL_01_22 = d2gLLLL(0,1,2,2);
+	const Real d2gLLLL_22_01 = d2gLLLL(2,2,0,1);
+	const Real d2gLLLL_13_02 = d2gLLLL(3,1,0,2);
+	const Real d2gLLLL_02_13 = d2gLLLL(0,2,3,1);
+	const Real d2gLLLL_01_23 = d2gLLLL(0,1,2,3);
+	const Real d2gLLLL_23_01 = d2gLLLL(2,3,0,1);
+	const Real d2gLLLL_11_03 = d2gLLLL(1,1,0,3);
+	const Real d2gLLLL_03_11 = d2gLLLL(0,3,1,1);
+	const Real d2gLLLL_12_03 = d2gLLLL(2,1,0,3);
+	const Real d2gLLLL_03_12 = d2gLLLL(0,3,2,1);
+	const Real d2gLLLL_13_03 = d2gLLLL(3,1,0,3);
+	const Real d2gLLLL_03_13 = d2gLLLL(0,3,3,1);
+	const Real d2gLLLL_01_33 = d2gLLLL(0,1,3,3);
+	const Real d2gLLLL_33_01 = d2gLLLL(3,3,0,1);
+	const Real d2gLLLL_23_02 = d2gLLLL(3,2,0,2);
+	const Real d2gLLLL_02_23 = d2gLLLL(0,2,3,2);
+	const Real d2gLLLL_22_03 = d2gLLLL(2,2,0,3);
+	const Real d2gLLLL_03_22 = d2gLLLL(0,3,2,2);
+	const Real d2gLLLL_23_03 = d2gLLLL(3,2,0,3);
+	const Real d2gLLLL_03_23 = d2gLLLL(0,3,3,2);
+	const Real d2gLLLL_02_33 = d2gLLLL(0,2,3,3);
+	const Real d2gLLLL_33_02 = d2gLLLL(3,3,0,2);
+	const Real d2gLLLL_12_12 = d2gLLLL(2,1,1,2);
+	const Real d2gLLLL_11_22 = d2gLLLL(1,1,2,2);
+	const Real d2gLLLL_22_11 = d2gLLLL(2,2,1,1);
+	const Real d2gLLLL_13_12 = d2gLLLL(3,1,1,2);
+	const Real d2gLLLL_12_13 = d2gLLLL(1,2,3,1);
+	const Real d2gLLLL_11_23 = d2gLLLL(1,1,2,3);
+	const Real d2gLLLL_23_11 = d2gLLLL(2,3,1,1);
+	const Real d2gLLLL_13_13 = d2gLLLL(3,1,1,3);
+	const Real d2gLLLL_11_33 = d2gLLLL(1,1,3,3);
+	const Real d2gLLLL_33_11 = d2gLLLL(3,3,1,1);
+	const Real GammaULL_0_11 = GammaULL(0,1,1);
+	const Real GammaULL_0_12 = GammaULL(0,1,2);
+	const Real GammaULL_0_13 = GammaULL(0,1,3);
+	const Real GammaULL_1_11 = GammaULL(1,1,1);
+	const Real GammaULL_1_12 = GammaULL(1,1,2);
+	const Real GammaULL_1_13 = GammaULL(1,1,3);
+	const Real GammaULL_2_11 = GammaULL(2,1,1);
+	const Real GammaULL_2_12 = GammaULL(2,1,2);
+	const Real GammaULL_2_13 = GammaULL(2,1,3);
+	const Real GammaULL_3_11 = GammaULL(3,1,1);
+	const Real GammaULL_3_12 = GammaULL(3,1,2);
+	const Real GammaULL_3_13 = GammaULL(3,1,3);
+	const Real d2gLLLL_23_12 = d2gLLLL(3,2,1,2);
+	const Real d2gLLLL_12_23 = d2gLLLL(1,2,3,2);
+	const Real d2gLLLL_22_13 = d2gLLLL(2,2,1,3);
+	const Real d2gLLLL_13_22 = d2gLLLL(1,3,2,2);
+	const Real d2gLLLL_23_13 = d2gLLLL(3,2,1,3);
+	const Real d2gLLLL_13_23 = d2gLLLL(1,3,3,2);
+	const Real d2gLLLL_12_33 = d2gLLLL(1,2,3,3);
+	const Real d2gLLLL_33_12 = d2gLLLL(3,3,1,2);
+	const Real d2gLLLL_23_23 = d2gLLLL(3,2,2,3);
+	const Real d2gLLLL_22_33 = d2gLLLL(2,2,3,3);
+	const Real d2gLLLL_33_22 = d2gLLLL(3,3,2,2);
+	const Real GammaULL_0_22 = GammaULL(0,2,2);
+	const Real GammaULL_0_23 = GammaULL(0,2,3);
+	const Real GammaULL_1_22 = GammaULL(1,2,2);
+	const Real GammaULL_1_23 = GammaULL(1,2,3);
+	const Real GammaULL_2_22 = GammaULL(2,2,2);
+	const Real GammaULL_2_23 = GammaULL(2,2,3);
+	const Real GammaULL_3_22 = GammaULL(3,2,2);
+	const Real GammaULL_3_23 = GammaULL(3,2,3);
+	const Real GammaULL_0_33 = GammaULL(0,3,3);
+	const Real GammaULL_1_33 = GammaULL(1,3,3);
+	const Real GammaULL_2_33 = GammaULL(2,3,3);
+	const Real GammaULL_3_33 = GammaULL(3,3,3);
+	const Real gLL_00 = gLL(0,0);
+	const Real gLL_01 = gLL(0,1);
+	const Real gLL_02 = gLL(0,2);
+	const Real gLL_03 = gLL(0,3);
+	const Real gLL_11 = gLL(1,1);
+	const Real gLL_12 = gLL(1,2);
+	const Real gLL_13 = gLL(1,3);
+	const Real gLL_22 = gLL(2,2);
+	const Real gLL_23 = gLL(2,3);
+	const Real gLL_33 = gLL(3,3);
+
+	const Real GammaLLL_0_00 = 0.5 * dgLLL_00_0;
+	const Real GammaLLL_0_01 = 0.5 * dgLLL_00_1;
+	const Real GammaLLL_0_02 = 0.5 * dgLLL_00_2;
+	const Real GammaLLL_0_03 = 0.5 * dgLLL_00_3;
+	const Real GammaLLL_0_11 = dgLLL_01_1
+		- 0.5 * dgLLL_11_0;
+	const Real GammaLLL_0_12 = 0.5 * dgLLL_01_2
+		+ 0.5 * dgLLL_02_1
+		- 0.5 * dgLLL_12_0;
+	const Real GammaLLL_0_13 = 0.5 * dgLLL_01_3
+		+ 0.5 * dgLLL_03_1
+		- 0.5 * dgLLL_13_0;
+	const Real GammaLLL_0_22 = dgLLL_02_2
+		- 0.5 * dgLLL_22_0;
+	const Real GammaLLL_0_23 = 0.5 * dgLLL_02_3
+		+ 0.5 * dgLLL_03_2
+		- 0.5 * dgLLL_23_0;
+	const Real GammaLLL_0_33 = dgLLL_03_3
+		- 0.5 * dgLLL_33_0;
+	const Real GammaLLL_1_00 = dgLLL_01_0
+		- 0.5 * dgLLL_00_1;
+	const Real GammaLLL_1_01 = 0.5 * dgLLL_11_0;
+	const Real GammaLLL_1_02 = 0.5 * dgLLL_01_2
+		+ 0.5 * dgLLL_12_0
+		- 0.5 * dgLLL_02_1;
+	const Real GammaLLL_1_03 = 0.5 * dgLLL_01_3
+		+ 0.5 * dgLLL_13_0
+		- 0.5 * dgLLL_03_1;
+	const Real GammaLLL_1_11 = 0.5 * dgLLL_11_1;
+	const Real GammaLLL_1_12 = 0.5 * dgLLL_11_2;
+	const Real GammaLLL_1_13 = 0.5 * dgLLL_11_3;
+	const Real GammaLLL_1_22 = dgLLL_12_2
+		- 0.5 * dgLLL_22_1;
+	const Real GammaLLL_1_23 = 0.5 * dgLLL_12_3
+		+ 0.5 * dgLLL_13_2
+		- 0.5 * dgLLL_23_1;
+	const Real GammaLLL_1_33 = dgLLL_13_3
+		- 0.5 * dgLLL_33_1;
+	const Real GammaLLL_2_00 = dgLLL_02_0
+		- 0.5 * dgLLL_00_2;
+	const Real GammaLLL_2_01 = 0.5 * dgLLL_02_1
+		+ 0.5 * dgLLL_12_0
+		- 0.5 * dgLLL_01_2;
+	const Real GammaLLL_2_02 = 0.5 * dgLLL_22_0;
+	const Real GammaLLL_2_03 = 0.5 * dgLLL_02_3
+		+ 0.5 * dgLLL_23_0
+		- 0.5 * dgLLL_03_2;
+	const Real GammaLLL_2_11 = dgLLL_12_1
+		- 0.5 * dgLLL_11_2;
+	const Real GammaLLL_2_12 = 0.5 * dgLLL_22_1;
+	const Real GammaLLL_2_13 = 0.5 * dgLLL_12_3
+		+ 0.5 * dgLLL_23_1
+		- 0.5 * dgLLL_13_2;
+	const Real GammaLLL_2_22 = 0.5 * dgLLL_22_2;
+	const Real GammaLLL_2_23 = 0.5 * dgLLL_22_3;
+	const Real GammaLLL_2_33 = dgLLL_23_3
+		- 0.5 * dgLLL_33_2;
+	const Real GammaLLL_3_00 = dgLLL_03_0
+		- 0.5 * dgLLL_00_3;
+	const Real GammaLLL_3_01 = 0.5 * dgLLL_03_1
+		+ 0.5 * dgLLL_13_0
+		- 0.5 * dgLLL_01_3;
+	const Real GammaLLL_3_02 = 0.5 * dgLLL_03_2
+		+ 0.5 * dgLLL_23_0
+		- 0.5 * dgLLL_02_3;
+	const Real GammaLLL_3_03 = 0.5 * dgLLL_33_0;
+	const Real GammaLLL_3_11 = dgLLL_13_1
+		- 0.5 * dgLLL_11_3;
+	const Real GammaLLL_3_12 = 0.5 * dgLLL_13_2
+		+ 0.5 * dgLLL_23_1
+		- 0.5 * dgLLL_12_3;
+	const Real GammaLLL_3_13 = 0.5 * dgLLL_33_1;
+	const Real GammaLLL_3_22 = dgLLL_23_2
+		- 0.5 * dgLLL_22_3;
+	const Real GammaLLL_3_23 = 0.5 * dgLLL_33_2;
+	const Real GammaLLL_3_33 = 0.5 * dgLLL_33_3;
+	const Real trGammaL_0 = GammaLLL_0_00 * gUU_00
+		+ 2 * GammaLLL_0_01 * gUU_01
+		+ 2 * GammaLLL_0_02 * gUU_02
+		+ 2 * GammaLLL_0_03 * gUU_03
+		+ GammaLLL_0_11 * gUU_11
+		+ 2 * GammaLLL_0_12 * gUU_12
+		+ 2 * GammaLLL_0_13 * gUU_13
+		+ GammaLLL_0_22 * gUU_22
+		+ 2 * GammaLLL_0_23 * gUU_23
+		+ GammaLLL_0_33 * gUU_33;
+	const Real trGammaL_1 = GammaLLL_1_00 * gUU_00
+		+ 2 * GammaLLL_1_01 * gUU_01
+		+ 2 * GammaLLL_1_02 * gUU_02
+		+ 2 * GammaLLL_1_03 * gUU_03
+		+ GammaLLL_1_11 * gUU_11
+		+ 2 * GammaLLL_1_12 * gUU_12
+		+ 2 * GammaLLL_1_13 * gUU_13
+		+ GammaLLL_1_22 * gUU_22
+		+ 2 * GammaLLL_1_23 * gUU_23
+		+ GammaLLL_1_33 * gUU_33;
+	const Real trGammaL_2 = GammaLLL_2_00 * gUU_00
+		+ 2 * GammaLLL_2_01 * gUU_01
+		+ 2 * GammaLLL_2_02 * gUU_02
+		+ 2 * GammaLLL_2_03 * gUU_03
+		+ GammaLLL_2_11 * gUU_11
+		+ 2 * GammaLLL_2_12 * gUU_12
+		+ 2 * GammaLLL_2_13 * gUU_13
+		+ GammaLLL_2_22 * gUU_22
+		+ 2 * GammaLLL_2_23 * gUU_23
+		+ GammaLLL_2_33 * gUU_33;
+	const Real trGammaL_3 = GammaLLL_3_00 * gUU_00
+		+ 2 * GammaLLL_3_01 * gUU_01
+		+ 2 * GammaLLL_3_02 * gUU_02
+		+ 2 * GammaLLL_3_03 * gUU_03
+		+ GammaLLL_3_11 * gUU_11
+		+ 2 * GammaLLL_3_12 * gUU_12
+		+ 2 * GammaLLL_3_13 * gUU_13
+		+ GammaLLL_3_22 * gUU_22
+		+ 2 * GammaLLL_3_23 * gUU_23
+		+ GammaLLL_3_33 * gUU_33;
+	const Real GammaLUL_0_0_0 = GammaLLL_0_00 * gUU_00
+		+ GammaLLL_0_01 * gUU_01
+		+ GammaLLL_0_02 * gUU_02
+		+ GammaLLL_0_03 * gUU_03;
+	const Real GammaLUL_0_0_1 = GammaLLL_0_01 * gUU_00
+		+ GammaLLL_0_11 * gUU_01
+		+ GammaLLL_0_12 * gUU_02
+		+ GammaLLL_0_13 * gUU_03;
+	const Real GammaLUL_0_0_2 = GammaLLL_0_02 * gUU_00
+		+ GammaLLL_0_12 * gUU_01
+		+ GammaLLL_0_22 * gUU_02
+		+ GammaLLL_0_23 * gUU_03;
+	const Real GammaLUL_0_0_3 = GammaLLL_0_03 * gUU_00
+		+ GammaLLL_0_13 * gUU_01
+		+ GammaLLL_0_23 * gUU_02
+		+ GammaLLL_0_33 * gUU_03;
+	const Real GammaLUL_0_1_0 = GammaLLL_0_00 * gUU_01
+		+ GammaLLL_0_01 * gUU_11
+		+ GammaLLL_0_02 * gUU_12
+		+ GammaLLL_0_03 * gUU_13;
+	const Real GammaLUL_0_1_1 = GammaLLL_0_01 * gUU_01
+		+ GammaLLL_0_11 * gUU_11
+		+ GammaLLL_0_12 * gUU_12
+		+ GammaLLL_0_13 * gUU_13;
+	const Real GammaLUL_0_1_2 = GammaLLL_0_02 * gUU_01
+		+ GammaLLL_0_12 * gUU_11
+		+ GammaLLL_0_22 * gUU_12
+		+ GammaLLL_0_23 * gUU_13;
+	const Real GammaLUL_0_1_3 = GammaLLL_0_03 * gUU_01
+		+ GammaLLL_0_13 * gUU_11
+		+ GammaLLL_0_23 * gUU_12
+		+ GammaLLL_0_33 * gUU_13;
+	const Real GammaLUL_0_2_0 = GammaLLL_0_00 * gUU_02
+		+ GammaLLL_0_01 * gUU_12
+		+ GammaLLL_0_02 * gUU_22
+		+ GammaLLL_0_03 * gUU_23;
+	const Real GammaLUL_0_2_1 = GammaLLL_0_01 * gUU_02
+		+ GammaLLL_0_11 * gUU_12
+		+ GammaLLL_0_12 * gUU_22
+		+ GammaLLL_0_13 * gUU_23;
+	const Real GammaLUL_0_2_2 = GammaLLL_0_02 * gUU_02
+		+ GammaLLL_0_12 * gUU_12
+		+ GammaLLL_0_22 * gUU_22
+		+ GammaLLL_0_23 * gUU_23;
+	const Real GammaLUL_0_2_3 = GammaLLL_0_03 * gUU_02
+		+ GammaLLL_0_13 * gUU_12
+		+ GammaLLL_0_23 * gUU_22
+		+ GammaLLL_0_33 * gUU_23;
+	const Real GammaLUL_0_3_0 = GammaLLL_0_00 * gUU_03
+		+ GammaLLL_0_01 * gUU_13
+		+ GammaLLL_0_02 * gUU_23
+		+ GammaLLL_0_03 * gUU_33;
+	const Real GammaLUL_0_3_1 = GammaLLL_0_01 * gUU_03
+		+ GammaLLL_0_11 * gUU_13
+		+ GammaLLL_0_12 * gUU_23
+		+ GammaLLL_0_13 * gUU_33;
+	const Real GammaLUL_0_3_2 = GammaLLL_0_02 * gUU_03
+		+ GammaLLL_0_12 * gUU_13
+		+ GammaLLL_0_22 * gUU_23
+		+ GammaLLL_0_23 * gUU_33;
+	const Real GammaLUL_0_3_3 = GammaLLL_0_03 * gUU_03
+		+ GammaLLL_0_13 * gUU_13
+		+ GammaLLL_0_23 * gUU_23
+		+ GammaLLL_0_33 * gUU_33;
+	const Real GammaLUL_1_0_0 = GammaLLL_1_00 * gUU_00
+		+ GammaLLL_1_01 * gUU_01
+		+ GammaLLL_1_02 * gUU_02
+		+ GammaLLL_1_03 * gUU_03;
+	const Real GammaLUL_1_0_1 = GammaLLL_1_01 * gUU_00
+		+ GammaLLL_1_11 * gUU_01
+		+ GammaLLL_1_12 * gUU_02
+		+ GammaLLL_1_13 * gUU_03;
+	const Real GammaLUL_1_0_2 = GammaLLL_1_02 * gUU_00
+		+ GammaLLL_1_12 * gUU_01
+		+ GammaLLL_1_22 * gUU_02
+		+ GammaLLL_1_23 * gUU_03;
+	const Real GammaLUL_1_0_3 = GammaLLL_1_03 * gUU_00
+		+ GammaLLL_1_13 * gUU_01
+		+ GammaLLL_1_23 * gUU_02
+		+ GammaLLL_1_33 * gUU_03;
+	const Real GammaLUL_1_1_0 = GammaLLL_1_00 * gUU_01
+		+ GammaLLL_1_01 * gUU_11
+		+ GammaLLL_1_02 * gUU_12
+		+ GammaLLL_1_03 * gUU_13;
+	const Real GammaLUL_1_1_1 = GammaLLL_1_01 * gUU_01
+		+ GammaLLL_1_11 * gUU_11
+		+ GammaLLL_1_12 * gUU_12
+		+ GammaLLL_1_13 * gUU_13;
+	const Real GammaLUL_1_1_2 = GammaLLL_1_02 * gUU_01
+		+ GammaLLL_1_12 * gUU_11
+		+ GammaLLL_1_22 * gUU_12
+		+ GammaLLL_1_23 * gUU_13;
+	const Real GammaLUL_1_1_3 = GammaLLL_1_03 * gUU_01
+		+ GammaLLL_1_13 * gUU_11
+		+ GammaLLL_1_23 * gUU_12
+		+ GammaLLL_1_33 * gUU_13;
+	const Real GammaLUL_1_2_0 = GammaLLL_1_00 * gUU_02
+		+ GammaLLL_1_01 * gUU_12
+		+ GammaLLL_1_02 * gUU_22
+		+ GammaLLL_1_03 * gUU_23;
+	const Real GammaLUL_1_2_1 = GammaLLL_1_01 * gUU_02
+		+ GammaLLL_1_11 * gUU_12
+		+ GammaLLL_1_12 * gUU_22
+		+ GammaLLL_1_13 * gUU_23;
+	const Real GammaLUL_1_2_2 = GammaLLL_1_02 * gUU_02
+		+ GammaLLL_1_12 * gUU_12
+		+ GammaLLL_1_22 * gUU_22
+		+ GammaLLL_1_23 * gUU_23;
+	const Real GammaLUL_1_2_3 = GammaLLL_1_03 * gUU_02
+		+ GammaLLL_1_13 * gUU_12
+		+ GammaLLL_1_23 * gUU_22
+		+ GammaLLL_1_33 * gUU_23;
+	const Real GammaLUL_1_3_0 = GammaLLL_1_00 * gUU_03
+		+ GammaLLL_1_01 * gUU_13
+		+ GammaLLL_1_02 * gUU_23
+		+ GammaLLL_1_03 * gUU_33;
+	const Real GammaLUL_1_3_1 = GammaLLL_1_01 * gUU_03
+		+ GammaLLL_1_11 * gUU_13
+		+ GammaLLL_1_12 * gUU_23
+		+ GammaLLL_1_13 * gUU_33;
+	const Real GammaLUL_1_3_2 = GammaLLL_1_02 * gUU_03
+		+ GammaLLL_1_12 * gUU_13
+		+ GammaLLL_1_22 * gUU_23
+		+ GammaLLL_1_23 * gUU_33;
+	const Real GammaLUL_1_3_3 = GammaLLL_1_03 * gUU_03
+		+ GammaLLL_1_13 * gUU_13
+		+ GammaLLL_1_23 * gUU_23
+		+ GammaLLL_1_33 * gUU_33;
+	const Real GammaLUL_2_0_0 = GammaLLL_2_00 * gUU_00
+		+ GammaLLL_2_01 * gUU_01
+		+ GammaLLL_2_02 * gUU_02
+		+ GammaLLL_2_03 * gUU_03;
+	const Real GammaLUL_2_0_1 = GammaLLL_2_01 * gUU_00
+		+ GammaLLL_2_11 * gUU_01
+		+ GammaLLL_2_12 * gUU_02
+		+ GammaLLL_2_13 * gUU_03;
+	const Real GammaLUL_2_0_2 = GammaLLL_2_02 * gUU_00
+		+ GammaLLL_2_12 * gUU_01
+		+ GammaLLL_2_22 * gUU_02
+		+ GammaLLL_2_23 * gUU_03;
+	const Real GammaLUL_2_0_3 = GammaLLL_2_03 * gUU_00
+		+ GammaLLL_2_13 * gUU_01
+		+ GammaLLL_2_23 * gUU_02
+		+ GammaLLL_2_33 * gUU_03;
+	const Real GammaLUL_2_1_0 = GammaLLL_2_00 * gUU_01
+		+ GammaLLL_2_01 * gUU_11
+		+ GammaLLL_2_02 * gUU_12
+		+ GammaLLL_2_03 * gUU_13;
+	const Real GammaLUL_2_1_1 = GammaLLL_2_01 * gUU_01
+		+ GammaLLL_2_11 * gUU_11
+		+ GammaLLL_2_12 * gUU_12
+		+ GammaLLL_2_13 * gUU_13;
+	const Real GammaLUL_2_1_2 = GammaLLL_2_02 * gUU_01
+		+ GammaLLL_2_12 * gUU_11
+		+ GammaLLL_2_22 * gUU_12
+		+ GammaLLL_2_23 * gUU_13;
+	const Real GammaLUL_2_1_3 = GammaLLL_2_03 * gUU_01
+		+ GammaLLL_2_13 * gUU_11
+		+ GammaLLL_2_23 * gUU_12
+		+ GammaLLL_2_33 * gUU_13;
+	const Real GammaLUL_2_2_0 = GammaLLL_2_00 * gUU_02
+		+ GammaLLL_2_01 * gUU_12
+		+ GammaLLL_2_02 * gUU_22
+		+ GammaLLL_2_03 * gUU_23;
+	const Real GammaLUL_2_2_1 = GammaLLL_2_01 * gUU_02
+		+ GammaLLL_2_11 * gUU_12
+		+ GammaLLL_2_12 * gUU_22
+		+ GammaLLL_2_13 * gUU_23;
+	const Real GammaLUL_2_2_2 = GammaLLL_2_02 * gUU_02
+		+ GammaLLL_2_12 * gUU_12
+		+ GammaLLL_2_22 * gUU_22
+		+ GammaLLL_2_23 * gUU_23;
+	const Real GammaLUL_2_2_3 = GammaLLL_2_03 * gUU_02
+		+ GammaLLL_2_13 * gUU_12
+		+ GammaLLL_2_23 * gUU_22
+		+ GammaLLL_2_33 * gUU_23;
+	const Real GammaLUL_2_3_0 = GammaLLL_2_00 * gUU_03
+		+ GammaLLL_2_01 * gUU_13
+		+ GammaLLL_2_02 * gUU_23
+		+ GammaLLL_2_03 * gUU_33;
+	const Real GammaLUL_2_3_1 = GammaLLL_2_01 * gUU_03
+		+ GammaLLL_2_11 * gUU_13
+		+ GammaLLL_2_12 * gUU_23
+		+ GammaLLL_2_13 * gUU_33;
+	const Real GammaLUL_2_3_2 = GammaLLL_2_02 * gUU_03
+		+ GammaLLL_2_12 * gUU_13
+		+ GammaLLL_2_22 * gUU_23
+		+ GammaLLL_2_23 * gUU_33;
+	const Real GammaLUL_2_3_3 = GammaLLL_2_03 * gUU_03
+		+ GammaLLL_2_13 * gUU_13
+		+ GammaLLL_2_23 * gUU_23
+		+ GammaLLL_2_33 * gUU_33;
+	const Real GammaLUL_3_0_0 = GammaLLL_3_00 * gUU_00
+		+ GammaLLL_3_01 * gUU_01
+		+ GammaLLL_3_02 * gUU_02
+		+ GammaLLL_3_03 * gUU_03;
+	const Real GammaLUL_3_0_1 = GammaLLL_3_01 * gUU_00
+		+ GammaLLL_3_11 * gUU_01
+		+ GammaLLL_3_12 * gUU_02
+		+ GammaLLL_3_13 * gUU_03;
+	const Real GammaLUL_3_0_2 = GammaLLL_3_02 * gUU_00
+		+ GammaLLL_3_12 * gUU_01
+		+ GammaLLL_3_22 * gUU_02
+		+ GammaLLL_3_23 * gUU_03;
+	const Real GammaLUL_3_0_3 = GammaLLL_3_03 * gUU_00
+		+ GammaLLL_3_13 * gUU_01
+		+ GammaLLL_3_23 * gUU_02
+		+ GammaLLL_3_33 * gUU_03;
+	const Real GammaLUL_3_1_0 = GammaLLL_3_00 * gUU_01
+		+ GammaLLL_3_01 * gUU_11
+		+ GammaLLL_3_02 * gUU_12
+		+ GammaLLL_3_03 * gUU_13;
+	const Real GammaLUL_3_1_1 = GammaLLL_3_01 * gUU_01
+		+ GammaLLL_3_11 * gUU_11
+		+ GammaLLL_3_12 * gUU_12
+		+ GammaLLL_3_13 * gUU_13;
+	const Real GammaLUL_3_1_2 = GammaLLL_3_02 * gUU_01
+		+ GammaLLL_3_12 * gUU_11
+		+ GammaLLL_3_22 * gUU_12
+		+ GammaLLL_3_23 * gUU_13;
+	const Real GammaLUL_3_1_3 = GammaLLL_3_03 * gUU_01
+		+ GammaLLL_3_13 * gUU_11
+		+ GammaLLL_3_23 * gUU_12
+		+ GammaLLL_3_33 * gUU_13;
+	const Real GammaLUL_3_2_0 = GammaLLL_3_00 * gUU_02
+		+ GammaLLL_3_01 * gUU_12
+		+ GammaLLL_3_02 * gUU_22
+		+ GammaLLL_3_03 * gUU_23;
+	const Real GammaLUL_3_2_1 = GammaLLL_3_01 * gUU_02
+		+ GammaLLL_3_11 * gUU_12
+		+ GammaLLL_3_12 * gUU_22
+		+ GammaLLL_3_13 * gUU_23;
+	const Real GammaLUL_3_2_2 = GammaLLL_3_02 * gUU_02
+		+ GammaLLL_3_12 * gUU_12
+		+ GammaLLL_3_22 * gUU_22
+		+ GammaLLL_3_23 * gUU_23;
+	const Real GammaLUL_3_2_3 = GammaLLL_3_03 * gUU_02
+		+ GammaLLL_3_13 * gUU_12
+		+ GammaLLL_3_23 * gUU_22
+		+ GammaLLL_3_33 * gUU_23;
+	const Real GammaLUL_3_3_0 = GammaLLL_3_00 * gUU_03
+		+ GammaLLL_3_01 * gUU_13
+		+ GammaLLL_3_02 * gUU_23
+		+ GammaLLL_3_03 * gUU_33;
+	const Real GammaLUL_3_3_1 = GammaLLL_3_01 * gUU_03
+		+ GammaLLL_3_11 * gUU_13
+		+ GammaLLL_3_12 * gUU_23
+		+ GammaLLL_3_13 * gUU_33;
+	const Real GammaLUL_3_3_2 = GammaLLL_3_02 * gUU_03
+		+ GammaLLL_3_12 * gUU_13
+		+ GammaLLL_3_22 * gUU_23
+		+ GammaLLL_3_23 * gUU_33;
+	const Real GammaLUL_3_3_3 = GammaLLL_3_03 * gUU_03
+		+ GammaLLL_3_13 * gUU_13
+		+ GammaLLL_3_23 * gUU_23
+		+ GammaLLL_3_33 * gUU_33;
+	const Real RicciLL_00 = gUU_11 * (d2gLLLL_01_01 - 0.5 * d2gLLLL_00_11 - 0.5 * d2gLLLL_11_00)
+		+ gUU_12 * (d2gLLLL_02_01 + d2gLLLL_01_02 - d2gLLLL_00_12 - d2gLLLL_12_00)
+		+ gUU_13 * (d2gLLLL_03_01 + d2gLLLL_01_03 - d2gLLLL_00_13 - d2gLLLL_13_00)
+		+ gUU_22 * (d2gLLLL_02_02 - 0.5 * d2gLLLL_00_22 - 0.5 * d2gLLLL_22_00)
+		+ gUU_23 * (d2gLLLL_03_02 + d2gLLLL_02_03 - d2gLLLL_00_23 - d2gLLLL_23_00)
+		+ gUU_33 * (d2gLLLL_03_03 - 0.5 * d2gLLLL_00_33 - 0.5 * d2gLLLL_33_00)
+		- GammaULL_0_00 * trGammaL_0
+		+ GammaLUL_0_0_0 * GammaULL_0_00
+		+ GammaLUL_0_1_0 * GammaULL_0_01
+		+ GammaLUL_0_2_0 * GammaULL_0_02
+		+ GammaLUL_0_3_0 * GammaULL_0_03
+		- GammaULL_1_00 * trGammaL_1
+		+ GammaLUL_1_0_0 * GammaULL_1_00
+		+ GammaLUL_1_1_0 * GammaULL_1_01
+		+ GammaLUL_1_2_0 * GammaULL_1_02
+		+ GammaLUL_1_3_0 * GammaULL_1_03
+		- GammaULL_2_00 * trGammaL_2
+		+ GammaLUL_2_0_0 * GammaULL_2_00
+		+ GammaLUL_2_1_0 * GammaULL_2_01
+		+ GammaLUL_2_2_0 * GammaULL_2_02
+		+ GammaLUL_2_3_0 * GammaULL_2_03
+		- GammaULL_3_00 * trGammaL_3
+		+ GammaLUL_3_0_0 * GammaULL_3_00
+		+ GammaLUL_3_1_0 * GammaULL_3_01
+		+ GammaLUL_3_2_0 * GammaULL_3_02
+		+ GammaLUL_3_3_0 * GammaULL_3_03;
+	const Real RicciLL_01 = gUU_01 * (0.5 * d2gLLLL_11_00 + 0.5 * d2gLLLL_00_11 - d2gLLLL_01_01)
+		+ 0.5 * gUU_02 * (d2gLLLL_12_00 + d2gLLLL_00_12 - d2gLLLL_01_02 - d2gLLLL_02_01)
+		+ 0.5 * gUU_03 * (d2gLLLL_13_00 + d2gLLLL_00_13 - d2gLLLL_01_03 - d2gLLLL_03_01)
+		+ 0.5 * gUU_12 * (-d2gLLLL_12_01 - d2gLLLL_01_12 + d2gLLLL_11_02 + d2gLLLL_02_11)
+		+ 0.5 * gUU_13 * (-d2gLLLL_13_01 - d2gLLLL_01_13 + d2gLLLL_11_03 + d2gLLLL_03_11)
+		+ 0.5 * gUU_22 * (d2gLLLL_12_02 + d2gLLLL_02_12 - d2gLLLL_01_22 - d2gLLLL_22_01)
+		+ gUU_23 * (0.5 * d2gLLLL_13_02 + 0.5 * d2gLLLL_02_13 - d2gLLLL_01_23 - d2gLLLL_23_01 + 0.5 * d2gLLLL_12_03 + 0.5 * d2gLLLL_03_12)
+		+ 0.5 * gUU_33 * (d2gLLLL_13_03 + d2gLLLL_03_13 - d2gLLLL_01_33 - d2gLLLL_33_01)
+		- GammaULL_0_01 * trGammaL_0
+		+ GammaLUL_0_0_1 * GammaULL_0_00
+		+ GammaLUL_0_1_1 * GammaULL_0_01
+		+ GammaLUL_0_2_1 * GammaULL_0_02
+		+ GammaLUL_0_3_1 * GammaULL_0_03
+		- GammaULL_1_01 * trGammaL_1
+		+ GammaLUL_1_0_1 * GammaULL_1_00
+		+ GammaLUL_1_1_1 * GammaULL_1_01
+		+ GammaLUL_1_2_1 * GammaULL_1_02
+		+ GammaLUL_1_3_1 * GammaULL_1_03
+		- GammaULL_2_01 * trGammaL_2
+		+ GammaLUL_2_0_1 * GammaULL_2_00
+		+ GammaLUL_2_1_1 * GammaULL_2_01
+		+ GammaLUL_2_2_1 * GammaULL_2_02
+		+ GammaLUL_2_3_1 * GammaULL_2_03
+		- GammaULL_3_01 * trGammaL_3
+		+ GammaLUL_3_0_1 * GammaULL_3_00
+		+ GammaLUL_3_1_1 * GammaULL_3_01
+		+ GammaLUL_3_2_1 * GammaULL_3_02
+		+ GammaLUL_3_3_1 * GammaULL_3_03;
+	const Real RicciLL_02 = 0.5 * gUU_01 * (d2gLLLL_12_00 + d2gLLLL_00_12 - d2gLLLL_02_01 - d2gLLLL_01_02)
+		+ gUU_02 * (0.5 * d2gLLLL_22_00 + 0.5 * d2gLLLL_00_22 - d2gLLLL_02_02)
+		+ 0.5 * gUU_03 * (d2gLLLL_23_00 + d2gLLLL_00_23 - d2gLLLL_02_03 - d2gLLLL_03_02)
+		+ 0.5 * gUU_11 * (d2gLLLL_12_01 + d2gLLLL_01_12 - d2gLLLL_02_11 - d2gLLLL_11_02)
+		+ 0.5 * gUU_12 * (d2gLLLL_22_01 + d2gLLLL_01_22 - d2gLLLL_02_12 - d2gLLLL_12_02)
+		+ gUU_13 * (0.5 * d2gLLLL_23_01 + 0.5 * d2gLLLL_01_23 - d2gLLLL_02_13 - d2gLLLL_13_02 + 0.5 * d2gLLLL_12_03 + 0.5 * d2gLLLL_03_12)
+		+ 0.5 * gUU_23 * (-d2gLLLL_23_02 - d2gLLLL_02_23 + d2gLLLL_22_03 + d2gLLLL_03_22)
+		+ 0.5 * gUU_33 * (d2gLLLL_23_03 + d2gLLLL_03_23 - d2gLLLL_02_33 - d2gLLLL_33_02)
+		- GammaULL_0_02 * trGammaL_0
+		+ GammaLUL_0_0_2 * GammaULL_0_00
+		+ GammaLUL_0_1_2 * GammaULL_0_01
+		+ GammaLUL_0_2_2 * GammaULL_0_02
+		+ GammaLUL_0_3_2 * GammaULL_0_03
+		- GammaULL_1_02 * trGammaL_1
+		+ GammaLUL_1_0_2 * GammaULL_1_00
+		+ GammaLUL_1_1_2 * GammaULL_1_01
+		+ GammaLUL_1_2_2 * GammaULL_1_02
+		+ GammaLUL_1_3_2 * GammaULL_1_03
+		- GammaULL_2_02 * trGammaL_2
+		+ GammaLUL_2_0_2 * GammaULL_2_00
+		+ GammaLUL_2_1_2 * GammaULL_2_01
+		+ GammaLUL_2_2_2 * GammaULL_2_02
+		+ GammaLUL_2_3_2 * GammaULL_2_03
+		- GammaULL_3_02 * trGammaL_3
+		+ GammaLUL_3_0_2 * GammaULL_3_00
+		+ GammaLUL_3_1_2 * GammaULL_3_01
+		+ GammaLUL_3_2_2 * GammaULL_3_02
+		+ GammaLUL_3_3_2 * GammaULL_3_03;
+	const Real RicciLL_03 = 0.5 * gUU_01 * (d2gLLLL_13_00 + d2gLLLL_00_13 - d2gLLLL_03_01 - d2gLLLL_01_03)
+		+ 0.5 * gUU_02 * (d2gLLLL_23_00 + d2gLLLL_00_23 - d2gLLLL_03_02 - d2gLLLL_02_03)
+		+ gUU_03 * (0.5 * d2gLLLL_33_00 + 0.5 * d2gLLLL_00_33 - d2gLLLL_03_03)
+		+ 0.5 * gUU_11 * (d2gLLLL_13_01 + d2gLLLL_01_13 - d2gLLLL_03_11 - d2gLLLL_11_03)
+		+ gUU_12 * (0.5 * d2gLLLL_23_01 + 0.5 * d2gLLLL_01_23 - d2gLLLL_03_12 - d2gLLLL_12_03 + 0.5 * d2gLLLL_13_02 + 0.5 * d2gLLLL_02_13)
+		+ 0.5 * gUU_13 * (d2gLLLL_33_01 + d2gLLLL_01_33 - d2gLLLL_03_13 - d2gLLLL_13_03)
+		+ 0.5 * gUU_22 * (d2gLLLL_23_02 + d2gLLLL_02_23 - d2gLLLL_03_22 - d2gLLLL_22_03)
+		+ 0.5 * gUU_23 * (d2gLLLL_33_02 + d2gLLLL_02_33 - d2gLLLL_03_23 - d2gLLLL_23_03)
+		- GammaULL_0_03 * trGammaL_0
+		+ GammaLUL_0_0_3 * GammaULL_0_00
+		+ GammaLUL_0_1_3 * GammaULL_0_01
+		+ GammaLUL_0_2_3 * GammaULL_0_02
+		+ GammaLUL_0_3_3 * GammaULL_0_03
+		- GammaULL_1_03 * trGammaL_1
+		+ GammaLUL_1_0_3 * GammaULL_1_00
+		+ GammaLUL_1_1_3 * GammaULL_1_01
+		+ GammaLUL_1_2_3 * GammaULL_1_02
+		+ GammaLUL_1_3_3 * GammaULL_1_03
+		- GammaULL_2_03 * trGammaL_2
+		+ GammaLUL_2_0_3 * GammaULL_2_00
+		+ GammaLUL_2_1_3 * GammaULL_2_01
+		+ GammaLUL_2_2_3 * GammaULL_2_02
+		+ GammaLUL_2_3_3 * GammaULL_2_03
+		- GammaULL_3_03 * trGammaL_3
+		+ GammaLUL_3_0_3 * GammaULL_3_00
+		+ GammaLUL_3_1_3 * GammaULL_3_01
+		+ GammaLUL_3_2_3 * GammaULL_3_02
+		+ GammaLUL_3_3_3 * GammaULL_3_03;
+	const Real RicciLL_11 = gUU_00 * (d2gLLLL_01_01 - 0.5 * d2gLLLL_11_00 - 0.5 * d2gLLLL_00_11)
+		+ gUU_02 * (d2gLLLL_12_01 + d2gLLLL_01_12 - d2gLLLL_11_02 - d2gLLLL_02_11)
+		+ gUU_03 * (d2gLLLL_13_01 + d2gLLLL_01_13 - d2gLLLL_11_03 - d2gLLLL_03_11)
+		+ gUU_22 * (d2gLLLL_12_12 - 0.5 * d2gLLLL_11_22 - 0.5 * d2gLLLL_22_11)
+		+ gUU_23 * (d2gLLLL_13_12 + d2gLLLL_12_13 - d2gLLLL_11_23 - d2gLLLL_23_11)
+		+ gUU_33 * (d2gLLLL_13_13 - 0.5 * d2gLLLL_11_33 - 0.5 * d2gLLLL_33_11)
+		- GammaULL_0_11 * trGammaL_0
+		+ GammaLUL_0_0_1 * GammaULL_0_01
+		+ GammaLUL_0_1_1 * GammaULL_0_11
+		+ GammaLUL_0_2_1 * GammaULL_0_12
+		+ GammaLUL_0_3_1 * GammaULL_0_13
+		- GammaULL_1_11 * trGammaL_1
+		+ GammaLUL_1_0_1 * GammaULL_1_01
+		+ GammaLUL_1_1_1 * GammaULL_1_11
+		+ GammaLUL_1_2_1 * GammaULL_1_12
+		+ GammaLUL_1_3_1 * GammaULL_1_13
+		- GammaULL_2_11 * trGammaL_2
+		+ GammaLUL_2_0_1 * GammaULL_2_01
+		+ GammaLUL_2_1_1 * GammaULL_2_11
+		+ GammaLUL_2_2_1 * GammaULL_2_12
+		+ GammaLUL_2_3_1 * GammaULL_2_13
+		- GammaULL_3_11 * trGammaL_3
+		+ GammaLUL_3_0_1 * GammaULL_3_01
+		+ GammaLUL_3_1_1 * GammaULL_3_11
+		+ GammaLUL_3_2_1 * GammaULL_3_12
+		+ GammaLUL_3_3_1 * GammaULL_3_13;
+	const Real RicciLL_12 = 0.5 * gUU_00 * (d2gLLLL_02_01 + d2gLLLL_01_02 - d2gLLLL_12_00 - d2gLLLL_00_12)
+		+ 0.5 * gUU_01 * (-d2gLLLL_12_01 - d2gLLLL_01_12 + d2gLLLL_02_11 + d2gLLLL_11_02)
+		+ 0.5 * gUU_02 * (d2gLLLL_22_01 + d2gLLLL_01_22 - d2gLLLL_12_02 - d2gLLLL_02_12)
+		+ gUU_03 * (0.5 * d2gLLLL_23_01 + 0.5 * d2gLLLL_01_23 - d2gLLLL_12_03 - d2gLLLL_03_12 + 0.5 * d2gLLLL_02_13 + 0.5 * d2gLLLL_13_02)
+		+ gUU_12 * (0.5 * d2gLLLL_22_11 + 0.5 * d2gLLLL_11_22 - d2gLLLL_12_12)
+		+ 0.5 * gUU_13 * (d2gLLLL_23_11 + d2gLLLL_11_23 - d2gLLLL_12_13 - d2gLLLL_13_12)
+		+ 0.5 * gUU_23 * (-d2gLLLL_23_12 - d2gLLLL_12_23 + d2gLLLL_22_13 + d2gLLLL_13_22)
+		+ 0.5 * gUU_33 * (d2gLLLL_23_13 + d2gLLLL_13_23 - d2gLLLL_12_33 - d2gLLLL_33_12)
+		- GammaULL_0_12 * trGammaL_0
+		+ GammaLUL_0_0_2 * GammaULL_0_01
+		+ GammaLUL_0_1_2 * GammaULL_0_11
+		+ GammaLUL_0_2_2 * GammaULL_0_12
+		+ GammaLUL_0_3_2 * GammaULL_0_13
+		- GammaULL_1_12 * trGammaL_1
+		+ GammaLUL_1_0_2 * GammaULL_1_01
+		+ GammaLUL_1_1_2 * GammaULL_1_11
+		+ GammaLUL_1_2_2 * GammaULL_1_12
+		+ GammaLUL_1_3_2 * GammaULL_1_13
+		- GammaULL_2_12 * trGammaL_2
+		+ GammaLUL_2_0_2 * GammaULL_2_01
+		+ GammaLUL_2_1_2 * GammaULL_2_11
+		+ GammaLUL_2_2_2 * GammaULL_2_12
+		+ GammaLUL_2_3_2 * GammaULL_2_13
+		- GammaULL_3_12 * trGammaL_3
+		+ GammaLUL_3_0_2 * GammaULL_3_01
+		+ GammaLUL_3_1_2 * GammaULL_3_11
+		+ GammaLUL_3_2_2 * GammaULL_3_12
+		+ GammaLUL_3_3_2 * GammaULL_3_13;
+	const Real RicciLL_13 = 0.5 * gUU_00 * (d2gLLLL_03_01 + d2gLLLL_01_03 - d2gLLLL_13_00 - d2gLLLL_00_13)
+		+ 0.5 * gUU_01 * (-d2gLLLL_13_01 - d2gLLLL_01_13 + d2gLLLL_03_11 + d2gLLLL_11_03)
+		+ gUU_02 * (0.5 * d2gLLLL_23_01 + 0.5 * d2gLLLL_01_23 - d2gLLLL_13_02 - d2gLLLL_02_13 + 0.5 * d2gLLLL_03_12 + 0.5 * d2gLLLL_12_03)
+		+ 0.5 * gUU_03 * (d2gLLLL_33_01 + d2gLLLL_01_33 - d2gLLLL_13_03 - d2gLLLL_03_13)
+		+ 0.5 * gUU_12 * (d2gLLLL_23_11 + d2gLLLL_11_23 - d2gLLLL_13_12 - d2gLLLL_12_13)
+		+ gUU_13 * (0.5 * d2gLLLL_33_11 + 0.5 * d2gLLLL_11_33 - d2gLLLL_13_13)
+		+ 0.5 * gUU_22 * (d2gLLLL_23_12 + d2gLLLL_12_23 - d2gLLLL_13_22 - d2gLLLL_22_13)
+		+ 0.5 * gUU_23 * (d2gLLLL_33_12 + d2gLLLL_12_33 - d2gLLLL_13_23 - d2gLLLL_23_13)
+		- GammaULL_0_13 * trGammaL_0
+		+ GammaLUL_0_0_3 * GammaULL_0_01
+		+ GammaLUL_0_1_3 * GammaULL_0_11
+		+ GammaLUL_0_2_3 * GammaULL_0_12
+		+ GammaLUL_0_3_3 * GammaULL_0_13
+		- GammaULL_1_13 * trGammaL_1
+		+ GammaLUL_1_0_3 * GammaULL_1_01
+		+ GammaLUL_1_1_3 * GammaULL_1_11
+		+ GammaLUL_1_2_3 * GammaULL_1_12
+		+ GammaLUL_1_3_3 * GammaULL_1_13
+		- GammaULL_2_13 * trGammaL_2
+		+ GammaLUL_2_0_3 * GammaULL_2_01
+		+ GammaLUL_2_1_3 * GammaULL_2_11
+		+ GammaLUL_2_2_3 * GammaULL_2_12
+		+ GammaLUL_2_3_3 * GammaULL_2_13
+		- GammaULL_3_13 * trGammaL_3
+		+ GammaLUL_3_0_3 * GammaULL_3_01
+		+ GammaLUL_3_1_3 * GammaULL_3_11
+		+ GammaLUL_3_2_3 * GammaULL_3_12
+		+ GammaLUL_3_3_3 * GammaULL_3_13;
+	const Real RicciLL_22 = gUU_00 * (d2gLLLL_02_02 - 0.5 * d2gLLLL_22_00 - 0.5 * d2gLLLL_00_22)
+		+ gUU_01 * (d2gLLLL_12_02 + d2gLLLL_02_12 - d2gLLLL_22_01 - d2gLLLL_01_22)
+		+ gUU_03 * (d2gLLLL_23_02 + d2gLLLL_02_23 - d2gLLLL_22_03 - d2gLLLL_03_22)
+		+ gUU_11 * (d2gLLLL_12_12 - 0.5 * d2gLLLL_22_11 - 0.5 * d2gLLLL_11_22)
+		+ gUU_13 * (d2gLLLL_23_12 + d2gLLLL_12_23 - d2gLLLL_22_13 - d2gLLLL_13_22)
+		+ gUU_33 * (d2gLLLL_23_23 - 0.5 * d2gLLLL_22_33 - 0.5 * d2gLLLL_33_22)
+		- GammaULL_0_22 * trGammaL_0
+		+ GammaLUL_0_0_2 * GammaULL_0_02
+		+ GammaLUL_0_1_2 * GammaULL_0_12
+		+ GammaLUL_0_2_2 * GammaULL_0_22
+		+ GammaLUL_0_3_2 * GammaULL_0_23
+		- GammaULL_1_22 * trGammaL_1
+		+ GammaLUL_1_0_2 * GammaULL_1_02
+		+ GammaLUL_1_1_2 * GammaULL_1_12
+		+ GammaLUL_1_2_2 * GammaULL_1_22
+		+ GammaLUL_1_3_2 * GammaULL_1_23
+		- GammaULL_2_22 * trGammaL_2
+		+ GammaLUL_2_0_2 * GammaULL_2_02
+		+ GammaLUL_2_1_2 * GammaULL_2_12
+		+ GammaLUL_2_2_2 * GammaULL_2_22
+		+ GammaLUL_2_3_2 * GammaULL_2_23
+		- GammaULL_3_22 * trGammaL_3
+		+ GammaLUL_3_0_2 * GammaULL_3_02
+		+ GammaLUL_3_1_2 * GammaULL_3_12
+		+ GammaLUL_3_2_2 * GammaULL_3_22
+		+ GammaLUL_3_3_2 * GammaULL_3_23;
+	const Real RicciLL_23 = 0.5 * gUU_00 * (d2gLLLL_03_02 + d2gLLLL_02_03 - d2gLLLL_23_00 - d2gLLLL_00_23)
+		+ gUU_01 * (0.5 * d2gLLLL_13_02 + 0.5 * d2gLLLL_02_13 - d2gLLLL_23_01 - d2gLLLL_01_23 + 0.5 * d2gLLLL_03_12 + 0.5 * d2gLLLL_12_03)
+		+ 0.5 * gUU_02 * (-d2gLLLL_23_02 - d2gLLLL_02_23 + d2gLLLL_03_22 + d2gLLLL_22_03)
+		+ 0.5 * gUU_03 * (d2gLLLL_33_02 + d2gLLLL_02_33 - d2gLLLL_23_03 - d2gLLLL_03_23)
+		+ 0.5 * gUU_11 * (d2gLLLL_13_12 + d2gLLLL_12_13 - d2gLLLL_23_11 - d2gLLLL_11_23)
+		+ 0.5 * gUU_12 * (-d2gLLLL_23_12 - d2gLLLL_12_23 + d2gLLLL_13_22 + d2gLLLL_22_13)
+		+ 0.5 * gUU_13 * (d2gLLLL_33_12 + d2gLLLL_12_33 - d2gLLLL_23_13 - d2gLLLL_13_23)
+		+ gUU_23 * (0.5 * d2gLLLL_33_22 + 0.5 * d2gLLLL_22_33 - d2gLLLL_23_23)
+		- GammaULL_0_23 * trGammaL_0
+		+ GammaLUL_0_0_3 * GammaULL_0_02
+		+ GammaLUL_0_1_3 * GammaULL_0_12
+		+ GammaLUL_0_2_3 * GammaULL_0_22
+		+ GammaLUL_0_3_3 * GammaULL_0_23
+		- GammaULL_1_23 * trGammaL_1
+		+ GammaLUL_1_0_3 * GammaULL_1_02
+		+ GammaLUL_1_1_3 * GammaULL_1_12
+		+ GammaLUL_1_2_3 * GammaULL_1_22
+		+ GammaLUL_1_3_3 * GammaULL_1_23
+		- GammaULL_2_23 * trGammaL_2
+		+ GammaLUL_2_0_3 * GammaULL_2_02
+		+ GammaLUL_2_1_3 * GammaULL_2_12
+		+ GammaLUL_2_2_3 * GammaULL_2_22
+		+ GammaLUL_2_3_3 * GammaULL_2_23
+		- GammaULL_3_23 * trGammaL_3
+		+ GammaLUL_3_0_3 * GammaULL_3_02
+		+ GammaLUL_3_1_3 * GammaULL_3_12
+		+ GammaLUL_3_2_3 * GammaULL_3_22
+		+ GammaLUL_3_3_3 * GammaULL_3_23;
+	const Real RicciLL_33 = gUU_00 * (d2gLLLL_03_03 - 0.5 * d2gLLLL_33_00 - 0.5 * d2gLLLL_00_33)
+		+ gUU_01 * (d2gLLLL_13_03 + d2gLLLL_03_13 - d2gLLLL_33_01 - d2gLLLL_01_33)
+		+ gUU_02 * (d2gLLLL_23_03 + d2gLLLL_03_23 - d2gLLLL_33_02 - d2gLLLL_02_33)
+		+ gUU_11 * (d2gLLLL_13_13 - 0.5 * d2gLLLL_33_11 - 0.5 * d2gLLLL_11_33)
+		+ gUU_12 * (d2gLLLL_23_13 + d2gLLLL_13_23 - d2gLLLL_33_12 - d2gLLLL_12_33)
+		+ gUU_22 * (d2gLLLL_23_23 - 0.5 * d2gLLLL_33_22 - 0.5 * d2gLLLL_22_33)
+		- GammaULL_0_33 * trGammaL_0
+		+ GammaLUL_0_0_3 * GammaULL_0_03
+		+ GammaLUL_0_1_3 * GammaULL_0_13
+		+ GammaLUL_0_2_3 * GammaULL_0_23
+		+ GammaLUL_0_3_3 * GammaULL_0_33
+		- GammaULL_1_33 * trGammaL_1
+		+ GammaLUL_1_0_3 * GammaULL_1_03
+		+ GammaLUL_1_1_3 * GammaULL_1_13
+		+ GammaLUL_1_2_3 * GammaULL_1_23
+		+ GammaLUL_1_3_3 * GammaULL_1_33
+		- GammaULL_2_33 * trGammaL_2
+		+ GammaLUL_2_0_3 * GammaULL_2_03
+		+ GammaLUL_2_1_3 * GammaULL_2_13
+		+ GammaLUL_2_2_3 * GammaULL_2_23
+		+ GammaLUL_2_3_3 * GammaULL_2_33
+		- GammaULL_3_33 * trGammaL_3
+		+ GammaLUL_3_0_3 * GammaULL_3_03
+		+ GammaLUL_3_1_3 * GammaULL_3_13
+		+ GammaLUL_3_2_3 * GammaULL_3_23
+		+ GammaLUL_3_3_3 * GammaULL_3_33;
+	const Real Gaussian = RicciLL_00 * gUU_00
+		+ 2 * RicciLL_01 * gUU_01
+		+ 2 * RicciLL_02 * gUU_02
+		+ 2 * RicciLL_03 * gUU_03
+		+ RicciLL_11 * gUU_11
+		+ 2 * RicciLL_12 * gUU_12
+		+ 2 * RicciLL_13 * gUU_13
+		+ RicciLL_22 * gUU_22
+		+ 2 * RicciLL_23 * gUU_23
+		+ RicciLL_33 * gUU_33;
+	EinsteinLL(0,0) = RicciLL_00
+		- 0.5 * Gaussian * gLL_00;
+	EinsteinLL(0,1) = RicciLL_01
+		- 0.5 * Gaussian * gLL_01;
+	EinsteinLL(0,2) = RicciLL_02
+		- 0.5 * Gaussian * gLL_02;
+	EinsteinLL(0,3) = RicciLL_03
+		- 0.5 * Gaussian * gLL_03;
+	EinsteinLL(1,1) = RicciLL_11
+		- 0.5 * Gaussian * gLL_11;
+	EinsteinLL(1,2) = RicciLL_12
+		- 0.5 * Gaussian * gLL_12;
+	EinsteinLL(1,3) = RicciLL_13
+		- 0.5 * Gaussian * gLL_13;
+	EinsteinLL(2,2) = RicciLL_22
+		- 0.5 * Gaussian * gLL_22;
+	EinsteinLL(2,3) = RicciLL_23
+		- 0.5 * Gaussian * gLL_23;
+	EinsteinLL(3,3) = RicciLL_33
+		- 0.5 * Gaussian * gLL_33;
+	return EinsteinLL;
+}
+
+/*
+G_ab for a stationary metric, i.e. g_ab,t = 0 and g_ab,tc = 0
+716 multiplies, 588 adds
+*/
+template<typename Real>
+inline TensorSLOf<Real> calc_EinsteinLL_stationary_generated(
+	const TensorSLOf<Real>& gLL,
+	const TensorSUOf<Real>& gUU,
+	const TensorUSLOf<Real>& GammaULL,
+	const TensorSLLOf<Real>& dgLLL,
+	const TensorSLSLOf<Real>& d2gLLLL
+) {
+	TensorSLOf<Real> EinsteinLL;
+	const Real dgLLL_00_1 = dgLLL(0,0,1);
+	const Real dgLLL_00_2 = dgLLL(0,0,2);
+	const Real dgLLL_00_3 = dgLLL(0,0,3);
+	const Real dgLLL_01_2 = dgLLL(0,1,2);
+	const Real dgLLL_02_1 = dgLLL(0,2,1);
+	const Real dgLLL_01_3 = dgLLL(0,1,3);
+	const Real dgLLL_03_1 = dgLLL(0,3,1);
+	const Real dgLLL_02_3 = dgLLL(0,2,3);
+	const Real dgLLL_03_2 = dgLLL(0,3,2);
+	const Real dgLLL_11_1 = dgLLL(1,1,1);
+	const Real dgLLL_11_2 = dgLLL(1,1,2);
+	const Real dgLLL_11_3 = dgLLL(1,1,3);
+	const Real dgLLL_12_2 = dgLLL(1,2,2);
+	const Real dgLLL_22_1 = dgLLL(2,2,1);
+	const Real dgLLL_12_3 = dgLLL(1,2,3);
+	const Real dgLLL_13_2 = dgLLL(1,3,2);
+	const Real dgLLL_23_1 = dgLLL(2,3,1);
+	const Real dgLLL_13_3 = dgLLL(1,3,3);
+	const Real dgLLL_33_1 = dgLLL(3,3,1);
+	const Real dgLLL_12_1 = dgLLL(1,2,1);
+	const Real dgLLL_22_2 = dgLLL(2,2,2);
+	const Real dgLLL_22_3 = dgLLL(2,2,3);
+	const Real dgLLL_23_3 = dgLLL(2,3,3);
+	const Real dgLLL_33_2 = dgLLL(3,3,2);
+	const Real dgLLL_13_1 = dgLLL(1,3,1);
+	const Real dgLLL_23_2 = dgLLL(2,3,2);
+	const Real dgLLL_33_3 = dgLLL(3,3,3);
+	const Real gUU_01 = gUU(0,1);
+	const Real gUU_02 = gUU(0,2);
+	const Real gUU_03 = gUU(0,3);
+	const Real dgLLL_01_1 = dgLLL(0,1,1);
+	const Real gUU_11 = gUU(1,1);
+	const Real gUU_12 = gUU(1,2);
+	const Real gUU_13 = gUU(1,3);
+	const Real dgLLL_02_2 = dgLLL(0,2,2);
+	const Real gUU_22 = gUU(2,2);
+	const Real gUU_23 = gUU(2,3);
+	const Real dgLLL_03_3 = dgLLL(0,3,3);
+	const Real gUU_33 = gUU(3,3);
+	const Real gUU_00 = gUU(0,0);
+	const Real d2gLLLL_00_11 = d2gLLLL(0,0,1,1);
+	const Real d2gLLLL_00_12 = d2gLLLL(0,0,1,2);
+	const Real d2gLLLL_00_13 = d2gLLLL(0,0,1,3);
+	const Real d2gLLLL_00_22 = d2gLLLL(0,0,2,2);
+	const Real d2gLLLL_00_23 = d2gLLLL(0,0,2,3);
+	const Real d2gLLLL_00_33 = d2gLLLL(0,0,3,3);
+	const Real GammaULL_0_00 = GammaULL(0,0,0);
+	const Real GammaULL_0_01 = GammaULL(0,0,1);
+	const Real GammaULL_0_02 = GammaULL(0,0,2);
+	const Real GammaULL_0_03 = GammaULL(0,0,3);
+	const Real GammaULL_1_00 = GammaULL(1,0,0);
+	const Real GammaULL_1_01 = GammaULL(1,0,1);
+	const Real GammaULL_1_02 = GammaULL(1,0,2);
+	const Real GammaULL_1_03 = GammaULL(1,0,3);
+	const Real GammaULL_2_00 = GammaULL(2,0,0);
+	const Real GammaULL_2_01 = GammaULL(2,0,1);
+	const Real GammaULL_2_02 = GammaULL(2,0,2);
+	const Real GammaULL_2_03 = GammaULL(2,0,3);
+	const Real GammaULL_3_00 = GammaULL(3,0,0);
+	const Real GammaULL_3_01 = GammaULL(3,0,1);
+	const Real GammaULL_3_02 = GammaULL(3,0,2);
+	const Real GammaULL_3_03 = GammaULL(3,0,3);
+	const Real d2gLLLL_01_12 = d2gLLLL(0,1,2,1);
+	const Real d2gLLLL_01_13 = d2gLLLL(0,1,3,1);
+	const Real d2gLLLL_02_11 = d2gLLLL(0,2,1,1);
+	const Real d2gLLLL_02_12 = d2gLLLL(0,2,2,1);
+	const Real d2gLLLL_01_22 = d2gLLLL(0,1,2,2);
+	const Real d2gLLLL_02_13 = d2gLLLL(0,2,3,1);
+	const Real d2gLLLL_01_23 = d2gLLLL(0,1,2,3);
+	const Real d2gLLLL_03_11 = d2gLLLL(0,3,1,1);
+	const Real d2gLLLL_03_12 = d2gLLLL(0,3,2,1);
+	const Real d2gLLLL_03_13 = d2gLLLL(0,3,3,1);
+	const Real d2gLLLL_01_33 = d2gLLLL(0,1,3,3);
+	const Real d2gLLLL_02_23 = d2gLLLL(0,2,3,2);
+	const Real d2gLLLL_03_22 = d2gLLLL(0,3,2,2);
+	const Real d2gLLLL_03_23 = d2gLLLL(0,3,3,2);
+	const Real d2gLLLL_02_33 = d2gLLLL(0,2,3,3);
+	const Real d2gLLLL_12_12 = d2gLLLL(2,1,1,2);
+	const Real d2gLLLL_11_22 = d2gLLLL(1,1,2,2);
+	const Real d2gLLLL_22_11 = d2gLLLL(2,2,1,1);
+	const Real d2gLLLL_13_12 = d2gLLLL(3,1,1,2);
+	const Real d2gLLLL_12_13 = d2gLLLL(1,2,3,1);
+	const Real d2gLLLL_11_23 = d2gLLLL(1,1,2,3);
+	const Real d2gLLLL_23_11 = d2gLLLL(2,3,1,1);
+	const Real d2gLLLL_13_13 = d2gLLLL(3,1,1,3);
+	const Real d2gLLLL_11_33 = d2gLLLL(1,1,3,3);
+	const Real d2gLLLL_33_11 = d2gLLLL(3,3,1,1);
+	const Real GammaULL_0_11 = GammaULL(0,1,1);
+	const Real GammaULL_0_12 = GammaULL(0,1,2);
+	const Real GammaULL_0_13 = GammaULL(0,1,3);
+	const Real GammaULL_1_11 = GammaULL(1,1,1);
+	const Real GammaULL_1_12 = GammaULL(1,1,2);
+	const Real GammaULL_1_13 = GammaULL(1,1,3);
+	const Real GammaULL_2_11 = GammaULL(2,1,1);
+	const Real GammaULL_2_12 = GammaULL(2,1,2);
+	const Real GammaULL_2_13 = GammaULL(2,1,3);
+	const Real GammaULL_3_11 = GammaULL(3,1,1);
+	const Real GammaULL_3_12 = GammaULL(3,1,2);
+	const Real GammaULL_3_13 = GammaULL(3,1,3);
+	const Real d2gLLLL_23_12 = d2gLLLL(3,2,1,2);
+	const Real d2gLLLL_12_23 = d2gLLLL(1,2,3,2);
+	const Real d2gLLLL_22_13 = d2gLLLL(2,2,1,3);
+	const Real d2gLLLL_13_22 = d2gLLLL(1,3,2,2);
+	const Real d2gLLLL_23_13 = d2gLLLL(3,2,1,3);
+	const Real d2gLLLL_13_23 = d2gLLLL(1,3,3,2);
+	const Real d2gLLLL_12_33 = d2gLLLL(1,2,3,3);
+	const Real d2gLLLL_33_12 = d2gLLLL(3,3,1,2);
+	const Real d2gLLLL_23_23 = d2gLLLL(3,2,2,3);
+	const Real d2gLLLL_22_33 = d2gLLLL(2,2,3,3);
+	const Real d2gLLLL_33_22 = d2gLLLL(3,3,2,2);
+	const Real GammaULL_0_22 = GammaULL(0,2,2);
+	const Real GammaULL_0_23 = GammaULL(0,2,3);
+	const Real GammaULL_1_22 = GammaULL(1,2,2);
+	const Real GammaULL_1_23 = GammaULL(1,2,3);
+	const Real GammaULL_2_22 = GammaULL(2,2,2);
+	const Real GammaULL_2_23 = GammaULL(2,2,3);
+	const Real GammaULL_3_22 = GammaULL(3,2,2);
+	const Real GammaULL_3_23 = GammaULL(3,2,3);
+	const Real GammaULL_0_33 = GammaULL(0,3,3);
+	const Real GammaULL_1_33 = GammaULL(1,3,3);
+	const Real GammaULL_2_33 = GammaULL(2,3,3);
+	const Real GammaULL_3_33 = GammaULL(3,3,3);
+	const Real gLL_00 = gLL(0,0);
+	const Real gLL_01 = gLL(0,1);
+	const Real gLL_02 = gLL(0,2);
+	const Real gLL_03 = gLL(0,3);
+	const Real gLL_11 = gLL(1,1);
+	const Real gLL_12 = gLL(1,2);
+	const Real gLL_13 = gLL(1,3);
+	const Real gLL_22 = gLL(2,2);
+	const Real gLL_23 = gLL(2,3);
+	const Real gLL_33 = gLL(3,3);
+
+	const Real GammaLLL_0_01 = 0.5 * dgLLL_00_1;
+	const Real GammaLLL_0_02 = 0.5 * dgLLL_00_2;
+	const Real GammaLLL_0_03 = 0.5 * dgLLL_00_3;
+	const Real GammaLLL_0_12 = 0.5 * dgLLL_01_2
+		+ 0.5 * dgLLL_02_1;
+	const Real GammaLLL_0_13 = 0.5 * dgLLL_01_3
+		+ 0.5 * dgLLL_03_1;
+	const Real GammaLLL_0_23 = 0.5 * dgLLL_02_3
+		+ 0.5 * dgLLL_03_2;
+	const Real GammaLLL_1_00 = -0.5 * dgLLL_00_1;
+	const Real GammaLLL_1_02 = 0.5 * dgLLL_01_2
+		- 0.5 * dgLLL_02_1;
+	const Real GammaLLL_1_03 = 0.5 * dgLLL_01_3
+		- 0.5 * dgLLL_03_1;
+	const Real GammaLLL_1_11 = 0.5 * dgLLL_11_1;
+	const Real GammaLLL_1_12 = 0.5 * dgLLL_11_2;
+	const Real GammaLLL_1_13 = 0.5 * dgLLL_11_3;
+	const Real GammaLLL_1_22 = dgLLL_12_2
+		- 0.5 * dgLLL_22_1;
+	const Real GammaLLL_1_23 = 0.5 * dgLLL_12_3
+		+ 0.5 * dgLLL_13_2
+		- 0.5 * dgLLL_23_1;
+	const Real GammaLLL_1_33 = dgLLL_13_3
+		- 0.5 * dgLLL_33_1;
+	const Real GammaLLL_2_00 = -0.5 * dgLLL_00_2;
+	const Real GammaLLL_2_01 = 0.5 * dgLLL_02_1
+		- 0.5 * dgLLL_01_2;
+	const Real GammaLLL_2_03 = 0.5 * dgLLL_02_3
+		- 0.5 * dgLLL_03_2;
+	const Real GammaLLL_2_11 = dgLLL_12_1
+		- 0.5 * dgLLL_11_2;
+	const Real GammaLLL_2_12 = 0.5 * dgLLL_22_1;
+	const Real GammaLLL_2_13 = 0.5 * dgLLL_12_3
+		+ 0.5 * dgLLL_23_1
+		- 0.5 * dgLLL_13_2;
+	const Real GammaLLL_2_22 = 0.5 * dgLLL_22_2;
+	const Real GammaLLL_2_23 = 0.5 * dgLLL_22_3;
+	const Real GammaLLL_2_33 = dgLLL_23_3
+		- 0.5 * dgLLL_33_2;
+	const Real GammaLLL_3_00 = -0.5 * dgLLL_00_3;
+	const Real GammaLLL_3_01 = 0.5 * dgLLL_03_1
+		- 0.5 * dgLLL_01_3;
+	const Real GammaLLL_3_02 = 0.5 * dgLLL_03_2
+		- 0.5 * dgLLL_02_3;
+	const Real GammaLLL_3_11 = dgLLL_13_1
+		- 0.5 * dgLLL_11_3;
+	const Real GammaLLL_3_12 = 0.5 * dgLLL_13_2
+		+ 0.5 * dgLLL_23_1
+		- 0.5 * dgLLL_12_3;
+	const Real GammaLLL_3_13 = 0.5 * dgLLL_33_1;
+	const Real GammaLLL_3_22 = dgLLL_23_2
+		- 0.5 * dgLLL_22_3;
+	const Real GammaLLL_3_23 = 0.5 * dgLLL_33_2;
+	const Real GammaLLL_3_33 = 0.5 * dgLLL_33_3;
+	const Real trGammaL_0 = 2 * GammaLLL_0_01 * gUU_01
+		+ 2 * GammaLLL_0_02 * gUU_02
+		+ 2 * GammaLLL_0_03 * gUU_03
+		+ dgLLL_01_1 * gUU_11
+		+ 2 * GammaLLL_0_12 * gUU_12
+		+ 2 * GammaLLL_0_13 * gUU_13
+		+ dgLLL_02_2 * gUU_22
+		+ 2 * GammaLLL_0_23 * gUU_23
+		+ dgLLL_03_3 * gUU_33;
+	const Real trGammaL_1 = GammaLLL_1_00 * gUU_00
+		+ 2 * GammaLLL_1_02 * gUU_02
+		+ 2 * GammaLLL_1_03 * gUU_03
+		+ GammaLLL_1_11 * gUU_11
+		+ 2 * GammaLLL_1_12 * gUU_12
+		+ 2 * GammaLLL_1_13 * gUU_13
+		+ GammaLLL_1_22 * gUU_22
+		+ 2 * GammaLLL_1_23 * gUU_23
+		+ GammaLLL_1_33 * gUU_33;
+	const Real trGammaL_2 = GammaLLL_2_00 * gUU_00
+		+ 2 * GammaLLL_2_01 * gUU_01
+		+ 2 * GammaLLL_2_03 * gUU_03
+		+ GammaLLL_2_11 * gUU_11
+		+ 2 * GammaLLL_2_12 * gUU_12
+		+ 2 * GammaLLL_2_13 * gUU_13
+		+ GammaLLL_2_22 * gUU_22
+		+ 2 * GammaLLL_2_23 * gUU_23
+		+ GammaLLL_2_33 * gUU_33;
+	const Real trGammaL_3 = GammaLLL_3_00 * gUU_00
+		+ 2 * GammaLLL_3_01 * gUU_01
+		+ 2 * GammaLLL_3_02 * gUU_02
+		+ GammaLLL_3_11 * gUU_11
+		+ 2 * GammaLLL_3_12 * gUU_12
+		+ 2 * GammaLLL_3_13 * gUU_13
+		+ GammaLLL_3_22 * gUU_22
+		+ 2 * GammaLLL_3_23 * gUU_23
+		+ GammaLLL_3_33 * gUU_33;
+	const Real GammaLUL_0_0_0 = GammaLLL_0_01 * gUU_01
+		+ GammaLLL_0_02 * gUU_02
+		+ GammaLLL_0_03 * gUU_03;
+	const Real GammaLUL_0_0_1 = GammaLLL_0_01 * gUU_00
+		+ dgLLL_01_1 * gUU_01
+		+ GammaLLL_0_12 * gUU_02
+		+ GammaLLL_0_13 * gUU_03;
+	const Real GammaLUL_0_0_2 = GammaLLL_0_02 * gUU_00
+		+ GammaLLL_0_12 * gUU_01
+		+ dgLLL_02_2 * gUU_02
+		+ GammaLLL_0_23 * gUU_03;
+	const Real GammaLUL_0_0_3 = GammaLLL_0_03 * gUU_00
+		+ GammaLLL_0_13 * gUU_01
+		+ GammaLLL_0_23 * gUU_02
+		+ dgLLL_03_3 * gUU_03;
+	const Real GammaLUL_0_1_0 = GammaLLL_0_01 * gUU_11
+		+ GammaLLL_0_02 * gUU_12
+		+ GammaLLL_0_03 * gUU_13;
+	const Real GammaLUL_0_1_1 = GammaLLL_0_01 * gUU_01
+		+ dgLLL_01_1 * gUU_11
+		+ GammaLLL_0_12 * gUU_12
+		+ GammaLLL_0_13 * gUU_13;
+	const Real GammaLUL_0_1_2 = GammaLLL_0_02 * gUU_01
+		+ GammaLLL_0_12 * gUU_11
+		+ dgLLL_02_2 * gUU_12
+		+ GammaLLL_0_23 * gUU_13;
+	const Real GammaLUL_0_1_3 = GammaLLL_0_03 * gUU_01
+		+ GammaLLL_0_13 * gUU_11
+		+ GammaLLL_0_23 * gUU_12
+		+ dgLLL_03_3 * gUU_13;
+	const Real GammaLUL_0_2_0 = GammaLLL_0_01 * gUU_12
+		+ GammaLLL_0_02 * gUU_22
+		+ GammaLLL_0_03 * gUU_23;
+	const Real GammaLUL_0_2_1 = GammaLLL_0_01 * gUU_02
+		+ dgLLL_01_1 * gUU_12
+		+ GammaLLL_0_12 * gUU_22
+		+ GammaLLL_0_13 * gUU_23;
+	const Real GammaLUL_0_2_2 = GammaLLL_0_02 * gUU_02
+		+ GammaLLL_0_12 * gUU_12
+		+ dgLLL_02_2 * gUU_22
+		+ GammaLLL_0_23 * gUU_23;
+	const Real GammaLUL_0_2_3 = GammaLLL_0_03 * gUU_02
+		+ GammaLLL_0_13 * gUU_12
+		+ GammaLLL_0_23 * gUU_22
+		+ dgLLL_03_3 * gUU_23;
+	const Real GammaLUL_0_3_0 = GammaLLL_0_01 * gUU_13
+		+ GammaLLL_0_02 * gUU_23
+		+ GammaLLL_0_03 * gUU_33;
+	const Real GammaLUL_0_3_1 = GammaLLL_0_01 * gUU_03
+		+ dgLLL_01_1 * gUU_13
+		+ GammaLLL_0_12 * gUU_23
+		+ GammaLLL_0_13 * gUU_33;
+	const Real GammaLUL_0_3_2 = GammaLLL_0_02 * gUU_03
+		+ GammaLLL_0_12 * gUU_13
+		+ dgLLL_02_2 * gUU_23
+		+ GammaLLL_0_23 * gUU_33;
+	const Real GammaLUL_0_3_3 = GammaLLL_0_03 * gUU_03
+		+ GammaLLL_0_13 * gUU_13
+		+ GammaLLL_0_23 * gUU_23
+		+ dgLLL_03_3 * gUU_33;
+	const Real GammaLUL_1_0_0 = GammaLLL_1_00 * gUU_00
+		+ GammaLLL_1_02 * gUU_02
+		+ GammaLLL_1_03 * gUU_03;
+	const Real GammaLUL_1_0_1 = GammaLLL_1_11 * gUU_01
+		+ GammaLLL_1_12 * gUU_02
+		+ GammaLLL_1_13 * gUU_03;
+	const Real GammaLUL_1_0_2 = GammaLLL_1_02 * gUU_00
+		+ GammaLLL_1_12 * gUU_01
+		+ GammaLLL_1_22 * gUU_02
+		+ GammaLLL_1_23 * gUU_03;
+	const Real GammaLUL_1_0_3 = GammaLLL_1_03 * gUU_00
+		+ GammaLLL_1_13 * gUU_01
+		+ GammaLLL_1_23 * gUU_02
+		+ GammaLLL_1_33 * gUU_03;
+	const Real GammaLUL_1_1_0 = GammaLLL_1_00 * gUU_01
+		+ GammaLLL_1_02 * gUU_12
+		+ GammaLLL_1_03 * gUU_13;
+	const Real GammaLUL_1_1_1 = GammaLLL_1_11 * gUU_11
+		+ GammaLLL_1_12 * gUU_12
+		+ GammaLLL_1_13 * gUU_13;
+	const Real GammaLUL_1_1_2 = GammaLLL_1_02 * gUU_01
+		+ GammaLLL_1_12 * gUU_11
+		+ GammaLLL_1_22 * gUU_12
+		+ GammaLLL_1_23 * gUU_13;
+	const Real GammaLUL_1_1_3 = GammaLLL_1_03 * gUU_01
+		+ GammaLLL_1_13 * gUU_11
+		+ GammaLLL_1_23 * gUU_12
+		+ GammaLLL_1_33 * gUU_13;
+	const Real GammaLUL_1_2_0 = GammaLLL_1_00 * gUU_02
+		+ GammaLLL_1_02 * gUU_22
+		+ GammaLLL_1_03 * gUU_23;
+	const Real GammaLUL_1_2_1 = GammaLLL_1_11 * gUU_12
+		+ GammaLLL_1_12 * gUU_22
+		+ GammaLLL_1_13 * gUU_23;
+	const Real GammaLUL_1_2_2 = GammaLLL_1_02 * gUU_02
+		+ GammaLLL_1_12 * gUU_12
+		+ GammaLLL_1_22 * gUU_22
+		+ GammaLLL_1_23 * gUU_23;
+	const Real GammaLUL_1_2_3 = GammaLLL_1_03 * gUU_02
+		+ GammaLLL_1_13 * gUU_12
+		+ GammaLLL_1_23 * gUU_22
+		+ GammaLLL_1_33 * gUU_23;
+	const Real GammaLUL_1_3_0 = GammaLLL_1_00 * gUU_03
+		+ GammaLLL_1_02 * gUU_23
+		+ GammaLLL_1_03 * gUU_33;
+	const Real GammaLUL_1_3_1 = GammaLLL_1_11 * gUU_13
+		+ GammaLLL_1_12 * gUU_23
+		+ GammaLLL_1_13 * gUU_33;
+	const Real GammaLUL_1_3_2 = GammaLLL_1_02 * gUU_03
+		+ GammaLLL_1_12 * gUU_13
+		+ GammaLLL_1_22 * gUU_23
+		+ GammaLLL_1_23 * gUU_33;
+	const Real GammaLUL_1_3_3 = GammaLLL_1_03 * gUU_03
+		+ GammaLLL_1_13 * gUU_13
+		+ GammaLLL_1_23 * gUU_23
+		+ GammaLLL_1_33 * gUU_33;
+	const Real GammaLUL_2_0_0 = GammaLLL_2_00 * gUU_00
+		+ GammaLLL_2_01 * gUU_01
+		+ GammaLLL_2_03 * gUU_03;
+	const Real GammaLUL_2_0_1 = GammaLLL_2_01 * gUU_00
+		+ GammaLLL_2_11 * gUU_01
+		+ GammaLLL_2_12 * gUU_02
+		+ GammaLLL_2_13 * gUU_03;
+	const Real GammaLUL_2_0_2 = GammaLLL_2_12 * gUU_01
+		+ GammaLLL_2_22 * gUU_02
+		+ GammaLLL_2_23 * gUU_03;
+	const Real GammaLUL_2_0_3 = GammaLLL_2_03 * gUU_00
+		+ GammaLLL_2_13 * gUU_01
+		+ GammaLLL_2_23 * gUU_02
+		+ GammaLLL_2_33 * gUU_03;
+	const Real GammaLUL_2_1_0 = GammaLLL_2_00 * gUU_01
+		+ GammaLLL_2_01 * gUU_11
+		+ GammaLLL_2_03 * gUU_13;
+	const Real GammaLUL_2_1_1 = GammaLLL_2_01 * gUU_01
+		+ GammaLLL_2_11 * gUU_11
+		+ GammaLLL_2_12 * gUU_12
+		+ GammaLLL_2_13 * gUU_13;
+	const Real GammaLUL_2_1_2 = GammaLLL_2_12 * gUU_11
+		+ GammaLLL_2_22 * gUU_12
+		+ GammaLLL_2_23 * gUU_13;
+	const Real GammaLUL_2_1_3 = GammaLLL_2_03 * gUU_01
+		+ GammaLLL_2_13 * gUU_11
+		+ GammaLLL_2_23 * gUU_12
+		+ GammaLLL_2_33 * gUU_13;
+	const Real GammaLUL_2_2_0 = GammaLLL_2_00 * gUU_02
+		+ GammaLLL_2_01 * gUU_12
+		+ GammaLLL_2_03 * gUU_23;
+	const Real GammaLUL_2_2_1 = GammaLLL_2_01 * gUU_02
+		+ GammaLLL_2_11 * gUU_12
+		+ GammaLLL_2_12 * gUU_22
+		+ GammaLLL_2_13 * gUU_23;
+	const Real GammaLUL_2_2_2 = GammaLLL_2_12 * gUU_12
+		+ GammaLLL_2_22 * gUU_22
+		+ GammaLLL_2_23 * gUU_23;
+	const Real GammaLUL_2_2_3 = GammaLLL_2_03 * gUU_02
+		+ GammaLLL_2_13 * gUU_12
+		+ GammaLLL_2_23 * gUU_22
+		+ GammaLLL_2_33 * gUU_23;
+	const Real GammaLUL_2_3_0 = GammaLLL_2_00 * gUU_03
+		+ GammaLLL_2_01 * gUU_13
+		+ GammaLLL_2_03 * gUU_33;
+	const Real GammaLUL_2_3_1 = GammaLLL_2_01 * gUU_03
+		+ GammaLLL_2_11 * gUU_13
+		+ GammaLLL_2_12 * gUU_23
+		+ GammaLLL_2_13 * gUU_33;
+	const Real GammaLUL_2_3_2 = GammaLLL_2_12 * gUU_13
+		+ GammaLLL_2_22 * gUU_23
+		+ GammaLLL_2_23 * gUU_33;
+	const Real GammaLUL_2_3_3 = GammaLLL_2_03 * gUU_03
+		+ GammaLLL_2_13 * gUU_13
+		+ GammaLLL_2_23 * gUU_23
+		+ GammaLLL_2_33 * gUU_33;
+	const Real GammaLUL_3_0_0 = GammaLLL_3_00 * gUU_00
+		+ GammaLLL_3_01 * gUU_01
+		+ GammaLLL_3_02 * gUU_02;
+	const Real GammaLUL_3_0_1 = GammaLLL_3_01 * gUU_00
+		+ GammaLLL_3_11 * gUU_01
+		+ GammaLLL_3_12 * gUU_02
+		+ GammaLLL_3_13 * gUU_03;
+	const Real GammaLUL_3_0_2 = GammaLLL_3_02 * gUU_00
+		+ GammaLLL_3_12 * gUU_01
+		+ GammaLLL_3_22 * gUU_02
+		+ GammaLLL_3_23 * gUU_03;
+	const Real GammaLUL_3_0_3 = GammaLLL_3_13 * gUU_01
+		+ GammaLLL_3_23 * gUU_02
+		+ GammaLLL_3_33 * gUU_03;
+	const Real GammaLUL_3_1_0 = GammaLLL_3_00 * gUU_01
+		+ GammaLLL_3_01 * gUU_11
+		+ GammaLLL_3_02 * gUU_12;
+	const Real GammaLUL_3_1_1 = GammaLLL_3_01 * gUU_01
+		+ GammaLLL_3_11 * gUU_11
+		+ GammaLLL_3_12 * gUU_12
+		+ GammaLLL_3_13 * gUU_13;
+	const Real GammaLUL_3_1_2 = GammaLLL_3_02 * gUU_01
+		+ GammaLLL_3_12 * gUU_11
+		+ GammaLLL_3_22 * gUU_12
+		+ GammaLLL_3_23 * gUU_13;
+	const Real GammaLUL_3_1_3 = GammaLLL_3_13 * gUU_11
+		+ GammaLLL_3_23 * gUU_12
+		+ GammaLLL_3_33 * gUU_13;
+	const Real GammaLUL_3_2_0 = GammaLLL_3_00 * gUU_02
+		+ GammaLLL_3_01 * gUU_12
+		+ GammaLLL_3_02 * gUU_22;
+	const Real GammaLUL_3_2_1 = GammaLLL_3_01 * gUU_02
+		+ GammaLLL_3_11 * gUU_12
+		+ GammaLLL_3_12 * gUU_22
+		+ GammaLLL_3_13 * gUU_23;
+	const Real GammaLUL_3_2_2 = GammaLLL_3_02 * gUU_02
+		+ GammaLLL_3_12 * gUU_12
+		+ GammaLLL_3_22 * gUU_22
+		+ GammaLLL_3_23 * gUU_23;
+	const Real GammaLUL_3_2_3 = GammaLLL_3_13 * gUU_12
+		+ GammaLLL_3_23 * gUU_22
+		+ GammaLLL_3_33 * gUU_23;
+	const Real GammaLUL_3_3_0 = GammaLLL_3_00 * gUU_03
+		+ GammaLLL_3_01 * gUU_13
+		+ GammaLLL_3_02 * gUU_23;
+	const Real GammaLUL_3_3_1 = GammaLLL_3_01 * gUU_03
+		+ GammaLLL_3_11 * gUU_13
+		+ GammaLLL_3_12 * gUU_23
+		+ GammaLLL_3_13 * gUU_33;
+	const Real GammaLUL_3_3_2 = GammaLLL_3_02 * gUU_03
+		+ GammaLLL_3_12 * gUU_13
+		+ GammaLLL_3_22 * gUU_23
+		+ GammaLLL_3_23 * gUU_33;
+	const Real GammaLUL_3_3_3 = GammaLLL_3_13 * gUU_13
+		+ GammaLLL_3_23 * gUU_23
+		+ GammaLLL_3_33 * gUU_33;
+	const Real RicciLL_00 = -0.5 * d2gLLLL_00_11 * gUU_11
+		- d2gLLLL_00_12 * gUU_12
+		- d2gLLLL_00_13 * gUU_13
+		- 0.5 * d2gLLLL_00_22 * gUU_22
+		- d2gLLLL_00_23 * gUU_23
+		- 0.5 * d2gLLLL_00_33 * gUU_33
+		- GammaULL_0_00 * trGammaL_0
+		+ GammaLUL_0_0_0 * GammaULL_0_00
+		+ GammaLUL_0_1_0 * GammaULL_0_01
+		+ GammaLUL_0_2_0 * GammaULL_0_02
+		+ GammaLUL_0_3_0 * GammaULL_0_03
+		- GammaULL_1_00 * trGammaL_1
+		+ GammaLUL_1_0_0 * GammaULL_1_00
+		+ GammaLUL_1_1_0 * GammaULL_1_01
+		+ GammaLUL_1_2_0 * GammaULL_1_02
+		+ GammaLUL_1_3_0 * GammaULL_1_03
+		- GammaULL_2_00 * trGammaL_2
+		+ GammaLUL_2_0_0 * GammaULL_2_00
+		+ GammaLUL_2_1_0 * GammaULL_2_01
+		+ GammaLUL_2_2_0 * GammaULL_2_02
+		+ GammaLUL_2_3_0 * GammaULL_2_03
+		- GammaULL_3_00 * trGammaL_3
+		+ GammaLUL_3_0_0 * GammaULL_3_00
+		+ GammaLUL_3_1_0 * GammaULL_3_01
+		+ GammaLUL_3_2_0 * GammaULL_3_02
+		+ GammaLUL_3_3_0 * GammaULL_3_03;
+	const Real RicciLL_01 = 0.5 * d2gLLLL_00_11 * gUU_01
+		+ 0.5 * d2gLLLL_00_12 * gUU_02
+		+ 0.5 * d2gLLLL_00_13 * gUU_03
+		+ 0.5 * gUU_12 * (-d2gLLLL_01_12 + d2gLLLL_02_11)
+		+ 0.5 * gUU_13 * (-d2gLLLL_01_13 + d2gLLLL_03_11)
+		+ 0.5 * gUU_22 * (d2gLLLL_02_12 - d2gLLLL_01_22)
+		+ gUU_23 * (0.5 * d2gLLLL_02_13 - d2gLLLL_01_23 + 0.5 * d2gLLLL_03_12)
+		+ 0.5 * gUU_33 * (d2gLLLL_03_13 - d2gLLLL_01_33)
+		- GammaULL_0_01 * trGammaL_0
+		+ GammaLUL_0_0_1 * GammaULL_0_00
+		+ GammaLUL_0_1_1 * GammaULL_0_01
+		+ GammaLUL_0_2_1 * GammaULL_0_02
+		+ GammaLUL_0_3_1 * GammaULL_0_03
+		- GammaULL_1_01 * trGammaL_1
+		+ GammaLUL_1_0_1 * GammaULL_1_00
+		+ GammaLUL_1_1_1 * GammaULL_1_01
+		+ GammaLUL_1_2_1 * GammaULL_1_02
+		+ GammaLUL_1_3_1 * GammaULL_1_03
+		- GammaULL_2_01 * trGammaL_2
+		+ GammaLUL_2_0_1 * GammaULL_2_00
+		+ GammaLUL_2_1_1 * GammaULL_2_01
+		+ GammaLUL_2_2_1 * GammaULL_2_02
+		+ GammaLUL_2_3_1 * GammaULL_2_03
+		- GammaULL_3_01 * trGammaL_3
+		+ GammaLUL_3_0_1 * GammaULL_3_00
+		+ GammaLUL_3_1_1 * GammaULL_3_01
+		+ GammaLUL_3_2_1 * GammaULL_3_02
+		+ GammaLUL_3_3_1 * GammaULL_3_03;
+	const Real RicciLL_02 = 0.5 * d2gLLLL_00_12 * gUU_01
+		+ 0.5 * d2gLLLL_00_22 * gUU_02
+		+ 0.5 * d2gLLLL_00_23 * gUU_03
+		+ 0.5 * gUU_11 * (d2gLLLL_01_12 - d2gLLLL_02_11)
+		+ 0.5 * gUU_12 * (d2gLLLL_01_22 - d2gLLLL_02_12)
+		+ gUU_13 * (0.5 * d2gLLLL_01_23 - d2gLLLL_02_13 + 0.5 * d2gLLLL_03_12)
+		+ 0.5 * gUU_23 * (-d2gLLLL_02_23 + d2gLLLL_03_22)
+		+ 0.5 * gUU_33 * (d2gLLLL_03_23 - d2gLLLL_02_33)
+		- GammaULL_0_02 * trGammaL_0
+		+ GammaLUL_0_0_2 * GammaULL_0_00
+		+ GammaLUL_0_1_2 * GammaULL_0_01
+		+ GammaLUL_0_2_2 * GammaULL_0_02
+		+ GammaLUL_0_3_2 * GammaULL_0_03
+		- GammaULL_1_02 * trGammaL_1
+		+ GammaLUL_1_0_2 * GammaULL_1_00
+		+ GammaLUL_1_1_2 * GammaULL_1_01
+		+ GammaLUL_1_2_2 * GammaULL_1_02
+		+ GammaLUL_1_3_2 * GammaULL_1_03
+		- GammaULL_2_02 * trGammaL_2
+		+ GammaLUL_2_0_2 * GammaULL_2_00
+		+ GammaLUL_2_1_2 * GammaULL_2_01
+		+ GammaLUL_2_2_2 * GammaULL_2_02
+		+ GammaLUL_2_3_2 * GammaULL_2_03
+		- GammaULL_3_02 * trGammaL_3
+		+ GammaLUL_3_0_2 * GammaULL_3_00
+		+ GammaLUL_3_1_2 * GammaULL_3_01
+		+ GammaLUL_3_2_2 * GammaULL_3_02
+		+ GammaLUL_3_3_2 * GammaULL_3_03;
+	const Real RicciLL_03 = 0.5 * d2gLLLL_00_13 * gUU_01
+		+ 0.5 * d2gLLLL_00_23 * gUU_02
+		+ 0.5 * d2gLLLL_00_33 * gUU_03
+		+ 0.5 * gUU_11 * (d2gLLLL_01_13 - d2gLLLL_03_11)
+		+ gUU_12 * (0.5 * d2gLLLL_01_23 - d2gLLLL_03_12 + 0.5 * d2gLLLL_02_13)
+		+ 0.5 * gUU_13 * (d2gLLLL_01_33 - d2gLLLL_03_13)
+		+ 0.5 * gUU_22 * (d2gLLLL_02_23 - d2gLLLL_03_22)
+		+ 0.5 * gUU_23 * (d2gLLLL_02_33 - d2gLLLL_03_23)
+		- GammaULL_0_03 * trGammaL_0
+		+ GammaLUL_0_0_3 * GammaULL_0_00
+		+ GammaLUL_0_1_3 * GammaULL_0_01
+		+ GammaLUL_0_2_3 * GammaULL_0_02
+		+ GammaLUL_0_3_3 * GammaULL_0_03
+		- GammaULL_1_03 * trGammaL_1
+		+ GammaLUL_1_0_3 * GammaULL_1_00
+		+ GammaLUL_1_1_3 * GammaULL_1_01
+		+ GammaLUL_1_2_3 * GammaULL_1_02
+		+ GammaLUL_1_3_3 * GammaULL_1_03
+		- GammaULL_2_03 * trGammaL_2
+		+ GammaLUL_2_0_3 * GammaULL_2_00
+		+ GammaLUL_2_1_3 * GammaULL_2_01
+		+ GammaLUL_2_2_3 * GammaULL_2_02
+		+ GammaLUL_2_3_3 * GammaULL_2_03
+		- GammaULL_3_03 * trGammaL_3
+		+ GammaLUL_3_0_3 * GammaULL_3_00
+		+ GammaLUL_3_1_3 * GammaULL_3_01
+		+ GammaLUL_3_2_3 * GammaULL_3_02
+		+ GammaLUL_3_3_3 * GammaULL_3_03;
+	const Real RicciLL_11 = -0.5 * d2gLLLL_00_11 * gUU_00
+		+ gUU_02 * (d2gLLLL_01_12 - d2gLLLL_02_11)
+		+ gUU_03 * (d2gLLLL_01_13 - d2gLLLL_03_11)
+		+ gUU_22 * (d2gLLLL_12_12 - 0.5 * d2gLLLL_11_22 - 0.5 * d2gLLLL_22_11)
+		+ gUU_23 * (d2gLLLL_13_12 + d2gLLLL_12_13 - d2gLLLL_11_23 - d2gLLLL_23_11)
+		+ gUU_33 * (d2gLLLL_13_13 - 0.5 * d2gLLLL_11_33 - 0.5 * d2gLLLL_33_11)
+		- GammaULL_0_11 * trGammaL_0
+		+ GammaLUL_0_0_1 * GammaULL_0_01
+		+ GammaLUL_0_1_1 * GammaULL_0_11
+		+ GammaLUL_0_2_1 * GammaULL_0_12
+		+ GammaLUL_0_3_1 * GammaULL_0_13
+		- GammaULL_1_11 * trGammaL_1
+		+ GammaLUL_1_0_1 * GammaULL_1_01
+		+ GammaLUL_1_1_1 * GammaULL_1_11
+		+ GammaLUL_1_2_1 * GammaULL_1_12
+		+ GammaLUL_1_3_1 * GammaULL_1_13
+		- GammaULL_2_11 * trGammaL_2
+		+ GammaLUL_2_0_1 * GammaULL_2_01
+		+ GammaLUL_2_1_1 * GammaULL_2_11
+		+ GammaLUL_2_2_1 * GammaULL_2_12
+		+ GammaLUL_2_3_1 * GammaULL_2_13
+		- GammaULL_3_11 * trGammaL_3
+		+ GammaLUL_3_0_1 * GammaULL_3_01
+		+ GammaLUL_3_1_1 * GammaULL_3_11
+		+ GammaLUL_3_2_1 * GammaULL_3_12
+		+ GammaLUL_3_3_1 * GammaULL_3_13;
+	const Real RicciLL_12 = -0.5 * d2gLLLL_00_12 * gUU_00
+		+ 0.5 * gUU_01 * (-d2gLLLL_01_12 + d2gLLLL_02_11)
+		+ 0.5 * gUU_02 * (d2gLLLL_01_22 - d2gLLLL_02_12)
+		+ gUU_03 * (0.5 * d2gLLLL_01_23 - d2gLLLL_03_12 + 0.5 * d2gLLLL_02_13)
+		+ gUU_12 * (0.5 * d2gLLLL_22_11 + 0.5 * d2gLLLL_11_22 - d2gLLLL_12_12)
+		+ 0.5 * gUU_13 * (d2gLLLL_23_11 + d2gLLLL_11_23 - d2gLLLL_12_13 - d2gLLLL_13_12)
+		+ 0.5 * gUU_23 * (-d2gLLLL_23_12 - d2gLLLL_12_23 + d2gLLLL_22_13 + d2gLLLL_13_22)
+		+ 0.5 * gUU_33 * (d2gLLLL_23_13 + d2gLLLL_13_23 - d2gLLLL_12_33 - d2gLLLL_33_12)
+		- GammaULL_0_12 * trGammaL_0
+		+ GammaLUL_0_0_2 * GammaULL_0_01
+		+ GammaLUL_0_1_2 * GammaULL_0_11
+		+ GammaLUL_0_2_2 * GammaULL_0_12
+		+ GammaLUL_0_3_2 * GammaULL_0_13
+		- GammaULL_1_12 * trGammaL_1
+		+ GammaLUL_1_0_2 * GammaULL_1_01
+		+ GammaLUL_1_1_2 * GammaULL_1_11
+		+ GammaLUL_1_2_2 * GammaULL_1_12
+		+ GammaLUL_1_3_2 * GammaULL_1_13
+		- GammaULL_2_12 * trGammaL_2
+		+ GammaLUL_2_0_2 * GammaULL_2_01
+		+ GammaLUL_2_1_2 * GammaULL_2_11
+		+ GammaLUL_2_2_2 * GammaULL_2_12
+		+ GammaLUL_2_3_2 * GammaULL_2_13
+		- GammaULL_3_12 * trGammaL_3
+		+ GammaLUL_3_0_2 * GammaULL_3_01
+		+ GammaLUL_3_1_2 * GammaULL_3_11
+		+ GammaLUL_3_2_2 * GammaULL_3_12
+		+ GammaLUL_3_3_2 * GammaULL_3_13;
+	const Real RicciLL_13 = -0.5 * d2gLLLL_00_13 * gUU_00
+		+ 0.5 * gUU_01 * (-d2gLLLL_01_13 + d2gLLLL_03_11)
+		+ gUU_02 * (0.5 * d2gLLLL_01_23 - d2gLLLL_02_13 + 0.5 * d2gLLLL_03_12)
+		+ 0.5 * gUU_03 * (d2gLLLL_01_33 - d2gLLLL_03_13)
+		+ 0.5 * gUU_12 * (d2gLLLL_23_11 + d2gLLLL_11_23 - d2gLLLL_13_12 - d2gLLLL_12_13)
+		+ gUU_13 * (0.5 * d2gLLLL_33_11 + 0.5 * d2gLLLL_11_33 - d2gLLLL_13_13)
+		+ 0.5 * gUU_22 * (d2gLLLL_23_12 + d2gLLLL_12_23 - d2gLLLL_13_22 - d2gLLLL_22_13)
+		+ 0.5 * gUU_23 * (d2gLLLL_33_12 + d2gLLLL_12_33 - d2gLLLL_13_23 - d2gLLLL_23_13)
+		- GammaULL_0_13 * trGammaL_0
+		+ GammaLUL_0_0_3 * GammaULL_0_01
+		+ GammaLUL_0_1_3 * GammaULL_0_11
+		+ GammaLUL_0_2_3 * GammaULL_0_12
+		+ GammaLUL_0_3_3 * GammaULL_0_13
+		- GammaULL_1_13 * trGammaL_1
+		+ GammaLUL_1_0_3 * GammaULL_1_01
+		+ GammaLUL_1_1_3 * GammaULL_1_11
+		+ GammaLUL_1_2_3 * GammaULL_1_12
+		+ GammaLUL_1_3_3 * GammaULL_1_13
+		- GammaULL_2_13 * trGammaL_2
+		+ GammaLUL_2_0_3 * GammaULL_2_01
+		+ GammaLUL_2_1_3 * GammaULL_2_11
+		+ GammaLUL_2_2_3 * GammaULL_2_12
+		+ GammaLUL_2_3_3 * GammaULL_2_13
+		- GammaULL_3_13 * trGammaL_3
+		+ GammaLUL_3_0_3 * GammaULL_3_01
+		+ GammaLUL_3_1_3 * GammaULL_3_11
+		+ GammaLUL_3_2_3 * GammaULL_3_12
+		+ GammaLUL_3_3_3 * GammaULL_3_13;
+	const Real RicciLL_22 = -0.5 * d2gLLLL_00_22 * gUU_00
+		+ gUU_01 * (d2gLLLL_02_12 - d2gLLLL_01_22)
+		+ gUU_03 * (d2gLLLL_02_23 - d2gLLLL_03_22)
+		+ gUU_11 * (d2gLLLL_12_12 - 0.5 * d2gLLLL_22_11 - 0.5 * d2gLLLL_11_22)
+		+ gUU_13 * (d2gLLLL_23_12 + d2gLLLL_12_23 - d2gLLLL_22_13 - d2gLLLL_13_22)
+		+ gUU_33 * (d2gLLLL_23_23 - 0.5 * d2gLLLL_22_33 - 0.5 * d2gLLLL_33_22)
+		- GammaULL_0_22 * trGammaL_0
+		+ GammaLUL_0_0_2 * GammaULL_0_02
+		+ GammaLUL_0_1_2 * GammaULL_0_12
+		+ GammaLUL_0_2_2 * GammaULL_0_22
+		+ GammaLUL_0_3_2 * GammaULL_0_23
+		- GammaULL_1_22 * trGammaL_1
+		+ GammaLUL_1_0_2 * GammaULL_1_02
+		+ GammaLUL_1_1_2 * GammaULL_1_12
+		+ GammaLUL_1_2_2 * GammaULL_1_22
+		+ GammaLUL_1_3_2 * GammaULL_1_23
+		- GammaULL_2_22 * trGammaL_2
+		+ GammaLUL_2_0_2 * GammaULL_2_02
+		+ GammaLUL_2_1_2 * GammaULL_2_12
+		+ GammaLUL_2_2_2 * GammaULL_2_22
+		+ GammaLUL_2_3_2 * GammaULL_2_23
+		- GammaULL_3_22 * trGammaL_3
+		+ GammaLUL_3_0_2 * GammaULL_3_02
+		+ GammaLUL_3_1_2 * GammaULL_3_12
+		+ GammaLUL_3_2_2 * GammaULL_3_22
+		+ GammaLUL_3_3_2 * GammaULL_3_23;
+	const Real RicciLL_23 = -0.5 * d2gLLLL_00_23 * gUU_00
+		+ gUU_01 * (0.5 * d2gLLLL_02_13 - d2gLLLL_01_23 + 0.5 * d2gLLLL_03_12)
+		+ 0.5 * gUU_02 * (-d2gLLLL_02_23 + d2gLLLL_03_22)
+		+ 0.5 * gUU_03 * (d2gLLLL_02_33 - d2gLLLL_03_23)
+		+ 0.5 * gUU_11 * (d2gLLLL_13_12 + d2gLLLL_12_13 - d2gLLLL_23_11 - d2gLLLL_11_23)
+		+ 0.5 * gUU_12 * (-d2gLLLL_23_12 - d2gLLLL_12_23 + d2gLLLL_13_22 + d2gLLLL_22_13)
+		+ 0.5 * gUU_13 * (d2gLLLL_33_12 + d2gLLLL_12_33 - d2gLLLL_23_13 - d2gLLLL_13_23)
+		+ gUU_23 * (0.5 * d2gLLLL_33_22 + 0.5 * d2gLLLL_22_33 - d2gLLLL_23_23)
+		- GammaULL_0_23 * trGammaL_0
+		+ GammaLUL_0_0_3 * GammaULL_0_02
+		+ GammaLUL_0_1_3 * GammaULL_0_12
+		+ GammaLUL_0_2_3 * GammaULL_0_22
+		+ GammaLUL_0_3_3 * GammaULL_0_23
+		- GammaULL_1_23 * trGammaL_1
+		+ GammaLUL_1_0_3 * GammaULL_1_02
+		+ GammaLUL_1_1_3 * GammaULL_1_12
+		+ GammaLUL_1_2_3 * GammaULL_1_22
+		+ GammaLUL_1_3_3 * GammaULL_1_23
+		- GammaULL_2_23 * trGammaL_2
+		+ GammaLUL_2_0_3 * GammaULL_2_02
+		+ GammaLUL_2_1_3 * GammaULL_2_12
+		+ GammaLUL_2_2_3 * GammaULL_2_22
+		+ GammaLUL_2_3_3 * GammaULL_2_23
+		- GammaULL_3_23 * trGammaL_3
+		+ GammaLUL_3_0_3 * GammaULL_3_02
+		+ GammaLUL_3_1_3 * GammaULL_3_12
+		+ GammaLUL_3_2_3 * GammaULL_3_22
+		+ GammaLUL_3_3_3 * GammaULL_3_23;
+	const Real RicciLL_33 = -0.5 * d2gLLLL_00_33 * gUU_00
+		+ gUU_01 * (d2gLLLL_03_13 - d2gLLLL_01_33)
+		+ gUU_02 * (d2gLLLL_03_23 - d2gLLLL_02_33)
+		+ gUU_11 * (d2gLLLL_13_13 - 0.5 * d2gLLLL_33_11 - 0.5 * d2gLLLL_11_33)
+		+ gUU_12 * (d2gLLLL_23_13 + d2gLLLL_13_23 - d2gLLLL_33_12 - d2gLLLL_12_33)
+		+ gUU_22 * (d2gLLLL_23_23 - 0.5 * d2gLLLL_33_22 - 0.5 * d2gLLLL_22_33)
+		- GammaULL_0_33 * trGammaL_0
+		+ GammaLUL_0_0_3 * GammaULL_0_03
+		+ GammaLUL_0_1_3 * GammaULL_0_13
+		+ GammaLUL_0_2_3 * GammaULL_0_23
+		+ GammaLUL_0_3_3 * GammaULL_0_33
+		- GammaULL_1_33 * trGammaL_1
+		+ GammaLUL_1_0_3 * GammaULL_1_03
+		+ GammaLUL_1_1_3 * GammaULL_1_13
+		+ GammaLUL_1_2_3 * GammaULL_1_23
+		+ GammaLUL_1_3_3 * GammaULL_1_33
+		- GammaULL_2_33 * trGammaL_2
+		+ GammaLUL_2_0_3 * GammaULL_2_03
+		+ GammaLUL_2_1_3 * GammaULL_2_13
+		+ GammaLUL_2_2_3 * GammaULL_2_23
+		+ GammaLUL_2_3_3 * GammaULL_2_33
+		- GammaULL_3_33 * trGammaL_3
+		+ GammaLUL_3_0_3 * GammaULL_3_03
+		+ GammaLUL_3_1_3 * GammaULL_3_13
+		+ GammaLUL_3_2_3 * GammaULL_3_23
+		+ GammaLUL_3_3_3 * GammaULL_3_33;
+	const Real Gaussian = RicciLL_00 * gUU_00
+		+ 2 * RicciLL_01 * gUU_01
+		+ 2 * RicciLL_02 * gUU_02
+		+ 2 * RicciLL_03 * gUU_03
+		+ RicciLL_11 * gUU_11
+		+ 2 * RicciLL_12 * gUU_12
+		+ 2 * RicciLL_13 * gUU_13
+		+ RicciLL_22 * gUU_22
+		+ 2 * RicciLL_23 * gUU_23
+		+ RicciLL_33 * gUU_33;
+	EinsteinLL(0,0) = RicciLL_00
+		- 0.5 * Gaussian * gLL_00;
+	EinsteinLL(0,1) = RicciLL_01
+		- 0.5 * Gaussian * gLL_01;
+	EinsteinLL(0,2) = RicciLL_02
+		- 0.5 * Gaussian * gLL_02;
+	EinsteinLL(0,3) = RicciLL_03
+		- 0.5 * Gaussian * gLL_03;
+	EinsteinLL(1,1) = RicciLL_11
+		- 0.5 * Gaussian * gLL_11;
+	EinsteinLL(1,2) = RicciLL_12
+		- 0.5 * Gaussian * gLL_12;
+	EinsteinLL(1,3) = RicciLL_13
+		- 0.5 * Gaussian * gLL_13;
+	EinsteinLL(2,2) = RicciLL_22
+		- 0.5 * Gaussian * gLL_22;
+	EinsteinLL(2,3) = RicciLL_23
+		- 0.5 * Gaussian * gLL_23;
+	EinsteinLL(3,3) = RicciLL_33
+		- 0.5 * Gaussian * gLL_33;
+	return EinsteinLL;
+}
@@ -0,0 +1,77 @@
+#pragma once
+
+#include <cmath>
+
+/*
+a scalar that is 'width' reals at once, one per configuration of an ensemble
+arithmetic goes lane by lane, so the EFE kernels instantiated on it advance every configuration in one pass,
+and the lane loops are the ones the compiler puts in SIMD registers
+a plain real converts to an Ensemble by broadcasting to every lane
+
+comparisons are for the kernels' sanity checks:
+a == b holds when it holds in every lane, and a != b when it holds in any lane
+so x == x is false if any lane is NaN, and rho != 0 is true if any lane has matter
+*/
+template<typename Real, int width>
+struct Ensemble {
+	Real v[width];
+
+	Ensemble() {
+		for (int l = 0; l < width; ++l) v[l] = 0;
+	}
+
+	Ensemble(Real x) {
+		for (int l = 0; l < width; ++l) v[l] = x;
+	}
+
+	Real& operator[](int l) { return v[l]; }
+	const Real& operator[](int l) const { return v[l]; }
+
+	Ensemble& operator+=(const Ensemble& b) {
+		for (int l = 0; l < width; ++l) v[l] += b.v[l];
+		return *this;
+	}
+	Ensemble& operator-=(const Ensemble& b) {
+		for (int l = 0; l < width; ++l) v[l] -= b.v[l];
+		return *this;
+	}
+	Ensemble& operator*=(const Ensemble& b) {
+		for (int l = 0; l < width; ++l) v[l] *= b.v[l];
+		return *this;
+	}
+	Ensemble& operator/=(const Ensemble& b) {
+		for (int l = 0; l < width; ++l) v[l] /= b.v[l];
+		return *this;
+	}
+
+	friend Ensemble operator+(Ensemble a, const Ensemble& b) { return a += b; }
+	friend Ensemble operator-(Ensemble a, const Ensemble& b) { return a -= b; }
+	friend Ensemble operator*(Ensemble a, const Ensemble& b) { return a *= b; }
+	friend Ensemble operator/(Ensemble a, const Ensemble& b) { return a /= b; }
+
+	friend Ensemble operator-(const Ensemble& a) {
+		Ensemble r;
+		for (int l = 0; l < width; ++l) r.v[l] = -a.v[l];
+		return r;
+	}
+
+	friend bool operator==(const Ensemble& a, const Ensemble& b) {
+		for (int l = 0; l < width; ++l) {
+			if (!(a.v[l] == b.v[l])) return false;
+		}
+		return true;
+	}
+	friend bool operator!=(const Ensemble& a, const Ensemble& b) { return !(a == b); }
+
+	friend Ensemble sqrt(const Ensemble& a) {
+		Ensemble r;
+		for (int l = 0; l < width; ++l) r.v[l] = std::sqrt(a.v[l]);
+		return r;
+	}
+
+	friend Ensemble fabs(const Ensemble& a) {
+		Ensemble r;
+		for (int l = 0; l < width; ++l) r.v[l] = std::fabs(a.v[l]);
+		return r;
+	}
+};
@@ -0,0 +1,139 @@
+#pragma once
+
+/*
+small matrix kernels that work on 'width' cells at once
+everything is stored component-major, lane-minor: m[component][lane]
+so every inner loop runs straight across the lanes and the compiler can keep it in SIMD registers
+width is meant to be 4, 8 or 16 cells
+
+symmetric 3x3 components are stored xx, xy, xz, yy, yz, zz
+symmetric 4x4 components are stored lower-triangular, same as TensorSL: 00, 10, 11, 20, 21, 22, 30, 31, 32, 33
+*/
+namespace SmallMatrixBatch {
+
+//index into the symmetric 3x3 storage
+inline int sym33(int i, int j) {
+	static const int index[3][3] = {{0, 1, 2}, {1, 3, 4}, {2, 4, 5}};
+	return index[i][j];
+}
+
+//index into the symmetric 4x4 storage
+inline int sym44(int a, int b) {
+	return a >= b ? a * (a + 1) / 2 + b : b * (b + 1) / 2 + a;
+}
+
+/*
+inverse of a symmetric 3x3 by cofactors
+det is the determinant, in case the caller wants it
+*/
+template<typename real, int width>
+inline void inverseSym33(
+	real (&inv)[6][width],
+	real (&det)[width],
+	const real (&m)[6][width]
+) {
+	for (int l = 0; l < width; ++l) {
+		real xx = m[0][l], xy = m[1][l], xz = m[2][l], yy = m[3][l], yz = m[4][l], zz = m[5][l];
+		real cxx = yy * zz - yz * yz;
+		real cxy = xz * yz - xy * zz;
+		real cxz = xy * yz - xz * yy;
+		real d = xx * cxx + xy * cxy + xz * cxz;
+		real invDet = 1. / d;
+		inv[0][l] = cxx * invDet;
+		inv[1][l] = cxy * invDet;
+		inv[2][l] = cxz * invDet;
+		inv[3][l] = (xx * zz - xz * xz) * invDet;
+		inv[4][l] = (xy * xz - xx * yz) * invDet;
+		inv[5][l] = (xx * yy - xy * xy) * invDet;
+		det[l] = d;
+	}
+}
+
+/*
+determinant of a symmetric 4x4
+expands along the 2x2 minors of the first two rows and last two rows
+*/
+template<typename real, int width>
+inline void determinantSym44(
+	real (&det)[width],
+	const real (&m)[10][width]
+) {
+	for (int l = 0; l < width; ++l) {
+		real m00 = m[0][l], m01 = m[1][l], m11 = m[2][l], m02 = m[3][l], m12 = m[4][l];
+		real m22 = m[5][l], m03 = m[6][l], m13 = m[7][l], m23 = m[8][l], m33 = m[9][l];
+		real s0 = m00 * m11 - m01 * m01;
+		real s1 = m00 * m12 - m01 * m02;
+		real s2 = m00 * m13 - m01 * m03;
+		real s3 = m01 * m12 - m11 * m02;
+		real s4 = m01 * m13 - m11 * m03;
+		real s5 = m02 * m13 - m12 * m03;
+		real c5 = m22 * m33 - m23 * m23;
+		real c4 = m12 * m33 - m13 * m23;
+		real c3 = m12 * m23 - m13 * m22;
+		real c2 = m02 * m33 - m03 * m23;
+		real c1 = m02 * m23 - m03 * m22;
+		real c0 = m02 * m13 - m03 * m12;
+		det[l] = s0 * c5 - s1 * c4 + s2 * c3 + s3 * c2 - s4 * c1 + s5 * c0;
+	}
+}
+
+/*
+ADM metric and its inverse from the lapse, shift and spatial metric:
+g_tt = -alpha^2 + beta^k beta_k
+g_ti = beta_i = gamma_ij beta^j
+g_ij = gamma_ij
+g^tt = -1/alpha^2
+g^ti = beta^i / alpha^2
+g^ij = gamma^ij - beta^i beta^j / alpha^2
+*/
+template<typename real, int width>
+inline void ADMMetric(
+	//output
+	real (&gLL)[10][width],
+	real (&gUU)[10][width],
+	//input
+	const real (&alpha)[width],
+	const real (&betaU)[3][width],
+	const real (&gammaLL)[6][width]
+) {
+	real gammaUU[6][width];
+	real detGamma[width];
+	inverseSym33<real, width>(gammaUU, detGamma, gammaLL);
+
+	real betaL[3][width];
+	for (int i = 0; i < 3; ++i) {
+		for (int l = 0; l < width; ++l) {
+			betaL[i][l] = gammaLL[sym33(i,0)][l] * betaU[0][l]
+				+ gammaLL[sym33(i,1)][l] * betaU[1][l]
+				+ gammaLL[sym33(i,2)][l] * betaU[2][l];
+		}
+	}
+
+	real invAlphaSq[width];
+	for (int l = 0; l < width; ++l) {
+		invAlphaSq[l] = 1. / (alpha[l] * alpha[l]);
+		gLL[0][l] = -alpha[l] * alpha[l]
+			+ betaL[0][l] * betaU[0][l]
+			+ betaL[1][l] * betaU[1][l]
+			+ betaL[2][l] * betaU[2][l];
+		gUU[0][l] = -invAlphaSq[l];
+	}
+
+	for (int i = 0; i < 3; ++i) {
+		int ti = sym44(i+1,0);
+		for (int l = 0; l < width; ++l) {
+			gLL[ti][l] = betaL[i][l];
+			gUU[ti][l] = betaU[i][l] * invAlphaSq[l];
+		}
+		for (int j = 0; j <= i; ++j) {
+			int ij = sym44(i+1,j+1);
+			int ij3 = sym33(i,j);
+			for (int l = 0; l < width; ++l) {
+				gLL[ij][l] = gammaLL[ij3][l];
+				gUU[ij][l] = gammaUU[ij3][l] - betaU[i][l] * betaU[j][l] * invAlphaSq[l];
+			}
+		}
+	}
+}
+
+}
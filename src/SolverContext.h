@@ -0,0 +1,96 @@
+#pragma once
+
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+
+/*
+the solver, for programs that embed it instead of running EFESoln with a config.lua
+build it as a library with lib/Makefile, and include this
+
+	EFESoln::SolverContext ctx(4);
+	ctx.setBody("earth");
+	ctx.setSolver("jfnk", 10);
+	ctx.setSize(16, 16, 16);
+	std::vector<EFESoln::Metric> metric = ctx.solve();
+
+each context has its own threads, workspace, grid and config flags, which it keeps between solves.
+nothing the solve reads is shared between contexts, so several contexts can solve at once, each from its own thread.
+one context is not safe to call from several threads at once.
+what is shared: printTime and printRanges, which only change what gets printed,
+and the log files the solvers write into the working directory (jfnk.txt, gmres.txt, ...), which concurrent solves overwrite.
+
+units are main.cpp's: lengths in m, densities and pressures in 1/m^2 (kg/m^3 * G / c^2)
+*/
+namespace EFESoln {
+
+//the metric at one cell, as MetricPrims stores it
+struct Metric {
+	double alphaMinusOne = 0;
+	double betaU[3] = {0, 0, 0};
+	double hLL[6] = {0, 0, 0, 0, 0, 0};	//h_ij = gamma_ij - delta_ij, in order xx, xy, xz, yy, yz, zz
+};
+
+//the sources at one point, as StressEnergyPrims stores them
+struct Source {
+	double rho = 0;	//matter density
+	double P = 0;	//pressure
+	double eInt = 0;	//specific internal energy
+	double v[3] = {0, 0, 0};	//3-vel (upper, spatial)
+	//used unless setUseChargeCurrentForEM(true)
+	double E[3] = {0, 0, 0};
+	double B[3] = {0, 0, 0};
+	//used if it is
+	double chargeDensity = 0;
+	double currentDensity[3] = {0, 0, 0};
+};
+
+struct SolverContext {
+	SolverContext(int numThreads);
+	~SolverContext();
+
+	//a body config.lua can name: "earth", "sun", "earth_prem", "EMUniformField", "em_line", "Null"
+	void setBody(const std::string& bodyName);
+	//a uniform sphere, radius in m and mass in kg
+	void setSphericalBody(double radius, double mass);
+	/*
+	any other body: its sources at each cell center, and the radius the domain is sized by
+	'source' is called from the context's threads at once
+	*/
+	void setBody(double radius, std::function<Source(double x, double y, double z)> source);
+
+	//an initial condition config.lua can name.  the stellar ones need a spherical body.
+	void setInitCond(const std::string& initCondName);
+	//or the metric to start from at each cell center, called like setBody's 'source'
+	void setInitCond(std::function<Metric(double x, double y, double z)> initMetric);
+
+	//a solver config.lua can name, with its default options
+	void setSolver(const std::string& solverName, int maxiter);
+
+	void setSize(int nx, int ny, int nz);
+
+	//the domain is -bodyRadii * radius to bodyRadii * radius on each axis
+	void setBodyRadii(double bodyRadii);
+
+	//config.lua's flags of the same names, with its defaults until set
+	void setConvergeAlphaOnly(bool convergeAlphaOnly);
+	//"generated", "Ricci" or "Riemann"
+	void setEinsteinPath(const std::string& einsteinPath);
+	//"metric" or "Gamma"
+	void setDGammaPath(const std::string& dGammaPath);
+	//then the body fills in chargeDensity and currentDensity instead of E and B
+	void setUseChargeCurrentForEM(bool useChargeCurrentForEM);
+
+	//solves, and returns the metric of every cell, x fastest
+	std::vector<Metric> solve();
+
+	//norm of G_ab - 8 pi T_ab over the grid, after the last solve
+	double getResidual() const;
+
+	struct Impl;
+private:
+	std::unique_ptr<Impl> impl;
+};
+
+}
@@ -33,19 +33,33 @@ ostream& operator<<(ostream& o, __float128 f) {
 #include "Common/Macros.h"
 #include "LuaCxx/State.h"
 #include "LuaCxx/Ref.h"
+#include "SmallMatrixBatch.h"
+#include "Ensemble.h"
+#include "SolverContext.h"
 #include <functional>
 #include <chrono>
 #include <iomanip>
+#include <thread>
+#include <deque>
+#include <sstream>
+#include <type_traits>
 
-#define CONVERGE_ALPHA_ONLY
-//#define PRINTTIME
-#define PRINT_RANGES
+//these used to be #defines.  now config.lua sets them at startup, see main()
+//they only change what gets printed, so every solve shares them.  the flags that change the solve are in Context
+bool printTime = false;	//time each step of the F evaluations
+bool printRanges = true;	//print the range of g_ab, g^ab, Gamma^a_bc and the EFE after each jfnk iteration
 
-const int numThreads = 8;
-Parallel::Parallel parallel(numThreads);
+const int numThreads = 8;	//main()'s
+
+//how many step lengths lineSearch = 'parallel' evaluates at once.  each gets numThreads / numLineSearchTrials threads
+const int numLineSearchTrials = 4;
 
 const int partialDerivativeOrder = 2;//options are 2, 4, 6, 8
 
+const int cellBatchWidth = 8;	//cells per SmallMatrixBatch call.  options are 4, 8, 16
+
+const int ensembleWidth = 4;	//configurations EnsembleSolver advances at once.  options are 2, 4, 8
+
 void time(const std::string name, std::function<void()> f) {
 	std::cout << name << " ... ";
 	std::cout.flush();
@@ -56,6 +70,15 @@ void time(const std::string name, std::function<void()> f) {
 	std::cout << "(" << diff.count() << "s)" << std::endl;
 }
 
+//time() when printTime is set, otherwise just call f
+void timeIfPrintTime(const std::string name, std::function<void()> f) {
+	if (printTime) {
+		time(name, f);
+	} else {
+		f();
+	}
+}
+
 //opposite upper/lower of what is already in Tensor/Inverse.h
 namespace Tensor {
 
@@ -88,10 +111,6 @@ Tensor<Real, Upper<3>> cross(Tensor<Real, Upper<3>> a, Tensor<Real, Upper<3>> b)
 
 }
 
-//enable this to use the J vector to calculate the A vector, to calculate the E & B vectors
-//disable to specify E & B directly
-//#define USE_CHARGE_CURRENT_FOR_EM
-
 //using real = float;
 using real = double;
 //using real = __float128;
@@ -99,34 +118,64 @@ using real = double;
 static constexpr auto subDim = 3;	//spatial dim
 static constexpr auto dim = subDim+1;
 
+//tensors of any scalar, so the EFE kernels can run on real or on an Ensemble of reals (see Ensemble.h)
+//the plain names are of real
+
 //subDim
-using TensorLsub = ::Tensor::Tensor<real, Tensor::Lower<subDim>>;
-using TensorUsub = ::Tensor::Tensor<real, Tensor::Upper<subDim>>;
-using TensorSUsub = ::Tensor::Tensor<real, Tensor::Symmetric<Tensor::Upper<subDim>, Tensor::Upper<subDim>>>;
-using TensorSLsub = ::Tensor::Tensor<real, Tensor::Symmetric<Tensor::Lower<subDim>, Tensor::Lower<subDim>>>;
-using TensorLLsub = ::Tensor::Tensor<real, Tensor::Lower<subDim>, Tensor::Lower<subDim>>;
-using TensorULsub = ::Tensor::Tensor<real, Tensor::Upper<subDim>, Tensor::Lower<subDim>>;
+template<typename Real> using TensorLsubOf = ::Tensor::Tensor<Real, Tensor::Lower<subDim>>;
+using TensorLsub = TensorLsubOf<real>;
+template<typename Real> using TensorUsubOf = ::Tensor::Tensor<Real, Tensor::Upper<subDim>>;
+using TensorUsub = TensorUsubOf<real>;
+template<typename Real> using TensorSUsubOf = ::Tensor::Tensor<Real, Tensor::Symmetric<Tensor::Upper<subDim>, Tensor::Upper<subDim>>>;
+using TensorSUsub = TensorSUsubOf<real>;
+template<typename Real> using TensorSLsubOf = ::Tensor::Tensor<Real, Tensor::Symmetric<Tensor::Lower<subDim>, Tensor::Lower<subDim>>>;
+using TensorSLsub = TensorSLsubOf<real>;
+template<typename Real> using TensorLLsubOf = ::Tensor::Tensor<Real, Tensor::Lower<subDim>, Tensor::Lower<subDim>>;
+using TensorLLsub = TensorLLsubOf<real>;
+template<typename Real> using TensorULsubOf = ::Tensor::Tensor<Real, Tensor::Upper<subDim>, Tensor::Lower<subDim>>;
+using TensorULsub = TensorULsubOf<real>;
 
 //dim
-using TensorU = ::Tensor::Tensor<real, Tensor::Upper<dim>>;
-using TensorL = ::Tensor::Tensor<real, Tensor::Lower<dim>>;
-using TensorSL = ::Tensor::Tensor<real, Tensor::Symmetric<Tensor::Lower<dim>, Tensor::Lower<dim>>>;
-using TensorSU = ::Tensor::Tensor<real, Tensor::Symmetric<Tensor::Upper<dim>, Tensor::Upper<dim>>>;
-using TensorLL = ::Tensor::Tensor<real, Tensor::Lower<dim>, Tensor::Lower<dim>>;
-using TensorUL = ::Tensor::Tensor<real, Tensor::Upper<dim>, Tensor::Lower<dim>>;
-using TensorUU = ::Tensor::Tensor<real, Tensor::Upper<dim>, Tensor::Upper<dim>>;
-using TensorLSL = ::Tensor::Tensor<real, Tensor::Lower<dim>, Tensor::Symmetric<Tensor::Lower<dim>, Tensor::Lower<dim>>>;
-using TensorUSL = ::Tensor::Tensor<real, Tensor::Upper<dim>, Tensor::Symmetric<Tensor::Lower<dim>, Tensor::Lower<dim>>>;
-using TensorULL = ::Tensor::Tensor<real, Tensor::Upper<dim>, Tensor::Lower<dim>, Tensor::Lower<dim>>;
-using TensorSLL = ::Tensor::Tensor<real, Tensor::Symmetric<Tensor::Lower<dim>, Tensor::Lower<dim>>, Tensor::Lower<dim>>;
-using TensorUSLL = ::Tensor::Tensor<real, Tensor::Upper<dim>, Tensor::Symmetric<Tensor::Lower<dim>, Tensor::Lower<dim>>, Tensor::Lower<dim>>;
-using TensorULLL = ::Tensor::Tensor<real, Tensor::Upper<dim>, Tensor::Lower<dim>, Tensor::Lower<dim>, Tensor::Lower<dim>>;
-using TensorSLSL = ::Tensor::Tensor<real, Tensor::Symmetric<Tensor::Lower<dim>, Tensor::Lower<dim>>, Tensor::Symmetric<Tensor::Lower<dim>, Tensor::Lower<dim>>>;
+template<typename Real> using TensorUOf = ::Tensor::Tensor<Real, Tensor::Upper<dim>>;
+using TensorU = TensorUOf<real>;
+template<typename Real> using TensorLOf = ::Tensor::Tensor<Real, Tensor::Lower<dim>>;
+using TensorL = TensorLOf<real>;
+template<typename Real> using TensorSLOf = ::Tensor::Tensor<Real, Tensor::Symmetric<Tensor::Lower<dim>, Tensor::Lower<dim>>>;
+using TensorSL = TensorSLOf<real>;
+template<typename Real> using TensorSUOf = ::Tensor::Tensor<Real, Tensor::Symmetric<Tensor::Upper<dim>, Tensor::Upper<dim>>>;
+using TensorSU = TensorSUOf<real>;
+template<typename Real> using TensorLLOf = ::Tensor::Tensor<Real, Tensor::Lower<dim>, Tensor::Lower<dim>>;
+using TensorLL = TensorLLOf<real>;
+template<typename Real> using TensorULOf = ::Tensor::Tensor<Real, Tensor::Upper<dim>, Tensor::Lower<dim>>;
+using TensorUL = TensorULOf<real>;
+template<typename Real> using TensorUUOf = ::Tensor::Tensor<Real, Tensor::Upper<dim>, Tensor::Upper<dim>>;
+using TensorUU = TensorUUOf<real>;
+template<typename Real> using TensorLSLOf = ::Tensor::Tensor<Real, Tensor::Lower<dim>, Tensor::Symmetric<Tensor::Lower<dim>, Tensor::Lower<dim>>>;
+using TensorLSL = TensorLSLOf<real>;
+template<typename Real> using TensorUSLOf = ::Tensor::Tensor<Real, Tensor::Upper<dim>, Tensor::Symmetric<Tensor::Lower<dim>, Tensor::Lower<dim>>>;
+using TensorUSL = TensorUSLOf<real>;
+template<typename Real> using TensorULLOf = ::Tensor::Tensor<Real, Tensor::Upper<dim>, Tensor::Lower<dim>, Tensor::Lower<dim>>;
+using TensorULL = TensorULLOf<real>;
+template<typename Real> using TensorSLLOf = ::Tensor::Tensor<Real, Tensor::Symmetric<Tensor::Lower<dim>, Tensor::Lower<dim>>, Tensor::Lower<dim>>;
+using TensorSLL = TensorSLLOf<real>;
+template<typename Real> using TensorUSLLOf = ::Tensor::Tensor<Real, Tensor::Upper<dim>, Tensor::Symmetric<Tensor::Lower<dim>, Tensor::Lower<dim>>, Tensor::Lower<dim>>;
+using TensorUSLL = TensorUSLLOf<real>;
+template<typename Real> using TensorULLLOf = ::Tensor::Tensor<Real, Tensor::Upper<dim>, Tensor::Lower<dim>, Tensor::Lower<dim>, Tensor::Lower<dim>>;
+using TensorULLL = TensorULLLOf<real>;
+template<typename Real> using TensorSLSLOf = ::Tensor::Tensor<Real, Tensor::Symmetric<Tensor::Lower<dim>, Tensor::Lower<dim>>, Tensor::Symmetric<Tensor::Lower<dim>, Tensor::Lower<dim>>>;
+using TensorSLSL = TensorSLSLOf<real>;
 
 //mixed subDim & dim
-using TensorLsubSL = ::Tensor::Tensor<real, Tensor::Lower<subDim>, Tensor::Symmetric<Tensor::Lower<dim>, Tensor::Lower<dim>>>;
-using TensorLsubUSL = ::Tensor::Tensor<real, Tensor::Lower<subDim>, Tensor::Upper<dim>, Tensor::Symmetric<Tensor::Lower<dim>, Tensor::Lower<dim>>>;
-using TensorLsubSLL = ::Tensor::Tensor<real, Tensor::Lower<subDim>, Tensor::Symmetric<Tensor::Lower<dim>, Tensor::Lower<dim>>, Tensor::Lower<dim>>;
+template<typename Real> using TensorLsubUOf = ::Tensor::Tensor<Real, Tensor::Lower<subDim>, Tensor::Upper<dim>>;
+using TensorLsubU = TensorLsubUOf<real>;
+template<typename Real> using TensorLsubULOf = ::Tensor::Tensor<Real, Tensor::Lower<subDim>, Tensor::Upper<dim>, Tensor::Lower<dim>>;
+using TensorLsubUL = TensorLsubULOf<real>;
+template<typename Real> using TensorLsubSLOf = ::Tensor::Tensor<Real, Tensor::Lower<subDim>, Tensor::Symmetric<Tensor::Lower<dim>, Tensor::Lower<dim>>>;
+using TensorLsubSL = TensorLsubSLOf<real>;
+template<typename Real> using TensorLsubUSLOf = ::Tensor::Tensor<Real, Tensor::Lower<subDim>, Tensor::Upper<dim>, Tensor::Symmetric<Tensor::Lower<dim>, Tensor::Lower<dim>>>;
+using TensorLsubUSL = TensorLsubUSLOf<real>;
+template<typename Real> using TensorLsubSLLOf = ::Tensor::Tensor<Real, Tensor::Lower<subDim>, Tensor::Symmetric<Tensor::Lower<dim>, Tensor::Lower<dim>>, Tensor::Lower<dim>>;
+using TensorLsubSLL = TensorLsubSLLOf<real>;
 
 template<typename T>
 struct gridFromPtr {
@@ -153,13 +202,14 @@ struct gridFromPtr {
 };
 
 //until I can get the above working ...
-TensorSUsub inverse(const TensorSLsub& gammaLL) {
+template<typename Real>
+TensorSUsubOf<Real> inverse(const TensorSLsubOf<Real>& gammaLL) {
 	//why doesn't this call work?
 	//TensorSUsub gammaUU = inverse<TensorSLsub>(gammaLL);
 	//oh well, here's the body:
 	//symmetric, so only do Lower triangular
-	TensorSUsub gammaUU;
-	real det = Tensor::determinant33<real, TensorSLsub>(gammaLL);
+	TensorSUsubOf<Real> gammaUU;
+	Real det = Tensor::determinant33<Real, TensorSLsubOf<Real>>(gammaLL);
 	gammaUU(0,0) = Tensor::det22(gammaLL(1,1), gammaLL(1,2), gammaLL(2,1), gammaLL(2,2)) / det;
 	gammaUU(1,0) = Tensor::det22(gammaLL(1,2), gammaLL(1,0), gammaLL(2,2), gammaLL(2,0)) / det;
 	gammaUU(1,1) = Tensor::det22(gammaLL(0,0), gammaLL(0,2), gammaLL(2,0), gammaLL(2,2)) / det;
@@ -187,27 +237,31 @@ real determinant44(const TensorSL &m) {
 
 //variables used to build the metric 
 //dim * (dim+1) / 2 vars
-struct MetricPrims {
-	real alphaMinusOne;
-	TensorUsub betaU;
-	TensorSLsub hLL;	//h_ij = gamma_ij - delta_ij
-	MetricPrims() : alphaMinusOne(0) {}
+template<typename Real>
+struct MetricPrimsOf {
+	Real alphaMinusOne;
+	TensorUsubOf<Real> betaU;
+	TensorSLsubOf<Real> hLL;	//h_ij = gamma_ij - delta_ij
+	MetricPrimsOf() : alphaMinusOne(0) {}
 };
+using MetricPrims = MetricPrimsOf<real>;
 
 //variables used to build the stress-energy tensor
-struct StressEnergyPrims {
+template<typename Real>
+struct StressEnergyPrimsOf {
 	
 	//source terms:
-	real rho;	//matter density
-	real P;		//pressure ... due to matter.  TODO what about magnetic pressure?
-	real eInt;	//specific internal energy
+	Real rho;	//matter density
+	Real P;		//pressure ... due to matter.  TODO what about magnetic pressure?
+	Real eInt;	//specific internal energy
 
 	bool useV;
-	TensorUsub v;	//3-vel (upper, spatial)
+	TensorUsubOf<Real> v;	//3-vel (upper, spatial)
 
 	bool useEM;
-#ifdef USE_CHARGE_CURRENT_FOR_EM
 	/*
+	used under useChargeCurrentForEM:
+	E & B are solved for from these by calc_EMFields(), see EUs and BUs
 	one way to reconstruct the E & B fields is by representing the charge and current densities	
 	B^i = curl(A^i), E^i = -dA^i/dt - grad(A^0)
 	-A^a;u_;u + A^u_;u^;a + R^a_u A^u = 4 pi J^a
@@ -223,14 +277,14 @@ struct StressEnergyPrims {
 	in fact, can any E & B be computed with a given A?
 	can any A be computed by a given E & B?
 	*/
-	real chargeDensity;
-	TensorUsub currentDensity;	//TODO how does this relate to matter density?
-#else	//USE_CHARGE_CURRENT_FOR_EM
+	Real chargeDensity;
+	TensorUsubOf<Real> currentDensity;	//TODO how does this relate to matter density?
+	
+	//used otherwise:
 	//electric & magnetic fields, which are used in the EM stress-energy tensor, and are derived from A, which is the inverse de Rham of J
 	//(can any E & B be represented by a valid A, & subsequently J?)
 	//these are upper and spatial-only
-	TensorUsub E, B;
-#endif	//USE_CHARGE_CURRENT_FOR_EM
+	TensorUsubOf<Real> E, B;
 	/*
 	1) specify charge density and current density -- components of J^a
 	2) inverse de Rham vector wave operator to solve for A^a via (-A^a;u_;u + R^a_u A^u) / 4 pi = J^a
@@ -238,15 +292,14 @@ struct StressEnergyPrims {
 	4) T_uv = 1/(4 pi)(F_u^a F_va - 1/4 g_uv F^ab F_ab)
 	*/
 
-	StressEnergyPrims()
+	StressEnergyPrimsOf()
 	: rho(0), P(0), eInt(0)	//technically these should all be positive...
 	, useV(false)
 	, useEM(false)
-#ifdef USE_CHARGE_CURRENT_FOR_EM
-	,chargeDensity(0)
-#endif
+	, chargeDensity(0)
 	{}
 };
+using StressEnergyPrims = StressEnergyPrimsOf<real>;
 
 /*
 natural units ...
@@ -273,30 +326,136 @@ const real G = 6.67384e-11;	// m^3 / (kg s^2)
 const real ke = 8987551787.3682;	//kg m^3 / (s^2 C^2)
 //const real kB = 1.3806488e-23;	// m^2 kg / (K s^2)
 
-//grid coordinate bounds
-Tensor::Vector<real, subDim> xmin, xmax;
-Tensor::Vector<int, subDim> sizev;
-int gridVolume;
-Tensor::Vector<real, subDim> dx;
-
-//some helper storage...
-Tensor::Grid<TensorSL, subDim> gLLs;
-Tensor::Grid<TensorSU, subDim> gUUs;
-Tensor::Grid<TensorSL, subDim> dt_gLLs;
-Tensor::Grid<TensorSL, subDim> d2t_gLLs;
-//Tensor::Grid<TensorSU, subDim> dt_gUUs;
-Tensor::Grid<TensorSLL, subDim> dgLLLs;
-//Tensor::Grid<TensorLSL, subDim> GammaLLLs;
-Tensor::Grid<TensorUSL, subDim> GammaULLs;
+struct Context;
+
+/*
+some helper storage...
+everything one evaluation of the EFE derives from the metric, and the threads it runs on
+a Context's 'workspace' is the one its solvers use, except for concurrent evaluations (see JFNK::lineSearch_parallel)
+the grid and the flags the kernels run with come from 'ctx'.  the grids here are usually its size, but can be a piece of it (see SchwarzPreconditioner)
+EnsembleSolver has its own, of Ensembles
+*/
+template<typename Real>
+struct WorkspaceOf {
+	const Context* ctx;
+	Parallel::Parallel* parallel;
+	Tensor::Grid<TensorSLOf<Real>, subDim> gLLs;
+	Tensor::Grid<TensorSUOf<Real>, subDim> gUUs;
+	Tensor::Grid<TensorSLOf<Real>, subDim> dt_gLLs;	//not allocated if isStationary
+	Tensor::Grid<TensorSLOf<Real>, subDim> d2t_gLLs;	//not allocated if isStationary
+	//Tensor::Grid<TensorSUOf<Real>, subDim> dt_gUUs;
+	Tensor::Grid<TensorSLLOf<Real>, subDim> dgLLLs;
+	//Tensor::Grid<TensorLSLOf<Real>, subDim> GammaLLLs;
+	Tensor::Grid<TensorUSLOf<Real>, subDim> GammaULLs;
+	int version = 0;	//bumped by calc_gLLs_and_gUUs(), so anything caching these grids can tell they were overwritten
+
+	WorkspaceOf(const Context* ctx_, Parallel::Parallel* parallel_) : ctx(ctx_), parallel(parallel_) {}
+};
+using Workspace = WorkspaceOf<real>;
+
+//only allocated under useChargeCurrentForEM
+struct EMFieldGrids {
+	Tensor::Grid<TensorU, subDim> AUs;	//A^a, kept between calc_EMFields() calls to warm-start the next
+	Tensor::Grid<TensorUsub, subDim> EUs, BUs;	//E^i, B^i derived from A^a
+};
+
+//how calc_EinsteinLL gets G_ab.  config.lua's 'einstein' picks one
+enum class EinsteinPath {
+	generated,	//the kernel from generate_EinsteinLL.lua
+	Ricci,		//loop over every index, R_ab straight from Gamma^a_bc and Gamma^a_bc,d
+	Riemann,	//loop over every index, R^a_bcd first and then contract it
+};
+
+//how the looped paths get Gamma^a_bc,d.  config.lua's 'dGamma' picks one
+enum class DGammaPath {
+	metric,	//from g_ab,cd and g^ab_,c
+	Gamma,	//finite difference of the Gamma^a_bc's.  Gamma^a_bc,t is left zero
+};
+
+/*
+cells sorted by which stress-energy terms they use
+so each list can run its own calc_8piTLL<> without per-cell branching
+vacuum cells have T_ab = 0 and are skipped altogether
+built once by classifyStressEnergyCells(), after the useEM and useV flags are set
+*/
+struct StressEnergyCellLists {
+	std::vector<int> vacuum;
+	std::vector<int> staticMatter;
+	std::vector<int> movingMatter;
+	std::vector<int> EM;
+	std::vector<int> EMAndMatter;
+};
+
+/*
+everything a solve reads besides its own grids: the config flags, the grid it is on, and the threads it runs on
+the kernels get it through their workspace, the solvers, bodies and init conds are handed it
+main() has one, each SolverContext has its own, and FASSolver's levels and EnsembleSolver copy the one they were given
+nothing else is shared, so solves on separate contexts can run at the same time
+*/
+/*
+what a solve runs with: its grid, flags, threads and workspace
+the kernels and solvers read it instead of globals, so separate Contexts can solve at once
+*/
+struct Context {
+	//these used to be #defines.  config.lua sets main()'s, SolverContext's setters its own
+	bool convergeAlphaOnly = true;	//jfnk solves for alpha only, holding the rest of the metric fixed
+	//set this to use the J vector to calculate the A vector, to calculate the E & B vectors
+	//clear it to specify E & B directly
+	bool useChargeCurrentForEM = false;
+	EinsteinPath einsteinPath = EinsteinPath::generated;
+	DGammaPath dGammaPath = DGammaPath::metric;
+
+	//grid coordinate bounds
+	Tensor::Vector<real, subDim> xmin, xmax;
+	Tensor::Vector<int, subDim> sizev;
+	int gridVolume = 0;
+	Tensor::Vector<real, subDim> dx;
+
+	/*
+	true when dt_metricPrimGrid and d2t_gLLs are all zero
+	then the calc_* functions skip every time derivative term
+	set once the initial conditions are known
+	*/
+	bool isStationary = false;
+
+	Parallel::Parallel* parallel = nullptr;
+	int numThreads = 1;	//parallel's
+	Workspace* workspace = nullptr;
+	EMFieldGrids* emFields = nullptr;
+	StressEnergyCellLists stressEnergyCells;
+};
+
+//start offsets of runs of cellBatchWidth cells out of n.  the last run may be short.
+std::vector<int> getCellBatches(int n) {
+	std::vector<int> batches;
+	for (int start = 0; start < n; start += cellBatchWidth) {
+		batches.push_back(start);
+	}
+	return batches;
+}
 
 template<typename CellType>
 void allocateGrid(Tensor::Grid<CellType, subDim>& grid, std::string name, Tensor::Vector<int, subDim> sizev, size_t& totalSize) {
 	size_t size = sizeof(CellType) * sizev.volume();
 	totalSize += size;
 	std::cout << name << ": " << size << " bytes, running total: " << totalSize << std::endl;
+	//keep what's already there when it's the right size, as it is between runs and levels of the same size
+	if (grid.v && grid.size == sizev) return;
 	grid.resize(sizev);
 }
 
+template<typename Real>
+void allocateWorkspace(WorkspaceOf<Real>& ws, std::string name, bool stationary, Tensor::Vector<int, subDim> sizev, size_t& totalSize) {
+	allocateGrid(ws.gLLs, name + ".gLLs", sizev, totalSize);
+	allocateGrid(ws.gUUs, name + ".gUUs", sizev, totalSize);
+	allocateGrid(ws.dgLLLs, name + ".dgLLLs", sizev, totalSize);
+	allocateGrid(ws.GammaULLs, name + ".GammaULLs", sizev, totalSize);
+	if (!stationary) {
+		allocateGrid(ws.dt_gLLs, name + ".dt_gLLs", sizev, totalSize);
+		allocateGrid(ws.d2t_gLLs, name + ".d2t_gLLs", sizev, totalSize);
+	}
+}
+
 static TensorSLsub make_delta3LL() {
 	TensorSLsub delta3LL;
 	delta3LL(0,0) = 1.;
@@ -306,69 +465,117 @@ static TensorSLsub make_delta3LL() {
 }
 TensorSLsub delta3LL = make_delta3LL();
 
+//gamma_ij = h_ij + delta_ij
+template<typename Real>
+TensorSLsubOf<Real> calc_gammaLL(const MetricPrimsOf<Real>& metricPrims) {
+	TensorSLsubOf<Real> gammaLL;
+	for (int i = 0; i < subDim; ++i) {
+		for (int j = 0; j <= i; ++j) {
+			gammaLL(i,j) = metricPrims.hLL(i,j) + delta3LL(i,j);
+		}
+	}
+	return gammaLL;
+}
+
+//dx as a vector of Real, for Tensor::partialDerivative
+template<typename Real>
+Tensor::Vector<Real, subDim> getDx(const Context& ctx) {
+	Tensor::Vector<Real, subDim> dxReal;
+	for (int i = 0; i < subDim; ++i) {
+		dxReal(i) = ctx.dx(i);
+	}
+	return dxReal;
+}
+
 /*
 calculates contents of gUUs, gLLs
-	(incl. first deriv: dt_gLLs)
+	(incl. first deriv: dt_gLLs, unless stationary)
 	(incl. second deriv: dt_gUUs)
 x is an array of MetricPrims[gridVolume]
 */
+template<bool stationary, typename Real>
 void calc_gLLs_and_gUUs(
 	//input
-	const Tensor::Grid<MetricPrims, subDim>& metricPrimGrid,
-	const Tensor::Grid<MetricPrims, subDim>& dt_metricPrimGrid,	//first deriv
-	//output:
-	Tensor::Grid<TensorSL, subDim>& gLLs,
-	Tensor::Grid<TensorSU, subDim>& gUUs,
-	Tensor::Grid<TensorSL, subDim>& dt_gLLs	//first deriv
+	const Tensor::Grid<MetricPrimsOf<Real>, subDim>& metricPrimGrid,
+	const Tensor::Grid<MetricPrimsOf<Real>, subDim>& dt_metricPrimGrid,	//first deriv
+	//output: gLLs, gUUs, dt_gLLs
+	WorkspaceOf<Real>& ws
 ) {
-	//calculate gLL and gUU from metric primitives
-	Tensor::RangeObj<subDim> range(Tensor::Vector<int,subDim>(), sizev);
-	parallel.foreach(range.begin(), range.end(), [&](const Tensor::Vector<int, subDim>& index) {
-		const MetricPrims &metricPrims = metricPrimGrid(index);
-		real alpha = metricPrims.alphaMinusOne + 1.;
+	Tensor::Grid<TensorSLOf<Real>, subDim>& gLLs = ws.gLLs;
+	Tensor::Grid<TensorSUOf<Real>, subDim>& gUUs = ws.gUUs;
+	Tensor::Grid<TensorSLOf<Real>, subDim>& dt_gLLs = ws.dt_gLLs;
+	++ws.version;
+
+	//calculate gLL and gUU from metric primitives, cellBatchWidth cells at a time
+	std::vector<int> batches = getCellBatches(ws.ctx->gridVolume);
+	ws.parallel->foreach(batches.begin(), batches.end(), [&](int start) {
+		int n = std::min(cellBatchWidth, ws.ctx->gridVolume - start);
+		Real alpha[cellBatchWidth], betaU[subDim][cellBatchWidth], gammaLL[6][cellBatchWidth];
+		for (int l = 0; l < cellBatchWidth; ++l) {
+			//pad a short batch with its last cell
+			const MetricPrimsOf<Real> &metricPrims = metricPrimGrid.v[start + std::min(l, n-1)];
+			alpha[l] = metricPrims.alphaMinusOne + 1.;
 //debugging
 //looks like, for the Krylov solvers, we have a problem of A(x) producing zero and A(A(x)) giving us zeros here ... which cause singular basises
 //lesson: the problem isn't linear.  don't use Krylov solvers.
-assert(alpha != 0);
-		const TensorUsub &betaU = metricPrims.betaU;
-		TensorSLsub gammaLL = metricPrims.hLL + delta3LL;
-	
-		//I can only solve for one of these.  or can I do more?  without solving for d/dt variables, I am solving 10 unknowns for 10 constraints. 
-		const MetricPrims& dt_metricPrims = dt_metricPrimGrid(index);
-
-		real alphaSq = alpha * alpha;
-
-		TensorLsub betaL;
-		for (int i = 0; i < subDim; ++i) {
-			betaL(i) = 0;
-			for (int j = 0; j < subDim; ++j) {
-				betaL(i) += betaU(j) * gammaLL(i,j);
+assert(alpha[l] != 0);
+			for (int i = 0; i < subDim; ++i) {
+				betaU[i][l] = metricPrims.betaU(i);
+				for (int j = i; j < subDim; ++j) {
+					gammaLL[SmallMatrixBatch::sym33(i,j)][l] = metricPrims.hLL(i,j) + delta3LL(i,j);
+				}
 			}
 		}
-			
-		real betaSq = 0;
-		for (int i = 0; i < subDim; ++i) {
-			betaSq += betaL(i) * betaU(i);
+		
+		//compute ADM metrics
+		Real gLL[10][cellBatchWidth], gUU[10][cellBatchWidth];
+		SmallMatrixBatch::ADMMetric<Real, cellBatchWidth>(gLL, gUU, alpha, betaU, gammaLL);
+		
+		for (int l = 0; l < n; ++l) {
+			TensorSLOf<Real> &gLL_k = gLLs.v[start + l];
+			TensorSUOf<Real> &gUU_k = gUUs.v[start + l];
+			for (int a = 0; a < dim; ++a) {
+				for (int b = 0; b <= a; ++b) {
+					gLL_k(a,b) = gLL[SmallMatrixBatch::sym44(a,b)][l];
+					gUU_k(a,b) = gUU[SmallMatrixBatch::sym44(a,b)][l];
+//debugging
+#ifdef DEBUG
+assert(gUU_k(a,b) == gUU_k(a,b));
+#endif
+				}
+			}
 		}
+	});
 
-		//compute ADM metrics
-	
-		//g_ab
-		TensorSL &gLL = gLLs(index);
-		gLL(0,0) = -alphaSq + betaSq;
+	//no time derivatives?  then we're done
+	if (stationary) return;
+
+	Tensor::RangeObj<subDim> range(Tensor::Vector<int,subDim>(), ws.ctx->sizev);
+	ws.parallel->foreach(range.begin(), range.end(), [&](const Tensor::Vector<int, subDim>& index) {
+		const MetricPrimsOf<Real> &metricPrims = metricPrimGrid(index);
+		Real alpha = metricPrims.alphaMinusOne + 1.;
+		const TensorUsubOf<Real> &betaU = metricPrims.betaU;
+		TensorSLsubOf<Real> gammaLL = calc_gammaLL(metricPrims);
+		
+		TensorLsubOf<Real> betaL;
 		for (int i = 0; i < subDim; ++i) {
-			gLL(i+1,0) = betaL(i);
+			betaL(i) = 0;
 			for (int j = 0; j < subDim; ++j) {
-				gLL(i+1,j+1) = gammaLL(i,j);
+				betaL(i) += betaU(j) * gammaLL(i,j);
 			}
 		}
+		
+		//gamma^ij
+		TensorSUsubOf<Real> gammaUU = inverse(gammaLL);
 
-		real dt_alpha = dt_metricPrims.alphaMinusOne;
-		const TensorUsub& dt_betaU = dt_metricPrims.betaU;
-		TensorSLsub dt_gammaLL = dt_metricPrims.hLL;
+		//I can only solve for one of these.  or can I do more?  without solving for d/dt variables, I am solving 10 unknowns for 10 constraints. 
+		const MetricPrimsOf<Real>& dt_metricPrims = dt_metricPrimGrid(index);
+		Real dt_alpha = dt_metricPrims.alphaMinusOne;
+		const TensorUsubOf<Real>& dt_betaU = dt_metricPrims.betaU;
+		TensorSLsubOf<Real> dt_gammaLL = dt_metricPrims.hLL;
 		
 		//g_ab,t
-		TensorSL& dt_gLL = dt_gLLs(index);
+		TensorSLOf<Real>& dt_gLL = dt_gLLs(index);
 		//g_tt,t = (-alpha^2 + beta^2),t
 		//		 = -2 alpha alpha,t + 2 beta^i_,t beta_i + beta^i beta^j gamma_ij,t
 		dt_gLL(0,0) = -2. * alpha * dt_alpha;
@@ -392,36 +599,16 @@ assert(alpha != 0);
 				dt_gLL(i+1,j+1) = dt_gammaLL(i,j);
 			}
 		}
-	
-		//gamma^ij
-		TensorSUsub gammaUU = inverse(gammaLL);
 
-		//g^ab
-		TensorSU &gUU = gUUs(index);
-		gUU(0,0) = -1/alphaSq;
-		for (int i = 0; i < subDim; ++i) {
-			gUU(i+1,0) = betaU(i) / alphaSq;
-			for (int j = 0; j <= i; ++j) {
-				gUU(i+1,j+1) = gammaUU(i,j) - betaU(i) * betaU(j) / alphaSq;
-			}
-		}
-//debugging
-#ifdef DEBUG
-for (int a = 0; a < dim; ++a) {
-	for (int b = 0; b <= a; ++b) {
-		assert(gUU(a,b) == gUU(a,b));
-	}
-}
-#endif
 		//gamma^ij_,t
 		//https://math.stackexchange.com/questions/1187861/derivative-of-transpose-of-inverse-of-matrix-with-respect-to-matrix
 		//d/dt AInv_kl = dAInv_kl / dA_ij d/dt A_ij
 		//= -AInv_ki (d/dt A_ij) AInv_jl
-		TensorSUsub dt_gammaUU;
-		TensorULsub tmp;
+		TensorSUsubOf<Real> dt_gammaUU;
+		TensorULsubOf<Real> tmp;
 		for (int k = 0; k < subDim; ++k) {
 			for (int j = 0; j < subDim; ++j) {
-				real sum = 0;
+				Real sum = 0;
 				for (int i = 0; i < subDim; ++i) {
 					sum -= gammaUU(k,i) * dt_gammaLL(i,j);
 				}
@@ -430,7 +617,7 @@ for (int a = 0; a < dim; ++a) {
 		}
 		for (int k = 0; k < subDim; ++k) {
 			for (int l = 0; l <= k; ++l) {	//dt_gammaUU is symmetric
-				real sum = 0;
+				Real sum = 0;
 				for (int j = 0; j < subDim; ++j) {
 					sum += tmp(k,j) * gammaUU(j,l);
 				}
@@ -455,320 +642,496 @@ for (int a = 0; a < dim; ++a) {
 	});
 }
 
+template<typename Real>
+void calc_gLLs_and_gUUs(
+	//input
+	const Tensor::Grid<MetricPrimsOf<Real>, subDim>& metricPrimGrid,
+	const Tensor::Grid<MetricPrimsOf<Real>, subDim>& dt_metricPrimGrid,	//first deriv
+	//output: gLLs, gUUs, dt_gLLs
+	WorkspaceOf<Real>& ws
+) {
+	if (ws.ctx->isStationary) {
+		calc_gLLs_and_gUUs<true>(metricPrimGrid, dt_metricPrimGrid, ws);
+	} else {
+		calc_gLLs_and_gUUs<false>(metricPrimGrid, dt_metricPrimGrid, ws);
+	}
+}
+
+//g_ab and g^ab of one cell, for when calc_gLLs_and_gUUs() would be overkill
+void calc_gLL_and_gUU(
+	//input
+	const MetricPrims& metricPrims,
+	//output
+	TensorSL& gLL_k,
+	TensorSU& gUU_k
+) {
+	real alpha[1] = {metricPrims.alphaMinusOne + 1.};
+	real betaU[subDim][1], gammaLL[6][1];
+	for (int i = 0; i < subDim; ++i) {
+		betaU[i][0] = metricPrims.betaU(i);
+		for (int j = i; j < subDim; ++j) {
+			gammaLL[SmallMatrixBatch::sym33(i,j)][0] = metricPrims.hLL(i,j) + delta3LL(i,j);
+		}
+	}
+	real gLL[10][1], gUU[10][1];
+	SmallMatrixBatch::ADMMetric<real, 1>(gLL, gUU, alpha, betaU, gammaLL);
+	for (int a = 0; a < dim; ++a) {
+		for (int b = 0; b <= a; ++b) {
+			gLL_k(a,b) = gLL[SmallMatrixBatch::sym44(a,b)][0];
+			gUU_k(a,b) = gUU[SmallMatrixBatch::sym44(a,b)][0];
+		}
+	}
+}
+
 /*
 calculates contents of GammaULLs
 	incl second derivs: GammaLLLs
 depends on gLLs, gUUs
-	incl first derivs: dt_gLLs
+	incl first derivs: dt_gLLs, unless stationary
 prereq: calc_gLLs_and_gUUs()
+differences are clamped to the workspace's own grid, so a workspace can cover just a piece of the domain
 */
-void calc_GammaULLs(
-	//input:
-	const Tensor::Grid<TensorSL, subDim>& gLLs,
-	const Tensor::Grid<TensorSU, subDim>& gUUs,
-	const Tensor::Grid<TensorSL, subDim>& dt_gLLs,	//first deriv
-	//output:
-	Tensor::Grid<TensorUSL, subDim>& GammaULLs
-	//Tensor::Grid<TensorLSL, subDim>& GammaLLLs	//second deriv
+template<bool stationary, typename Real>
+void calc_GammaULL(
+	//input: gLLs, gUUs, dt_gLLs
+	//output: dgLLLs, GammaULLs
+	WorkspaceOf<Real>& ws,
+	const Tensor::Vector<int, subDim>& index
 ) {
-	Tensor::RangeObj<subDim> range(Tensor::Vector<int,subDim>(), sizev);
-	parallel.foreach(range.begin(), range.end(), [&](const Tensor::Vector<int, subDim>& index) {
-		//derivatives of the metric in spatial coordinates using finite difference
-		//the templated method (1) stores derivative first and (2) only stores spatial
-		TensorLsubSL dgLLL3 = Tensor::partialDerivative<partialDerivativeOrder, real, subDim, TensorSL>(
-			index, dx,
-			[&](Tensor::Vector<int, subDim> index)
-				-> TensorSL
-			{
-				for (int i = 0; i < subDim; ++i) {
-					index(i) = std::max<int>(0, std::min<int>(sizev(i)-1, index(i)));
-				}
-				return gLLs(index);
+	const Tensor::Grid<TensorSLOf<Real>, subDim>& gLLs = ws.gLLs;
+	const Tensor::Grid<TensorSUOf<Real>, subDim>& gUUs = ws.gUUs;
+	const Tensor::Grid<TensorSLOf<Real>, subDim>& dt_gLLs = ws.dt_gLLs;	//first deriv
+	Tensor::Grid<TensorSLLOf<Real>, subDim>& dgLLLs = ws.dgLLLs;
+	Tensor::Grid<TensorUSLOf<Real>, subDim>& GammaULLs = ws.GammaULLs;
+	//Tensor::Grid<TensorLSLOf<Real>, subDim>& GammaLLLs = ws.GammaLLLs;	//second deriv
+
+	//derivatives of the metric in spatial coordinates using finite difference
+	//the templated method (1) stores derivative first and (2) only stores spatial
+	TensorLsubSLOf<Real> dgLLL3 = Tensor::partialDerivative<partialDerivativeOrder, Real, subDim, TensorSLOf<Real>>(
+		index, getDx<Real>(*ws.ctx),
+		[&](Tensor::Vector<int, subDim> index)
+			-> TensorSLOf<Real>
+		{
+			for (int i = 0; i < subDim; ++i) {
+				index(i) = std::max<int>(0, std::min<int>(gLLs.size(i)-1, index(i)));
 			}
-		);
-		const TensorSL& dt_gLL = dt_gLLs(index);
-		TensorSLL& dgLLL = dgLLLs(index);
-		for (int a = 0; a < dim; ++a) {
-			for (int b = 0; b < dim; ++b) {	
-				dgLLL(a,b,0) = dt_gLL(a,b);
-				for (int i = 0; i < subDim; ++i) {
-					dgLLL(a,b,i+1) = dgLLL3(i,a,b);
-				}
+			return gLLs(index);
+		}
+	);
+	TensorSLLOf<Real>& dgLLL = dgLLLs(index);
+	for (int a = 0; a < dim; ++a) {
+		for (int b = 0; b < dim; ++b) {	
+			//stationary leaves g_ab,t at its initial zero
+			if (!stationary) {
+				dgLLL(a,b,0) = dt_gLLs(index)(a,b);
+			}
+			for (int i = 0; i < subDim; ++i) {
+				dgLLL(a,b,i+1) = dgLLL3(i,a,b);
 			}
 		}
-		
-		//connections
-		//TensorLSL& GammaLLL = GammaLLLs(index);
-		TensorLSL GammaLLL;
-		for (int a = 0; a < dim; ++a) {
-			for (int b = 0; b < dim; ++b) {
-				for (int c = 0; c <= b; ++c) {
-					GammaLLL(a,b,c) = .5 * (dgLLL(a,b,c) + dgLLL(a,c,b) - dgLLL(b,c,a));
+	}
+	
+	//connections
+	//TensorLSLOf<Real>& GammaLLL = GammaLLLs(index);
+	TensorLSLOf<Real> GammaLLL;
+	for (int a = 0; a < dim; ++a) {
+		for (int b = 0; b < dim; ++b) {
+			for (int c = 0; c <= b; ++c) {
+				//Gamma_abc = 1/2 (g_ab,c + g_ac,b - g_bc,a), minus the g_ab,t terms if stationary
+				Real sum = 0;
+				if (!stationary || c != 0) sum += dgLLL(a,b,c);
+				if (!stationary || b != 0) sum += dgLLL(a,c,b);
+				if (!stationary || a != 0) sum -= dgLLL(b,c,a);
+				GammaLLL(a,b,c) = .5 * sum;
 //debugging
 assert(GammaLLL(a,b,c) == GammaLLL(a,b,c));
-				}
 			}
 		}
-		
-		const TensorSU &gUU = gUUs(index);		
-		TensorUSL &GammaULL = GammaULLs(index);
-		for (int a = 0; a < dim; ++a) {
-			for (int b = 0; b < dim; ++b) {
-				for (int c = 0; c <= b; ++c) {
-					real sum = 0;
-					for (int d = 0; d < dim; ++d) {
-						sum += gUU(a,d) * GammaLLL(d,b,c);
-					}
-					GammaULL(a,b,c) = sum;
+	}
+	
+	const TensorSUOf<Real> &gUU = gUUs(index);		
+	TensorUSLOf<Real> &GammaULL = GammaULLs(index);
+	for (int a = 0; a < dim; ++a) {
+		for (int b = 0; b < dim; ++b) {
+			for (int c = 0; c <= b; ++c) {
+				Real sum = 0;
+				for (int d = 0; d < dim; ++d) {
+					sum += gUU(a,d) * GammaLLL(d,b,c);
+				}
+				GammaULL(a,b,c) = sum;
 //debugging
 assert(GammaULL(a,b,c) == GammaULL(a,b,c));
-				}
 			}
 		}
-	});
+	}
 }
 
-/*
-index is the location in the grid
-depends on GammaULLs, gLLs, gUUs
-	second deriv: dt_gUUs, GammaLLLs
-prereq: calc_gLLs_and_gUUs(), calc_GammaULLs()
-*/
-TensorSL calc_EinsteinLL(
-	//input
-	Tensor::Vector<int, subDim> index,
-	const Tensor::Grid<TensorSL, subDim>& gLLs,
-	const Tensor::Grid<TensorSU, subDim>& gUUs,
-	const Tensor::Grid<TensorUSL, subDim>& GammaULLs
+//calc_GammaULL() at every cell
+template<bool stationary, typename Real>
+void calc_GammaULLs(
+	//input: gLLs, gUUs, dt_gLLs
+	//output: dgLLLs, GammaULLs
+	WorkspaceOf<Real>& ws
 ) {
-	const TensorSU &gUU = gUUs(index);
-	const TensorSLL& dgLLL = dgLLLs(index);
-	const TensorUSL &GammaULL = GammaULLs(index);
-#if 0	//calc first derivative of Gamma^a_bc's
-	//connection derivative
-	TensorLsubUSL dGammaLULL3 = Tensor::partialDerivative<partialDerivativeOrder, real, subDim, TensorUSL>(
-		index, dx, [&](Tensor::Vector<int, subDim> index) -> TensorUSL {
-			for (int i = 0; i < subDim; ++i) {
-				index(i) = std::max<int>(0, std::min<int>(sizev(i)-1, index(i)));
-			}
+	Tensor::RangeObj<subDim> range(Tensor::Vector<int,subDim>(), ws.ctx->sizev);
+	ws.parallel->foreach(range.begin(), range.end(), [&](const Tensor::Vector<int, subDim>& index) {
+		calc_GammaULL<stationary>(ws, index);
+	});
+}
 
-//debugging
-#ifdef DEBUG
-for (int i = 0; i < dim; ++i) {
-	for (int j = 0; j < dim; ++j) {
-		for (int k = 0; k <= j; ++k) {
-			assert(GammaULL(i,j,k) == GammaULL(i,j,k));
-		}
+template<typename Real>
+void calc_GammaULLs(
+	//input: gLLs, gUUs, dt_gLLs
+	//output: dgLLLs, GammaULLs
+	WorkspaceOf<Real>& ws
+) {
+	if (ws.ctx->isStationary) {
+		calc_GammaULLs<true>(ws);
+	} else {
+		calc_GammaULLs<false>(ws);
 	}
 }
-#endif
-			return GammaULLs(index);
-		});
-	
-	//const TensorSU& dt_gUU = dt_gUUs(index);
-	//const TensorLSL& GammaLLL = GammaLLLs(index);
 
-	TensorUSLL dGammaULLL;
-	for (int a = 0; a < dim; ++a) {
-		for (int b = 0; b < dim; ++b) {
-			for (int c = 0; c <= b; ++c) {
-				//TODO
-				//Gamma^a_bc,t = (g^ad Gamma_dbc),t = g^ad_,t Gamma_dbc + g^ad Gamma_dbc,t = g^ad_,t Gamma_dbc + 1/2 g^ad Gamma_dbc,t
-				//but this is where the 2nd derivative comes in, and that means providing 2 sets of initial condition metric primitives
-				real sum = 0;
-				//for (int d = 0; d < dim; ++d) {
-				//	sum += dt_gUU(a,d) * GammaLLL(d,b,c) + gUU(a,d) * dt_GammaLLL(d,b,c);
-				//}
-				dGammaULLL(a,b,c,0) = sum;
-				//finite difference
-				for (int i = 0; i < subDim; ++i) {
-					dGammaULLL(a,b,c,i+1) = dGammaLULL3(i,a,b,c);
-//debugging				
-assert(dGammaULLL(a,b,c,i+1) == dGammaULLL(a,b,c,i+1));
-				}
-			}
-		}
-	}
-#else	//calc 2nd deriv of g_ab's and 1st deriv of g^ab's instead
 /*
-Gamma^a_bc,d = 1/2 (g^ae (g_eb,c + g_ec,b - g_bc,e)),d
-	= g^ae_,d Gamma_ebc + 1/2 g^ae (g_eb,cd + g_ec,bd - g_bc,ed)
-	= -g^ae g_ef,d Gamma^f_bc + 1/2 g^ae (g_eb,cd + g_ec,bd - g_bc,ed)
+g_ab,cd at index
+depends on gLLs, dgLLLs, d2t_gLLs (unless stationary)
+prereq: calc_gLLs_and_gUUs(), calc_GammaULLs()
+stationary leaves g_ab,tc zero
 */
-	//g^ae g_ef,d
-	TensorULL gdgULL;
-	for (int a = 0; a < 4; ++a) {
-		for (int f = 0; f < 4; ++f) {
-			for (int d = 0; d < 4; ++d) {
-				real sum = 0;
-				for (int e = 0; e < 4; ++e) {
-					sum += gUU(a,e) * dgLLL(e,f,d);
-				}
-				gdgULL(a,f,d) = sum;
-			}
-		}
-	}
+template<bool stationary, typename Real>
+TensorSLSLOf<Real> calc_d2gLLLL(
+	const WorkspaceOf<Real>& ws,
+	Tensor::Vector<int, subDim> index
+) {
+	const Tensor::Grid<TensorSLOf<Real>, subDim>& gLLs = ws.gLLs;
+	const Tensor::Grid<TensorSLOf<Real>, subDim>& d2t_gLLs = ws.d2t_gLLs;
+	const Tensor::Grid<TensorSLLOf<Real>, subDim>& dgLLLs = ws.dgLLLs;
 
 	//g_ab,ci
-	TensorLsubSLL d2gLLLL3 = Tensor::partialDerivative<partialDerivativeOrder, real, subDim, TensorSLL>(
-		index, dx,
+	TensorLsubSLLOf<Real> d2gLLLL3 = Tensor::partialDerivative<partialDerivativeOrder, Real, subDim, TensorSLLOf<Real>>(
+		index, getDx<Real>(*ws.ctx),
 		[&](Tensor::Vector<int, subDim> index)
-			-> TensorSLL
+			-> TensorSLLOf<Real>
 		{
 			for (int i = 0; i < subDim; ++i) {
-				index(i) = std::max<int>(0, std::min<int>(sizev(i)-1, index(i)));
+				index(i) = std::max<int>(0, std::min<int>(dgLLLs.size(i)-1, index(i)));
 			}
 			return dgLLLs(index);
 		}
 	);
 
-
 	//g_ab,cd
-	TensorSLSL d2gLLLL;
-	const TensorSL& d2t_gLL = d2t_gLLs(index);
+	TensorSLSLOf<Real> d2gLLLL;
 	for (int a = 0; a < 4; ++a) {
 		for (int b = 0; b <= a; ++b) {
-			for (int c = 0; c < 4; ++c) {
-				for (int d = 0; d <= c; ++d) {
+			for (int c = stationary ? 1 : 0; c < 4; ++c) {
+				for (int d = stationary ? 1 : 0; d <= c; ++d) {
 					if (c == d) {
 						//then do a 2nd deriv
 						if (c == 0) {
 							//c or d is 0 = time?  then we need dt2_gLL ...
-							d2gLLLL(a,b,c,d) = d2t_gLL(a,b);
+							d2gLLLL(a,b,c,d) = d2t_gLLs(index)(a,b);
 						} else {
 							Tensor::Vector<int, subDim> ixp = index;
-							ixp(c) = std::min(ixp(c) + 1, sizev(c)-1);
+							ixp(c-1) = std::min(ixp(c-1) + 1, gLLs.size(c-1)-1);
 							Tensor::Vector<int, subDim> ixm = index;
-							ixm(c) = std::max(ixm(c) - 1, 0);
-							
-							const TensorSLL& dgLLL_ix = dgLLLs(index);
-							const TensorSLL& dgLLL_ixp = dgLLLs(ixp);
-							const TensorSLL& dgLLL_ixm = dgLLLs(ixm);
+							ixm(c-1) = std::max(ixm(c-1) - 1, 0);
 							
+							//2nd difference of g_ab, not of g_ab,c (which would be the 3rd deriv)
 							d2gLLLL(a,b,c,d) = 
-								(dgLLL_ixp(a,b,c) 
-								- dgLLL_ix(a,b,c) * 2.
-								+ dgLLL_ixm(a,b,c)) / (dx(c-1) * dx(c-1));
+								(gLLs(ixp)(a,b) 
+								- gLLs(index)(a,b) * 2.
+								+ gLLs(ixm)(a,b)) / (ws.ctx->dx(c-1) * ws.ctx->dx(c-1));
 						}
 					} else {
 						//then do a 1st deriv
-						d2gLLLL(a,b,c,d) = d2gLLLL3(d,a,b,c-1);
+						//c > d, so c is spatial: g_ab,dc = (g_ab,d),c
+						d2gLLLL(a,b,c,d) = d2gLLLL3(c-1,a,b,d);
 					}
 				}
 			}
 		}
 	}
+	return d2gLLLL;
+}
 
-	//Gamma^a_bcd = -g^ae g_ef,d Gamma^f_bc + 1/2 g^ae (g_eb,cd + g_ec,bd - g_bc,ed)
-	TensorUSLL dGammaULLL;
-	for (int a = 0; a < 4; ++a) {
-		for (int b = 0; b < 4; ++b) {
-			for (int c = 0; c < 4; ++c) {
-				for (int d = 0; d < 4; ++d) {
-					real sum = 0;
-					for (int f = 0; f < 4; ++f) {
-						//-g^ae g_ef,d Gamma^f_bc
-						sum -= gdgULL(a,f,d) * GammaULL(f,b,c);
-						//+ 1/2 g^af (g_fb,cd + g_fc,bd - g_bc,fd)
-						sum += .5 * gUU(a,f) * (d2gLLLL(f,b,c,d) + d2gLLLL(f,c,b,d) - d2gLLLL(b,c,f,d));
-					}
-					dGammaULLL(a,b,c,d) = sum;
-				}
-			}
-		}
-	}
-#endif
-#if 0	//calculate the Riemann, then the Ricci
-	TensorULLL GammaSqULLL;
-	for (int a = 0; a < dim; ++a) {
-		for (int b = 0; b < dim; ++b) {
-			for (int c = 0; c < dim; ++c) {
-				for (int d = 0; d < dim; ++d) {
-					real sum = 0;
-					for (int e = 0; e < dim; ++e) {
-						sum += GammaULL(a,e,d) * GammaULL(e,b,c);
-					}
-					GammaSqULLL(a,b,c,d) = sum;
-//debugging
-assert(GammaSqULLL(a,b,c,d) == GammaSqULLL(a,b,c,d));				
-				}
-			}
-		}
+#include "EinsteinLL.h"
+
+//config.lua's 'einstein' and 'dGamma' names, which SolverContext takes too
+EinsteinPath getEinsteinPath(const std::string& einsteinName) {
+	struct {
+		const char* name;
+		EinsteinPath path;
+	} einsteinPaths[] = {
+		{"generated", EinsteinPath::generated},
+		{"Ricci", EinsteinPath::Ricci},
+		{"Riemann", EinsteinPath::Riemann},
+	}, *p;
+	for (p = einsteinPaths; p < endof(einsteinPaths); ++p) {
+		if (p->name == einsteinName) return p->path;
 	}
+	throw Common::Exception() << "couldn't find einstein path named " << einsteinName;
+}
 
-	/*
-	technically the last two are antisymmetric ... but I don't think I have that working yet ... 
-	...and if I stored RiemannLLLL then the first two would be antisymmetric as well, and the pairs of the first two and second two would be symmetric
+DGammaPath getDGammaPath(const std::string& dGammaName) {
+	struct {
+		const char* name;
+		DGammaPath path;
+	} dGammaPaths[] = {
+		{"metric", DGammaPath::metric},
+		{"Gamma", DGammaPath::Gamma},
+	}, *p;
+	for (p = dGammaPaths; p < endof(dGammaPaths); ++p) {
+		if (p->name == dGammaName) return p->path;
+	}
+	throw Common::Exception() << "couldn't find dGamma path named " << dGammaName;
+}
 
-	Symmetry goes away with torsion
+/*
+calls f(einstein, dGamma) with std::integral_constant's of ctx's einsteinPath and dGammaPath,
+so whatever loop f runs has them as template parameters instead of branching per cell
+generated doesn't use dGammaPath, so it only gets instantiated with metric
+*/
+template<typename F>
+auto dispatchEinsteinPath(const Context& ctx, F f) {
+	using Generated = std::integral_constant<EinsteinPath, EinsteinPath::generated>;
+	using Ricci = std::integral_constant<EinsteinPath, EinsteinPath::Ricci>;
+	using Riemann = std::integral_constant<EinsteinPath, EinsteinPath::Riemann>;
+	using Metric = std::integral_constant<DGammaPath, DGammaPath::metric>;
+	using Gamma = std::integral_constant<DGammaPath, DGammaPath::Gamma>;
+	switch (ctx.einsteinPath) {
+	case EinsteinPath::Ricci:
+		if (ctx.dGammaPath == DGammaPath::Gamma) return f(Ricci(), Gamma());
+		return f(Ricci(), Metric());
+	case EinsteinPath::Riemann:
+		if (ctx.dGammaPath == DGammaPath::Gamma) return f(Riemann(), Gamma());
+		return f(Riemann(), Metric());
+	default:
+		return f(Generated(), Metric());
+	}
+}
 
-	Gamma^a_bc e_a = e_b;c
+//whether the kernel finite-differences Gamma^a_bc, which is itself a finite difference of g_ab
+bool differencesGamma(const Context& ctx) {
+	return ctx.einsteinPath != EinsteinPath::generated && ctx.dGammaPath == DGammaPath::Gamma;
+}
 
-	Torsion = T^a_bc = Gamma^a_bc - Gamma^a_cb
-	...so order of Gamma matters
-	...so what is the covariant derivative?
-	is it v^a_;b = v^a_,b + Gamma^a_cb v^c ?	<- I'm using this so the derivative index is last
-	or v^a_;b = v^a_,b + Gamma^a_bc v^c ?
-	
-	v^a_;bc - v^a_;cb = Riemann^a_bcd v^d
-	(v^a_,b + Gamma^a_db v^d);c - (v^a_,c + Gamma^a_dc v^d);b
-	v^a_,bc + 
+/*
+how many cells out F at a cell reads the metric, corners included
+g_ab,c and g_ab,cd reach partialDerivativeOrder / 2, and differencing Gamma^a_bc on top of that reaches twice as far
+DirtyRegionTracker, SchwarzPreconditioner, ColoredJacobian and FASSolver's coloring are built on it
+*/
+int getStencilRadius(const Context& ctx) {
+	int radius = partialDerivativeOrder / 2;
+	return differencesGamma(ctx) ? 2 * radius : radius;
+}
 
-	*/
-	TensorULLL RiemannULLL;
-	for (int a = 0; a < dim; ++a) {
-		for (int b = 0; b < dim; ++b) {
-			for (int c = 0; c < dim; ++c) {
-				for (int d = 0; d < dim; ++d) {
-					RiemannULLL(a,b,c,d) = dGammaULLL(a,b,d,c) - dGammaULLL(a,b,c,d) + GammaSqULLL(a,b,d,c) - GammaSqULLL(a,b,c,d);
-//debugging
-assert(RiemannULLL(a,b,c,d) == RiemannULLL(a,b,c,d));
+/*
+index is the location in the grid
+depends on GammaULLs, gLLs, gUUs
+	second deriv: dt_gUUs, GammaLLLs
+prereq: calc_gLLs_and_gUUs(), calc_GammaULLs()
+*/
+template<bool stationary, EinsteinPath einstein, DGammaPath dGamma, typename Real>
+TensorSLOf<Real> calc_EinsteinLL(
+	//input: gLLs, gUUs, dgLLLs, GammaULLs
+	const WorkspaceOf<Real>& ws,
+	Tensor::Vector<int, subDim> index
+) {
+	const Tensor::Grid<TensorSLOf<Real>, subDim>& gLLs = ws.gLLs;
+	const Tensor::Grid<TensorUSLOf<Real>, subDim>& GammaULLs = ws.GammaULLs;
+	const TensorSUOf<Real> &gUU = ws.gUUs(index);
+	const TensorSLLOf<Real>& dgLLL = ws.dgLLLs(index);
+	const TensorUSLOf<Real> &GammaULL = GammaULLs(index);
+	if (einstein == EinsteinPath::generated) {
+		if (stationary) {
+			return calc_EinsteinLL_stationary_generated(gLLs(index), gUU, GammaULL, dgLLL, calc_d2gLLLL<true>(ws, index));
+		}
+		return calc_EinsteinLL_generated(gLLs(index), gUU, GammaULL, dgLLL, calc_d2gLLLL<false>(ws, index));
+	}
+
+	//loop over every index
+	TensorUSLLOf<Real> dGammaULLL;
+	if (dGamma == DGammaPath::Gamma) {
+		//calc first derivative of Gamma^a_bc's
+		//connection derivative
+		TensorLsubUSLOf<Real> dGammaLULL3 = Tensor::partialDerivative<partialDerivativeOrder, Real, subDim, TensorUSLOf<Real>>(
+			index, getDx<Real>(*ws.ctx), [&](Tensor::Vector<int, subDim> index) -> TensorUSLOf<Real> {
+				for (int i = 0; i < subDim; ++i) {
+					index(i) = std::max<int>(0, std::min<int>(GammaULLs.size(i)-1, index(i)));
+				}
+
+//debugging
+#ifdef DEBUG
+for (int i = 0; i < dim; ++i) {
+	for (int j = 0; j < dim; ++j) {
+		for (int k = 0; k <= j; ++k) {
+			assert(GammaULL(i,j,k) == GammaULL(i,j,k));
+		}
+	}
+}
+#endif
+				return GammaULLs(index);
+			});
+		
+		//const TensorSU& dt_gUU = dt_gUUs(index);
+		//const TensorLSL& GammaLLL = GammaLLLs(index);
+
+		for (int a = 0; a < dim; ++a) {
+			for (int b = 0; b < dim; ++b) {
+				for (int c = 0; c <= b; ++c) {
+					//TODO
+					//Gamma^a_bc,t = (g^ad Gamma_dbc),t = g^ad_,t Gamma_dbc + g^ad Gamma_dbc,t = g^ad_,t Gamma_dbc + 1/2 g^ad Gamma_dbc,t
+					//but this is where the 2nd derivative comes in, and that means providing 2 sets of initial condition metric primitives
+					Real sum = 0;
+					//for (int d = 0; d < dim; ++d) {
+					//	sum += dt_gUU(a,d) * GammaLLL(d,b,c) + gUU(a,d) * dt_GammaLLL(d,b,c);
+					//}
+					dGammaULLL(a,b,c,0) = sum;
+					//finite difference
+					for (int i = 0; i < subDim; ++i) {
+						dGammaULLL(a,b,c,i+1) = dGammaLULL3(i,a,b,c);
+//debugging				
+assert(dGammaULLL(a,b,c,i+1) == dGammaULLL(a,b,c,i+1));
+					}
+				}
+			}
+		}
+	} else {
+		/*
+		calc 2nd deriv of g_ab's and 1st deriv of g^ab's instead
+		Gamma^a_bc,d = 1/2 (g^ae (g_eb,c + g_ec,b - g_bc,e)),d
+			= g^ae_,d Gamma_ebc + 1/2 g^ae (g_eb,cd + g_ec,bd - g_bc,ed)
+			= -g^ae g_ef,d Gamma^f_bc + 1/2 g^ae (g_eb,cd + g_ec,bd - g_bc,ed)
+		*/
+		//g^ae g_ef,d
+		TensorULLOf<Real> gdgULL;
+		for (int a = 0; a < 4; ++a) {
+			for (int f = 0; f < 4; ++f) {
+				for (int d = 0; d < 4; ++d) {
+					Real sum = 0;
+					for (int e = 0; e < 4; ++e) {
+						sum += gUU(a,e) * dgLLL(e,f,d);
+					}
+					gdgULL(a,f,d) = sum;
+				}
+			}
+		}
+
+		//g_ab,cd
+		TensorSLSLOf<Real> d2gLLLL = calc_d2gLLLL<stationary>(ws, index);
+
+		//Gamma^a_bcd = -g^ae g_ef,d Gamma^f_bc + 1/2 g^ae (g_eb,cd + g_ec,bd - g_bc,ed)
+		for (int a = 0; a < 4; ++a) {
+			for (int b = 0; b < 4; ++b) {
+				for (int c = 0; c < 4; ++c) {
+					for (int d = 0; d < 4; ++d) {
+						Real sum = 0;
+						for (int f = 0; f < 4; ++f) {
+							//-g^ae g_ef,d Gamma^f_bc
+							sum -= gdgULL(a,f,d) * GammaULL(f,b,c);
+							//+ 1/2 g^af (g_fb,cd + g_fc,bd - g_bc,fd)
+							sum += .5 * gUU(a,f) * (d2gLLLL(f,b,c,d) + d2gLLLL(f,c,b,d) - d2gLLLL(b,c,f,d));
+						}
+						dGammaULLL(a,b,c,d) = sum;
+					}
 				}
 			}
 		}
 	}
 
-	TensorSL RicciLL;
-	for (int a = 0; a < dim; ++a) {
-		for (int b = 0; b < dim; ++b) {
-			real sum = 0;
-			for (int c = 0; c < dim; ++c) {
-				sum += RiemannULLL(c,a,c,b);
+	TensorSLOf<Real> RicciLL;
+	if (einstein == EinsteinPath::Riemann) {
+		//calculate the Riemann, then the Ricci
+		TensorULLLOf<Real> GammaSqULLL;
+		for (int a = 0; a < dim; ++a) {
+			for (int b = 0; b < dim; ++b) {
+				for (int c = 0; c < dim; ++c) {
+					for (int d = 0; d < dim; ++d) {
+						Real sum = 0;
+						for (int e = 0; e < dim; ++e) {
+							sum += GammaULL(a,e,d) * GammaULL(e,b,c);
+						}
+						GammaSqULLL(a,b,c,d) = sum;
+//debugging
+assert(GammaSqULLL(a,b,c,d) == GammaSqULLL(a,b,c,d));				
+					}
+				}
+			}
+		}
+
+		/*
+		technically the last two are antisymmetric ... but I don't think I have that working yet ... 
+		...and if I stored RiemannLLLL then the first two would be antisymmetric as well, and the pairs of the first two and second two would be symmetric
+
+		Symmetry goes away with torsion
+
+		Gamma^a_bc e_a = e_b;c
+
+		Torsion = T^a_bc = Gamma^a_bc - Gamma^a_cb
+		...so order of Gamma matters
+		...so what is the covariant derivative?
+		is it v^a_;b = v^a_,b + Gamma^a_cb v^c ?	<- I'm using this so the derivative index is last
+		or v^a_;b = v^a_,b + Gamma^a_bc v^c ?
+		
+		v^a_;bc - v^a_;cb = Riemann^a_bcd v^d
+		(v^a_,b + Gamma^a_db v^d);c - (v^a_,c + Gamma^a_dc v^d);b
+		v^a_,bc + 
+
+		*/
+		TensorULLLOf<Real> RiemannULLL;
+		for (int a = 0; a < dim; ++a) {
+			for (int b = 0; b < dim; ++b) {
+				for (int c = 0; c < dim; ++c) {
+					for (int d = 0; d < dim; ++d) {
+						RiemannULLL(a,b,c,d) = dGammaULLL(a,b,d,c) - dGammaULLL(a,b,c,d) + GammaSqULLL(a,b,d,c) - GammaSqULLL(a,b,c,d);
+//debugging
+assert(RiemannULLL(a,b,c,d) == RiemannULLL(a,b,c,d));
+					}
+				}
 			}
-			RicciLL(a,b) = sum;
+		}
+
+		for (int a = 0; a < dim; ++a) {
+			for (int b = 0; b < dim; ++b) {
+				Real sum = 0;
+				for (int c = 0; c < dim; ++c) {
+					sum += RiemannULLL(c,a,c,b);
+				}
+				RicciLL(a,b) = sum;
 //debugggin
 assert(RicciLL(a,b) == RicciLL(a,b));
+			}
 		}
-	}
-#else	//just calculate the Ricci
-	TensorL Gamma12L;
-	for (int a = 0; a < dim; ++a) {
-		real sum = 0;
-		for (int b = 0; b < dim; ++b) {
-			sum += GammaULL(b,b,a);
+	} else {
+		//just calculate the Ricci
+		TensorLOf<Real> Gamma12L;
+		for (int a = 0; a < dim; ++a) {
+			Real sum = 0;
+			for (int b = 0; b < dim; ++b) {
+				sum += GammaULL(b,b,a);
+			}
+			Gamma12L(a) = sum;
 		}
-		Gamma12L(a) = sum;
-	}
-	
-	//R_ab = Gamma^c_ab,c - Gamma^c_ac,b + Gamma^d_ab Gamma^c_cd - Gamma^d_ac Gamma^c_bd
-	TensorSL RicciLL;
-	for (int a = 0; a < dim; ++a) {
-		for (int b = 0; b < dim; ++b) {
-			real sum = 0;
-			for (int c = 0; c < dim; ++c) {
-				sum += dGammaULLL(c,a,b,c) - dGammaULLL(c,a,c,b) + GammaULL(c,a,b) * Gamma12L(c);
-				for (int d = 0; d < dim; ++d) {
-					sum -= GammaULL(d,a,c) * GammaULL(c,b,d);
+		
+		//R_ab = Gamma^c_ab,c - Gamma^c_ac,b + Gamma^d_ab Gamma^c_cd - Gamma^d_ac Gamma^c_bd
+		for (int a = 0; a < dim; ++a) {
+			for (int b = 0; b < dim; ++b) {
+				Real sum = 0;
+				for (int c = 0; c < dim; ++c) {
+					sum += dGammaULLL(c,a,b,c) - dGammaULLL(c,a,c,b) + GammaULL(c,a,b) * Gamma12L(c);
+					for (int d = 0; d < dim; ++d) {
+						sum -= GammaULL(d,a,c) * GammaULL(c,b,d);
+					}
 				}
-			}
-			RicciLL(a,b) = sum;
+				RicciLL(a,b) = sum;
 //debugggin
 assert(RicciLL(a,b) == RicciLL(a,b));
+			}
 		}
 	}
-#endif
 	
-	real Gaussian = 0;
+	Real Gaussian = 0;
 	for (int a = 0; a < dim; ++a) {
 		for (int b = 0; b < dim; ++b) {
 			Gaussian += gUU(a,b) * RicciLL(a,b);
@@ -777,8 +1140,8 @@ assert(RicciLL(a,b) == RicciLL(a,b));
 //debugging
 assert(Gaussian == Gaussian);
 
-	const TensorSL &gLL = gLLs(index);
-	TensorSL EinsteinLL;
+	const TensorSLOf<Real> &gLL = gLLs(index);
+	TensorSLOf<Real> EinsteinLL;
 	for (int a = 0; a < dim; ++a) {
 		for (int b = 0; b < dim; ++b) {
 			EinsteinLL(a,b) = RicciLL(a,b) - .5 * Gaussian * gLL(a,b);
@@ -790,23 +1153,44 @@ assert(EinsteinLL(a,b) == EinsteinLL(a,b));
 	return EinsteinLL;
 }
 
+//one cell, with the path config.lua picked.  this switches on every call, so loops over cells go through dispatchEinsteinPath themselves
+template<bool stationary, typename Real>
+TensorSLOf<Real> calc_EinsteinLL(
+	//input: gLLs, gUUs, dgLLLs, GammaULLs
+	const WorkspaceOf<Real>& ws,
+	Tensor::Vector<int, subDim> index
+) {
+	return dispatchEinsteinPath(*ws.ctx, [&](auto einstein, auto dGamma) {
+		return calc_EinsteinLL<stationary, decltype(einstein)::value, decltype(dGamma)::value>(ws, index);
+	});
+}
+
+template<typename Real>
+TensorSLOf<Real> calc_EinsteinLL(
+	//input: gLLs, gUUs, dgLLLs, GammaULLs
+	const WorkspaceOf<Real>& ws,
+	Tensor::Vector<int, subDim> index
+) {
+	if (ws.ctx->isStationary) return calc_EinsteinLL<true>(ws, index);
+	return calc_EinsteinLL<false>(ws, index);
+}
+
 /*
 calls calc_EinsteinLL at each point
 stores G_ab 
 */
+template<bool stationary, EinsteinPath einstein, DGammaPath dGamma, typename Real>
 void calc_EinsteinLLs(
-	//input
-	const Tensor::Grid<TensorSL, subDim>& gLLs,
-	const Tensor::Grid<TensorSU, subDim>& gUUs,
-	const Tensor::Grid<TensorUSL, subDim>& GammaULLs,
+	//input: gLLs, gUUs, dgLLLs, GammaULLs
+	WorkspaceOf<Real>& ws,
 	//output:
-	Tensor::Grid<TensorSL, subDim>& EinsteinLLs
+	Tensor::Grid<TensorSLOf<Real>, subDim>& EinsteinLLs
 ) {
-	Tensor::RangeObj<subDim> range(Tensor::Vector<int,subDim>(), sizev);
-	assert(sizeof(TensorSL) == sizeof(MetricPrims));	//10 reals for both
-	parallel.foreach(range.begin(), range.end(), [&](const Tensor::Vector<int, subDim>& index) {
-		TensorSL& EinsteinLL = EinsteinLLs(index);
-		EinsteinLL = calc_EinsteinLL(index, gLLs, gUUs, GammaULLs);
+	Tensor::RangeObj<subDim> range(Tensor::Vector<int,subDim>(), ws.ctx->sizev);
+	assert(sizeof(TensorSLOf<Real>) == sizeof(MetricPrimsOf<Real>));	//10 reals for both
+	ws.parallel->foreach(range.begin(), range.end(), [&](const Tensor::Vector<int, subDim>& index) {
+		TensorSLOf<Real>& EinsteinLL = EinsteinLLs(index);
+		EinsteinLL = calc_EinsteinLL<stationary, einstein, dGamma>(ws, index);
 
 //debugging
 #ifdef DEBUG
@@ -819,6 +1203,22 @@ for (int a = 0; a < dim; ++a) {
 	});
 }
 
+template<typename Real>
+void calc_EinsteinLLs(
+	//input: gLLs, gUUs, dgLLLs, GammaULLs
+	WorkspaceOf<Real>& ws,
+	//output:
+	Tensor::Grid<TensorSLOf<Real>, subDim>& EinsteinLLs
+) {
+	dispatchEinsteinPath(*ws.ctx, [&](auto einstein, auto dGamma) {
+		if (ws.ctx->isStationary) {
+			calc_EinsteinLLs<true, decltype(einstein)::value, decltype(dGamma)::value>(ws, EinsteinLLs);
+		} else {
+			calc_EinsteinLLs<false, decltype(einstein)::value, decltype(dGamma)::value>(ws, EinsteinLLs);
+		}
+	});
+}
+
 /*
 index is the location in the grid
 metricPrims are the metric primitives at that point
@@ -826,80 +1226,48 @@ returns 8*pi*T_ab for T_ab the stress energy at that point
 depends on: stressEnergyPrims, gLLs, calc_gLLs_and_gUUs()
 now compute stress-energy based on source terms
 notice: stress energy depends on gLL (i.e. alpha, betaU, gammaLL), which it is solving for, so this has to be recalculated every iteration
+useEM, useMatter, useV select which terms are compiled in.  the cell has to agree with them, see StressEnergyCellLists.
+sqrtDetG = sqrt|det g_ab|, E, B are only used by the EM terms
 */
-TensorSL calc_8piTLL(
-	const MetricPrims& metricPrims,
-	const TensorSL &gLL,
-	const TensorSU &gUU,
-	const StressEnergyPrims& stressEnergyPrims
+template<bool useEM, bool useMatter, bool useV, typename Real>
+TensorSLOf<Real> calc_8piTLL(
+	const MetricPrimsOf<Real>& metricPrims,
+	const TensorSLOf<Real> &gLL,
+	const TensorSUOf<Real> &gUU,
+	Real sqrtDetG,
+	const TensorUsubOf<Real>& E,
+	const TensorUsubOf<Real>& B,
+	const StressEnergyPrimsOf<Real>& stressEnergyPrims
 ) {
-	TensorSLsub gammaLL = metricPrims.hLL + delta3LL;
-
 	//electromagnetic stress-energy
-	TensorSL T_EM_LL;
-	if (stressEnergyPrims.useEM) {
+	TensorSLOf<Real> T_EM_LL;
+	if (useEM) {
 
-#ifdef USE_CHARGE_CURRENT_FOR_EM
-		TensorU JU;
-		JU(0) = stressEnergyPrims.chargeDensity;
-		for (int i = 0; i < subDim; ++i) {
-			JU(i+1) = stressEnergyPrims.currentDensity(i);
-		}
-		TensorU AU = JU;
-		/*
-		A^a;u = A^a_;v g^uv = (A^a_,v + Gamma^a_wv A^w) g^uv
-		A^a;u_;u = A^a;u_,u + Gamma^a_bu A^b;u + Gamma^u_bu A^a;b
-				= (A^a_;v g^uv = (A^a_,v + Gamma^a_wv A^w) g^uv)_,u
-					+ Gamma^a_bu (A^b_,v + Gamma^b_wv A^w) g^uv
-					- Gamma^u_bu (A^a_,v + Gamma^a_wv A^w) g^bv
-		((A^a_,b + Gamma^a_cb A^c) + R^a_b A^b) / (4 pi) = J^a
-		
-		but then we have to run the JFNK to find A across all the grid, so we can use spatial derivatives
-		...and what about time derivatives?  assume steady state, or provide the time derivative 
-		*/
-		JFNK(dim,
-			dim, 
-			JU.v,
-			[&](double* y, const double* x) {
-				for (int a = 0; i < dim; ++a) {
-					y[0] = 
-				}
-			}
-		);
-#else	//USE_CHARGE_CURRENT_FOR_EM
-		TensorUsub E = stressEnergyPrims.E;
-		TensorUsub B = stressEnergyPrims.B;
-#endif
-		
-		//should I be doing a full 4x4 determinant?
-		//if converging beta then yep
-		real sqrtDetG = sqrt(fabs(determinant44(gLL)));
-	
 		//n_a = t_,a
-		TensorL nL;
+		TensorLOf<Real> nL;
 		for (int a = 0; a < 4; ++a) {
 			nL(a) = a == 0 ? 1 : 0;
 		}
 	
 		//n^a = g^ab n_b
-		TensorU nU;
+		TensorUOf<Real> nU;
 		for (int a = 0; a < 4; ++a) {
-			real sum = 0;
+			Real sum = 0;
 			for (int b = 0; b < 4; ++b) {
 				sum += gUU(a,b) * nL(b);
 			}
 			nU(a) = sum;
 		}
 
-		TensorU BU, EU;
+		TensorUOf<Real> BU, EU;
 		for (int i = 0; i < 3; ++i) {
 			BU(i+1) = B(i);
 			EU(i+1) = E(i);
 		}
 	
-		TensorL EL;
+		TensorLOf<Real> EL;
 		for (int a = 0; a < 4; ++a) {
-			real sum = 0;
+			Real sum = 0;
 			for (int b = 0; b < 4; ++b) {
 				sum += gLL(a,b) * EU(b);
 			}
@@ -911,14 +1279,14 @@ TensorSL calc_8piTLL(
 		//	= E_a n_b - n_a E_b - sqrt|g| n^c [abcd] B^d
 		//	= E_a n_b - n_a E_b - sqrt|g| n^c [abcd] B^d
 		//assuming E and B are specified in Cartesian coordinates as one-forms
-		TensorLL F_LL;
+		TensorLLOf<Real> F_LL;
 		for (int a = 0; a < dim; ++a) {
 			for (int b = 0; b < dim; ++b) {
 				F_LL(a,b) = EL(a) * nL(b) - nL(a) * EL(b);
 			}
 		}
 
-		real tmp;
+		Real tmp;
 #define ADD_B_TO_F(a,b,c,d)	tmp = sqrtDetG * (BU(c) * nU(d) - BU(d) * nU(c)); F_LL(a,b) += tmp; F_LL(b,a) -= tmp;
 		ADD_B_TO_F(0,1,2,3)	//+ 0 1 2 3, - 0 1 3 2
 		ADD_B_TO_F(0,2,3,1)	//+ 0 2 3 1, - 0 2 1 3
@@ -927,10 +1295,10 @@ TensorSL calc_8piTLL(
 		ADD_B_TO_F(1,3,2,0)	//+ 1 3 2 0, - 1 3 0 2
 		ADD_B_TO_F(2,3,0,1)	//+ 2 3 0 1, - 2 3 1 0
 
-		TensorUL F_LU;
+		TensorULOf<Real> F_LU;
 		for (int a = 0; a < dim; ++a) {
 			for (int b = 0; b < dim; ++b) {
-				real sum = 0;
+				Real sum = 0;
 				for (int c = 0; c < dim; ++c) {
 					sum += F_LL(a,c) * gUU(c,b);
 				}
@@ -938,10 +1306,10 @@ TensorSL calc_8piTLL(
 			}
 		}
 		
-		TensorUU F_UU;
+		TensorUUOf<Real> F_UU;
 		for (int a = 0; a < dim; ++a) {
 			for (int b = 0; b < dim; ++b) {
-				real sum = 0;
+				Real sum = 0;
 				for (int c = 0; c < dim; ++c) {
 					sum += gUU(a,c) * F_LU(c,b);
 				}
@@ -949,7 +1317,7 @@ TensorSL calc_8piTLL(
 			}
 		}
 
-		real FNormSq = 0;
+		Real FNormSq = 0;
 		for (int a = 0; a < dim; ++a) {
 			for (int b = 0; b < dim; ++b) {
 				FNormSq += F_LL(a,b) * F_UU(a,b);
@@ -959,7 +1327,7 @@ TensorSL calc_8piTLL(
 		//T_ab = 1/(4 pi) (F_ac F_b^c - 1/4 g_ab F_cd F^cd)
 		for (int a = 0; a < dim; ++a) {
 			for (int b = 0; b <= a; ++b) {
-				real sum = -gLL(a,b) * FNormSq / 4.;
+				Real sum = -gLL(a,b) * FNormSq / 4.;
 				for (int c = 0; c < dim; ++c) {
 					sum += F_LL(a,c) * F_LU(b,c);
 				}
@@ -969,61 +1337,63 @@ TensorSL calc_8piTLL(
 	}
 
 	//matter stress-energy
+	TensorSLOf<Real> T_matter_LL;
+	if (useMatter) {
+		TensorLOf<Real> uL;
+		if (useV) {
+			const TensorUsubOf<Real> &v = stressEnergyPrims.v;
+			TensorSLsubOf<Real> gammaLL = calc_gammaLL(metricPrims);
+
+			//Lorentz factor
+			Real vLenSq = 0;
+			for (int i = 0; i < subDim; ++i) {
+				for (int j = 0; j < subDim; ++j) {
+					vLenSq += v(i) * v(j) * gammaLL(i,j);
+				}
+			}
+			Real W = 1 / sqrt( 1 - sqrt(vLenSq) );
 
-	TensorL uL;
-	if (stressEnergyPrims.useV) {
-		const TensorUsub &v = stressEnergyPrims.v;
-
-		//Lorentz factor
-		real vLenSq = 0;
-		for (int i = 0; i < subDim; ++i) {
-			for (int j = 0; j < subDim; ++j) {
-				vLenSq += v(i) * v(j) * gammaLL(i,j);
+			//4-vel upper
+			TensorUOf<Real> uU;
+			uU(0) = W;
+			for (int i = 0; i < subDim; ++i) {
+				uU(i+1) = W * v(i);
 			}
-		}
-		real W = 1 / sqrt( 1 - sqrt(vLenSq) );
 
-		//4-vel upper
-		TensorU uU;
-		uU(0) = W;
-		for (int i = 0; i < subDim; ++i) {
-			uU(i+1) = W * v(i);
+			//4-vel lower
+			for (int a = 0; a < dim; ++a) {
+				uL(a) = 0;
+				for (int b = 0; b < dim; ++b) {
+					uL(a) += uU(b) * gLL(b,a);
+				}
+			}
+		} else {
+			for (int a = 0; a < dim; ++a) {
+				uL(a) = gLL(a,0);
+			}
 		}
 
-		//4-vel lower
+		/*
+		Right now I'm using the SRHD T_matter_ab = (rho + rho eInt) u_a u_b + P P_ab
+			for P^ab = g^ab + u^a u^b = projection tensor
+		TODO viscious matter stress-energy: MTW 22.16d: T^ab = rho u^a u^b + (P - zeta theta) P^ab - 2 eta sigma^ab + q^a u^b + u^a q^b
+		T_heat_ab = q^a u^b + u^a q^b 
+			q^a = the heat-flux 4-vector
+		T_viscous_ab = -2 eta sigma^ab - zeta theta P^ab 
+			eta >= 0 = coefficient of dynamic viscosity
+			zeta >= 0 = coefficient of bulk viscosity
+			sigma^ab = 1/2(u^a_;u P^ub + u^b_;u P^ua) - theta P^ab / 3 = shear
+			theta = u^a_;a = expansion
+		*/	
 		for (int a = 0; a < dim; ++a) {
-			uL(a) = 0;
-			for (int b = 0; b < dim; ++b) {
-				uL(a) += uU(b) * gLL(b,a);
+			for (int b = 0; b <= a; ++b) {
+				T_matter_LL(a,b) = uL(a) * uL(b) * (stressEnergyPrims.rho * (1 + stressEnergyPrims.eInt) + stressEnergyPrims.P) + gLL(a,b) * stressEnergyPrims.P;
 			}
 		}
-	} else {
-		for (int a = 0; a < dim; ++a) {
-			uL(a) = gLL(a,0);
-		}
-	}
-
-	/*
-	Right now I'm using the SRHD T_matter_ab = (rho + rho eInt) u_a u_b + P P_ab
-		for P^ab = g^ab + u^a u^b = projection tensor
-	TODO viscious matter stress-energy: MTW 22.16d: T^ab = rho u^a u^b + (P - zeta theta) P^ab - 2 eta sigma^ab + q^a u^b + u^a q^b
-	T_heat_ab = q^a u^b + u^a q^b 
-		q^a = the heat-flux 4-vector
-	T_viscous_ab = -2 eta sigma^ab - zeta theta P^ab 
-		eta >= 0 = coefficient of dynamic viscosity
-		zeta >= 0 = coefficient of bulk viscosity
-		sigma^ab = 1/2(u^a_;u P^ub + u^b_;u P^ua) - theta P^ab / 3 = shear
-		theta = u^a_;a = expansion
-	*/	
-	TensorSL T_matter_LL;
-	for (int a = 0; a < dim; ++a) {
-		for (int b = 0; b <= a; ++b) {
-			T_matter_LL(a,b) = uL(a) * uL(b) * (stressEnergyPrims.rho * (1 + stressEnergyPrims.eInt) + stressEnergyPrims.P) + gLL(a,b) * stressEnergyPrims.P;
-		}
 	}
 
 	//total stress-energy	
-	TensorSL _8piT_LL;
+	TensorSLOf<Real> _8piT_LL;
 	for (int a = 0; a < dim; ++a) {
 		for (int b = 0; b <= a; ++b) {
 			_8piT_LL(a,b) = (T_EM_LL(a,b) + T_matter_LL(a,b)) * 8. * M_PI;
@@ -1032,67 +1402,719 @@ TensorSL calc_8piTLL(
 	return _8piT_LL;
 }
 
-/*
-x holds a grid of MetricPrims
-stores at y a grid of the values (G_ab - 8 pi T_ab)
-depends on: calc_gLLs_and_gUUs(), calc_GammaULLs()
-*/
-void calc_EFE_constraint(
+//for an Ensemble, if any lane has matter
+template<typename Real>
+bool hasMatter(const StressEnergyPrimsOf<Real>& stressEnergyPrims) {
+	return stressEnergyPrims.rho != 0 || stressEnergyPrims.P != 0;
+}
+
+template<typename Real>
+void classifyStressEnergyCells(
 	//input
-	const Tensor::Grid<MetricPrims, subDim>& metricPrimGrid,
-	const Tensor::Grid<StressEnergyPrims, subDim>& stressEnergyPrimGrid,
+	const Tensor::Grid<StressEnergyPrimsOf<Real>, subDim>& stressEnergyPrimGrid,
 	//output
-	Tensor::Grid<TensorSL, subDim>& EFEGrid
+	StressEnergyCellLists& cells
 ) {
-	Tensor::RangeObj<subDim> range(Tensor::Vector<int,subDim>(), sizev);
-	parallel.foreach(range.begin(), range.end(), [&](const Tensor::Vector<int, subDim>& index) {
-		
-		//for the JFNK solver that doesn't cache the EinsteinLL tensors
-		// no need to allocate for both an EinsteinLL grid and a EFEGrid
-		TensorSL EinsteinLL = calc_EinsteinLL(index, gLLs, gUUs, GammaULLs);
-		
-		//now we want to find the zeroes of EinsteinLL(a,b) - 8 pi T(a,b)
-		// ... which is 10 zeroes ...
-		// ... and we are minimizing the inputs to our metric ...
-		// alpha, beta x3, gamma x6
-		// ... which is 10 variables
-		// tada!
-		TensorSL _8piT_LL = calc_8piTLL(
-			metricPrimGrid(index),
-			gLLs(index),
-			gUUs(index),
-			stressEnergyPrimGrid(index));
+	cells = StressEnergyCellLists();
+	for (int k = 0; k < stressEnergyPrimGrid.size.volume(); ++k) {
+		const StressEnergyPrimsOf<Real>& stressEnergyPrims = stressEnergyPrimGrid.v[k];
+		bool useMatter = hasMatter(stressEnergyPrims);
+		if (stressEnergyPrims.useEM) {
+			(useMatter ? cells.EMAndMatter : cells.EM).push_back(k);
+		} else if (useMatter) {
+			(stressEnergyPrims.useV ? cells.movingMatter : cells.staticMatter).push_back(k);
+		} else {
+			cells.vacuum.push_back(k);
+		}
+	}
+	std::cout << "stress-energy cells:"
+		<< " vacuum=" << cells.vacuum.size()
+		<< " staticMatter=" << cells.staticMatter.size()
+		<< " movingMatter=" << cells.movingMatter.size()
+		<< " EM=" << cells.EM.size()
+		<< " EMAndMatter=" << cells.EMAndMatter.size()
+		<< std::endl;
+}
+
+//set the 'useV' and 'useEM' flags from what the body filled in, to spare our calculations
+void initStressEnergyFlags(const Context& ctx, Tensor::Grid<StressEnergyPrims, subDim>& stressEnergyPrimGrid) {
+	//under useChargeCurrentForEM the E & B solved from any charge or current reach every cell, not just the ones with the source
+	bool anyChargeCurrent = false;
+	if (ctx.useChargeCurrentForEM) {
+		for (int k = 0; k < ctx.gridVolume && !anyChargeCurrent; ++k) {
+			const StressEnergyPrims& stressEnergyPrims = stressEnergyPrimGrid.v[k];
+			anyChargeCurrent |= stressEnergyPrims.chargeDensity != 0;
+			for (int i = 0; i < subDim; ++i) {
+				anyChargeCurrent |= stressEnergyPrims.currentDensity(i) != 0;
+			}
+		}
+	}
+
+	Tensor::RangeObj<subDim> range(Tensor::Vector<int,subDim>(), ctx.sizev);
+	ctx.parallel->foreach(range.begin(), range.end(), [&](const Tensor::Vector<int, subDim>& index) {
+		StressEnergyPrims& stressEnergyPrims = stressEnergyPrimGrid(index);
 		
-		/*
-		now solve the linear system G_uv = G(g_uv) = 8 pi T_uv for g_uv 
-		i.e. A(x) = b, assuming A is linear ...
-		but it looks like, because T is based on g, it will really look like G(g_uv) = 8 pi T(g_uv, source terms)
-		*/
+		stressEnergyPrims.useV = false;
+		for (int i = 0; i < subDim; ++i) {
+			stressEnergyPrims.useV |= stressEnergyPrims.v(i) != 0;
+		}
 		
-		TensorSL &EFE = EFEGrid(index);
+		stressEnergyPrims.useEM = false;
+		if (ctx.useChargeCurrentForEM) {
+			stressEnergyPrims.useEM = anyChargeCurrent;
+		} else {
+			for (int i = 0; i < subDim; ++i) {
+				stressEnergyPrims.useEM |= stressEnergyPrims.E(i) != 0;
+				stressEnergyPrims.useEM |= stressEnergyPrims.B(i) != 0;
+			}
+		}
+	});
+}
+
+//E^i and B^i of cell k
+//under useChargeCurrentForEM they are solved for by calc_EMFields(), which only works on real.  EnsembleSolver refuses those.
+template<typename Real>
+const TensorUsubOf<Real>& getEU(const Context& ctx, const Tensor::Grid<StressEnergyPrimsOf<Real>, subDim>& stressEnergyPrimGrid, int k) { return stressEnergyPrimGrid.v[k].E; }
+template<typename Real>
+const TensorUsubOf<Real>& getBU(const Context& ctx, const Tensor::Grid<StressEnergyPrimsOf<Real>, subDim>& stressEnergyPrimGrid, int k) { return stressEnergyPrimGrid.v[k].B; }
+const TensorUsub& getEU(const Context& ctx, const Tensor::Grid<StressEnergyPrims, subDim>& stressEnergyPrimGrid, int k) {
+	return ctx.useChargeCurrentForEM ? ctx.emFields->EUs.v[k] : stressEnergyPrimGrid.v[k].E;
+}
+const TensorUsub& getBU(const Context& ctx, const Tensor::Grid<StressEnergyPrims, subDim>& stressEnergyPrimGrid, int k) {
+	return ctx.useChargeCurrentForEM ? ctx.emFields->BUs.v[k] : stressEnergyPrimGrid.v[k].B;
+}
+
+//for one-off cells.  grid passes should use add_8piTLLs
+TensorSL calc_8piTLL(
+	const Context& ctx,
+	const MetricPrims& metricPrims,
+	const TensorSL &gLL,
+	const TensorSU &gUU,
+	const Tensor::Grid<StressEnergyPrims, subDim>& stressEnergyPrimGrid,
+	int k
+) {
+	const StressEnergyPrims& stressEnergyPrims = stressEnergyPrimGrid.v[k];
+	const TensorUsub& E = getEU(ctx, stressEnergyPrimGrid, k);
+	const TensorUsub& B = getBU(ctx, stressEnergyPrimGrid, k);
+	bool useMatter = hasMatter(stressEnergyPrims);
+	if (stressEnergyPrims.useEM) {
+		//should I be doing a full 4x4 determinant?
+		//if converging beta then yep
+		//same determinant as add_8piTLLs, so one-off cells agree with grid passes to the bit
+		real gLL_[10][1], detG[1];
 		for (int a = 0; a < dim; ++a) {
 			for (int b = 0; b <= a; ++b) {
-				EFE(a,b) = EinsteinLL(a,b) - _8piT_LL(a,b);
+				gLL_[SmallMatrixBatch::sym44(a,b)][0] = gLL(a,b);
 			}
 		}
-	});
+		SmallMatrixBatch::determinantSym44<real, 1>(detG, gLL_);
+		real sqrtDetG = sqrt(fabs(detG[0]));
+		if (useMatter) return calc_8piTLL<true, true, true>(metricPrims, gLL, gUU, sqrtDetG, E, B, stressEnergyPrims);
+		return calc_8piTLL<true, false, false>(metricPrims, gLL, gUU, sqrtDetG, E, B, stressEnergyPrims);
+	}
+	if (!useMatter) return TensorSL();
+	if (stressEnergyPrims.useV) return calc_8piTLL<false, true, true>(metricPrims, gLL, gUU, (real)0, E, B, stressEnergyPrims);
+	return calc_8piTLL<false, true, false>(metricPrims, gLL, gUU, (real)0, E, B, stressEnergyPrims);
 }
 
-struct EFESolver {
-	int maxiter;
-	EFESolver(int maxiter_) : maxiter(maxiter_) {}
-	size_t getN() { return sizeof(MetricPrims) / sizeof(real) * gridVolume; }
-	virtual void solve(
-		//input/output
-		Tensor::Grid<MetricPrims, subDim>& metricPrimGrid,
-		//input
-		const Tensor::Grid<MetricPrims, subDim>& dt_metricPrimGrid,	//first deriv
-		const Tensor::Grid<StressEnergyPrims, subDim>& stressEnergyPrimGrid
-	) = 0;
-};
+template<bool useEM, bool useMatter, bool useV, typename Real>
+void add_8piTLLs(
+	//input
+	const WorkspaceOf<Real>& ws,	//gLLs, gUUs
+	const std::vector<int>& cellList,
+	const Tensor::Grid<MetricPrimsOf<Real>, subDim>& metricPrimGrid,
+	const Tensor::Grid<StressEnergyPrimsOf<Real>, subDim>& stressEnergyPrimGrid,
+	real scale,
+	//output
+	Tensor::Grid<TensorSLOf<Real>, subDim>& TLLs
+) {
+	auto addCell = [&](int k, Real sqrtDetG) {
+		TensorSLOf<Real> _8piT_LL = calc_8piTLL<useEM, useMatter, useV>(
+			metricPrimGrid.v[k],
+			ws.gLLs.v[k],
+			ws.gUUs.v[k],
+			sqrtDetG,
+			getEU(*ws.ctx, stressEnergyPrimGrid, k),
+			getBU(*ws.ctx, stressEnergyPrimGrid, k),
+			stressEnergyPrimGrid.v[k]);
+		TensorSLOf<Real>& TLL = TLLs.v[k];
+		for (int a = 0; a < dim; ++a) {
+			for (int b = 0; b <= a; ++b) {
+				TLL(a,b) += scale * _8piT_LL(a,b);
+			}
+		}
+	};
+	
+	if (!useEM) {
+		ws.parallel->foreach(cellList.begin(), cellList.end(), [&](int k) {
+			addCell(k, 0);
+		});
+		return;
+	}
 
-/*
-use a linear solver and treat G_ab = 8 pi T_ab like a linear system A x = b for x = (alpha, beta, gamma), A x = G_ab(x), and b = 8 pi T_ab ... which is also a function of x ...
+	//EM needs sqrt|det g_ab|.  take the 4x4 determinants cellBatchWidth cells at a time
+	int numCells = (int)cellList.size();
+	std::vector<int> batches = getCellBatches(numCells);
+	ws.parallel->foreach(batches.begin(), batches.end(), [&](int start) {
+		int n = std::min(cellBatchWidth, numCells - start);
+		Real gLL[10][cellBatchWidth], detG[cellBatchWidth];
+		for (int l = 0; l < cellBatchWidth; ++l) {
+			const TensorSLOf<Real>& gLL_k = ws.gLLs.v[cellList[start + std::min(l, n-1)]];
+			for (int a = 0; a < dim; ++a) {
+				for (int b = 0; b <= a; ++b) {
+					gLL[SmallMatrixBatch::sym44(a,b)][l] = gLL_k(a,b);
+				}
+			}
+		}
+		SmallMatrixBatch::determinantSym44<Real, cellBatchWidth>(detG, gLL);
+		for (int l = 0; l < n; ++l) {
+			addCell(cellList[start + l], sqrt(fabs(detG[l])));
+		}
+	});
+}
+
+/*
+adds scale * 8 pi T_ab to TLLs, one of the workspace context's stressEnergyCells lists at a time
+depends on: classifyStressEnergyCells(), calc_gLLs_and_gUUs()
+*/
+template<typename Real>
+void add_8piTLLs(
+	//input
+	const WorkspaceOf<Real>& ws,	//gLLs, gUUs
+	const Tensor::Grid<MetricPrimsOf<Real>, subDim>& metricPrimGrid,
+	const Tensor::Grid<StressEnergyPrimsOf<Real>, subDim>& stressEnergyPrimGrid,
+	real scale,
+	//output
+	Tensor::Grid<TensorSLOf<Real>, subDim>& TLLs
+) {
+	const StressEnergyCellLists& cells = ws.ctx->stressEnergyCells;
+	//vacuum adds nothing
+	add_8piTLLs<false, true, false>(ws, cells.staticMatter, metricPrimGrid, stressEnergyPrimGrid, scale, TLLs);
+	add_8piTLLs<false, true, true>(ws, cells.movingMatter, metricPrimGrid, stressEnergyPrimGrid, scale, TLLs);
+	add_8piTLLs<true, false, false>(ws, cells.EM, metricPrimGrid, stressEnergyPrimGrid, scale, TLLs);
+	add_8piTLLs<true, true, true>(ws, cells.EMAndMatter, metricPrimGrid, stressEnergyPrimGrid, scale, TLLs);
+}
+
+//A^a at index, zero outside the grid
+TensorU getAUOrZero(const Tensor::Grid<TensorU, subDim>& AUs, const Tensor::Vector<int, subDim>& index) {
+	for (int i = 0; i < subDim; ++i) {
+		if (index(i) < 0 || index(i) >= AUs.size(i)) return TensorU();
+	}
+	return AUs(index);
+}
+
+/*
+y^a = -A^a;u_;u + R^a_u A^u, in Lorentz gauge and assuming steady state (A^a_,t = 0)
+A^a_;u = A^a_,u + Gamma^a_bu A^b
+A^a;u_;u = g^uv (A^a_;u,v + Gamma^a_bv A^b_;u - Gamma^b_uv A^a_;b)
+A^a is zero outside the grid
+depends on: calc_gLLs_and_gUUs(), calc_GammaULLs()
+*/
+void calc_vectorWaveOperator(
+	//input
+	const Workspace& ws,	//gUUs, GammaULLs
+	const Tensor::Grid<TensorU, subDim>& AUs,
+	const Tensor::Grid<TensorUL, subDim>& RicciULs,
+	//output
+	Tensor::Grid<TensorUL, subDim>& DAULs,	//A^a_;b
+	Tensor::Grid<TensorU, subDim>& yUs
+) {
+	Tensor::RangeObj<subDim> range(Tensor::Vector<int,subDim>(), ws.ctx->sizev);
+	ws.parallel->foreach(range.begin(), range.end(), [&](const Tensor::Vector<int, subDim>& index) {
+		TensorLsubU dAU3 = Tensor::partialDerivative<partialDerivativeOrder, real, subDim, TensorU>(
+			index, ws.ctx->dx,
+			[&](Tensor::Vector<int, subDim> index) -> TensorU {
+				return getAUOrZero(AUs, index);
+			}
+		);
+		const TensorU& AU = AUs(index);
+		const TensorUSL& GammaULL = ws.GammaULLs(index);
+		TensorUL& DAUL = DAULs(index);
+		for (int a = 0; a < dim; ++a) {
+			for (int u = 0; u < dim; ++u) {
+				real sum = u == 0 ? 0 : dAU3(u-1, a);
+				for (int b = 0; b < dim; ++b) {
+					sum += GammaULL(a,b,u) * AU(b);
+				}
+				DAUL(a,u) = sum;
+			}
+		}
+	});
+	ws.parallel->foreach(range.begin(), range.end(), [&](const Tensor::Vector<int, subDim>& index) {
+		TensorLsubUL dDAUL3 = Tensor::partialDerivative<partialDerivativeOrder, real, subDim, TensorUL>(
+			index, ws.ctx->dx,
+			[&](Tensor::Vector<int, subDim> index) -> TensorUL {
+				for (int i = 0; i < subDim; ++i) {
+					index(i) = std::max<int>(0, std::min<int>(ws.ctx->sizev(i)-1, index(i)));
+				}
+				return DAULs(index);
+			}
+		);
+		const TensorU& AU = AUs(index);
+		const TensorUL& DAUL = DAULs(index);
+		const TensorUSL& GammaULL = ws.GammaULLs(index);
+		const TensorSU& gUU = ws.gUUs(index);
+		const TensorUL& RicciUL = RicciULs(index);
+		TensorU& yU = yUs(index);
+		for (int a = 0; a < dim; ++a) {
+			real laplacian = 0;
+			for (int u = 0; u < dim; ++u) {
+				for (int v = 0; v < dim; ++v) {
+					//A^a_;u;v
+					real D2A = v == 0 ? 0 : dDAUL3(v-1, a, u);
+					for (int b = 0; b < dim; ++b) {
+						D2A += GammaULL(a,b,v) * DAUL(b,u) - GammaULL(b,u,v) * DAUL(a,b);
+					}
+					laplacian += gUU(u,v) * D2A;
+				}
+			}
+			real sum = -laplacian;
+			for (int u = 0; u < dim; ++u) {
+				sum += RicciUL(a,u) * AU(u);
+			}
+			yU(a) = sum;
+		}
+	});
+}
+
+const real EMFieldEpsilon = 1e-10;
+const int EMFieldMaxIter = 100;
+const int EMFieldRestart = 20;
+
+/*
+solves -A^a;u_;u + R^a_u A^u = 4 pi J^a for A^a across the whole grid with GMRES
+starts from the A^a of the last call, so repeated solves on a slowly changing metric are cheap
+then E^i = -A^t_,i and B^i = curl(A)^i, as described in StressEnergyPrims
+R_ab = G_ab - 1/2 g_ab g^cd G_cd
+this is meant to run once per Newton iteration.  F(x) calls in between see E and B frozen.
+depends on: calc_gLLs_and_gUUs(), calc_GammaULLs(), classifyStressEnergyCells()
+*/
+void calc_EMFields(
+	//input
+	Workspace& ws,
+	const Tensor::Grid<StressEnergyPrims, subDim>& stressEnergyPrimGrid
+) {
+	const Context& ctx = *ws.ctx;
+	if (ctx.stressEnergyCells.EM.empty() && ctx.stressEnergyCells.EMAndMatter.empty()) return;
+	
+	Tensor::Grid<TensorU, subDim>& AUs = ctx.emFields->AUs;
+	Tensor::Grid<TensorUsub, subDim>& EUs = ctx.emFields->EUs;
+	Tensor::Grid<TensorUsub, subDim>& BUs = ctx.emFields->BUs;
+	const Tensor::Vector<int, subDim>& sizev = ctx.sizev;
+
+	Tensor::RangeObj<subDim> range(Tensor::Vector<int,subDim>(), sizev);
+	
+	Tensor::Grid<TensorUL, subDim> RicciULs(sizev);
+	Tensor::Grid<TensorSL, subDim> EinsteinLLs(sizev);
+	calc_EinsteinLLs(ws, EinsteinLLs);
+	ws.parallel->foreach(range.begin(), range.end(), [&](const Tensor::Vector<int, subDim>& index) {
+		const TensorSL& EinsteinLL = EinsteinLLs(index);
+		const TensorSL& gLL = ws.gLLs(index);
+		const TensorSU& gUU = ws.gUUs(index);
+		real EinsteinTrace = 0;
+		for (int a = 0; a < dim; ++a) {
+			for (int b = 0; b < dim; ++b) {
+				EinsteinTrace += gUU(a,b) * EinsteinLL(a,b);
+			}
+		}
+		TensorUL& RicciUL = RicciULs(index);
+		for (int a = 0; a < dim; ++a) {
+			for (int b = 0; b < dim; ++b) {
+				real sum = 0;
+				for (int c = 0; c < dim; ++c) {
+					sum += gUU(a,c) * (EinsteinLL(c,b) - .5 * gLL(c,b) * EinsteinTrace);
+				}
+				RicciUL(a,b) = sum;
+			}
+		}
+	});
+
+	Tensor::Grid<TensorU, subDim> _4piJUs(sizev);
+	ws.parallel->foreach(range.begin(), range.end(), [&](const Tensor::Vector<int, subDim>& index) {
+		const StressEnergyPrims& stressEnergyPrims = stressEnergyPrimGrid(index);
+		TensorU& _4piJU = _4piJUs(index);
+		_4piJU(0) = 4. * M_PI * stressEnergyPrims.chargeDensity;
+		for (int i = 0; i < subDim; ++i) {
+			_4piJU(i+1) = 4. * M_PI * stressEnergyPrims.currentDensity(i);
+		}
+	});
+
+	Tensor::Grid<TensorUL, subDim> DAULs(sizev);
+	Solver::GMRES<real> gmres(
+		dim * ctx.gridVolume,	//n = vector size
+		(real*)AUs.v,	//x = A^a, warm-started
+		(const real*)_4piJUs.v,	//b = 4 pi J^a
+		[&](real* y, const real* x) {
+			Tensor::Grid<TensorU, subDim> yUs(sizev, (TensorU*)y);
+			calc_vectorWaveOperator(ws, Tensor::Grid<TensorU, subDim>(sizev, (TensorU*)x), RicciULs, DAULs, yUs);
+		},
+		EMFieldEpsilon,
+		EMFieldMaxIter,
+		EMFieldRestart
+	);
+	gmres.solve();
+	//this runs on every EM refresh, including each of the continuation's residuals
+	if (printTime) std::cout << "A^a solve iter=" << gmres.getIter() << " residual=" << gmres.getResidual() << std::endl;
+
+	ws.parallel->foreach(range.begin(), range.end(), [&](const Tensor::Vector<int, subDim>& index) {
+		TensorLsubU dAU3 = Tensor::partialDerivative<partialDerivativeOrder, real, subDim, TensorU>(
+			index, ctx.dx,
+			[&](Tensor::Vector<int, subDim> index) -> TensorU {
+				return getAUOrZero(AUs, index);
+			}
+		);
+		TensorUsub& E = EUs(index);
+		TensorUsub& B = BUs(index);
+		for (int i = 0; i < subDim; ++i) {
+			E(i) = -dAU3(i,0);
+		}
+		B(0) = dAU3(1,3) - dAU3(2,2);
+		B(1) = dAU3(2,1) - dAU3(0,3);
+		B(2) = dAU3(0,2) - dAU3(1,1);
+	});
+}
+
+//g_ab and Gamma^a_bc of metricPrimGrid, then A^a, E and B from them
+void update_EMFields(
+	Workspace& ws,
+	//input
+	const Tensor::Grid<MetricPrims, subDim>& metricPrimGrid,
+	const Tensor::Grid<MetricPrims, subDim>& dt_metricPrimGrid,	//first deriv
+	const Tensor::Grid<StressEnergyPrims, subDim>& stressEnergyPrimGrid
+) {
+	calc_gLLs_and_gUUs(metricPrimGrid, dt_metricPrimGrid, ws);
+	calc_GammaULLs(ws);
+	calc_EMFields(ws, stressEnergyPrimGrid);
+}
+
+/*
+x holds a grid of MetricPrims
+stores at y a grid of the values (G_ab - 8 pi T_ab)
+depends on: calc_gLLs_and_gUUs(), calc_GammaULLs()
+*/
+template<bool stationary, EinsteinPath einstein, DGammaPath dGamma, typename Real>
+void calc_EFE_constraint(
+	//input
+	WorkspaceOf<Real>& ws,	//gLLs, gUUs, dgLLLs, GammaULLs
+	const Tensor::Grid<MetricPrimsOf<Real>, subDim>& metricPrimGrid,
+	const Tensor::Grid<StressEnergyPrimsOf<Real>, subDim>& stressEnergyPrimGrid,
+	//output
+	Tensor::Grid<TensorSLOf<Real>, subDim>& EFEGrid
+) {
+	Tensor::RangeObj<subDim> range(Tensor::Vector<int,subDim>(), ws.ctx->sizev);
+	ws.parallel->foreach(range.begin(), range.end(), [&](const Tensor::Vector<int, subDim>& index) {
+		
+		//for the JFNK solver that doesn't cache the EinsteinLL tensors
+		// no need to allocate for both an EinsteinLL grid and a EFEGrid
+		EFEGrid(index) = calc_EinsteinLL<stationary, einstein, dGamma>(ws, index);
+	});
+		
+	//now we want to find the zeroes of EinsteinLL(a,b) - 8 pi T(a,b)
+	// ... which is 10 zeroes ...
+	// ... and we are minimizing the inputs to our metric ...
+	// alpha, beta x3, gamma x6
+	// ... which is 10 variables
+	// tada!
+	/*
+	now solve the linear system G_uv = G(g_uv) = 8 pi T_uv for g_uv 
+	i.e. A(x) = b, assuming A is linear ...
+	but it looks like, because T is based on g, it will really look like G(g_uv) = 8 pi T(g_uv, source terms)
+	*/
+	add_8piTLLs(ws, metricPrimGrid, stressEnergyPrimGrid, -1, EFEGrid);
+}
+
+template<typename Real>
+void calc_EFE_constraint(
+	//input
+	WorkspaceOf<Real>& ws,	//gLLs, gUUs, dgLLLs, GammaULLs
+	const Tensor::Grid<MetricPrimsOf<Real>, subDim>& metricPrimGrid,
+	const Tensor::Grid<StressEnergyPrimsOf<Real>, subDim>& stressEnergyPrimGrid,
+	//output
+	Tensor::Grid<TensorSLOf<Real>, subDim>& EFEGrid
+) {
+	dispatchEinsteinPath(*ws.ctx, [&](auto einstein, auto dGamma) {
+		if (ws.ctx->isStationary) {
+			calc_EFE_constraint<true, decltype(einstein)::value, decltype(dGamma)::value>(ws, metricPrimGrid, stressEnergyPrimGrid, EFEGrid);
+		} else {
+			calc_EFE_constraint<false, decltype(einstein)::value, decltype(dGamma)::value>(ws, metricPrimGrid, stressEnergyPrimGrid, EFEGrid);
+		}
+	});
+}
+
+/*
+dirty-region tracking for the EFE residual
+remembers the metric prims that its workspace's g_ab, g^ab and Gamma^a_bc were last computed from, and the EFE_ab they gave
+the next evaluation only recomputes g_ab, g^ab at the cells whose prims moved by more than 'tolerance',
+ and Gamma^a_bc and EFE_ab within getStencilRadius() of those
+	F at a cell reads g_ab within that many cells, corners included, so that neighborhood is all that changes
+tolerance = 0 only skips cells that didn't change at all, so the result is the same as a full evaluation
+tolerance > 0 is an active set: cells that moved less keep their old prims here, and their drift adds up until they don't
+starts over whenever someone else writes the workspace (see Workspace::version), which includes update_EMFields()
+falls back to a full evaluation when over maxDirtyFraction of the grid is dirty, and when not stationary
+*/
+struct DirtyRegionTracker {
+	real tolerance;
+	real maxDirtyFraction = .25;
+
+	Workspace* ws = nullptr;	//the workspace whose grids match 'prims'
+	int wsVersion = 0;	//its version when they did
+	std::vector<MetricPrims> prims;
+	std::vector<TensorSL> EFEs;
+	std::vector<char> dirty, affected;
+
+	//totals, for seeing how much was skipped
+	long evaluations = 0;
+	long cellsRecomputed = 0;
+
+	DirtyRegionTracker(real tolerance_) : tolerance(tolerance_) {}
+
+	void invalidate() { ws = nullptr; }
+
+	void calcFull(
+		Workspace& ws_,
+		const Tensor::Grid<MetricPrims, subDim>& metricPrimGrid,
+		const Tensor::Grid<MetricPrims, subDim>& dt_metricPrimGrid,	//first deriv
+		const Tensor::Grid<StressEnergyPrims, subDim>& stressEnergyPrimGrid,
+		Tensor::Grid<TensorSL, subDim>& EFEGrid
+	) {
+		calc_gLLs_and_gUUs(metricPrimGrid, dt_metricPrimGrid, ws_);
+		calc_GammaULLs(ws_);
+		calc_EFE_constraint(ws_, metricPrimGrid, stressEnergyPrimGrid, EFEGrid);
+		cellsRecomputed += ws_.ctx->gridVolume;
+	}
+
+	void calc(
+		//input
+		Workspace& ws_,
+		const Tensor::Grid<MetricPrims, subDim>& metricPrimGrid,
+		const Tensor::Grid<MetricPrims, subDim>& dt_metricPrimGrid,	//first deriv
+		const Tensor::Grid<StressEnergyPrims, subDim>& stressEnergyPrimGrid,
+		//output
+		Tensor::Grid<TensorSL, subDim>& EFEGrid
+	) {
+		const Context& ctx = *ws_.ctx;
+		++evaluations;
+		if (!ctx.isStationary) {
+			calcFull(ws_, metricPrimGrid, dt_metricPrimGrid, stressEnergyPrimGrid, EFEGrid);
+			invalidate();
+			return;
+		}
+
+		int numDirty = ctx.gridVolume;
+		if (ws == &ws_ && ws_.version == wsVersion) {
+			dirty.resize(ctx.gridVolume);
+			std::vector<int> batches = getCellBatches(ctx.gridVolume);
+			std::vector<int> batchDirty(batches.size());
+			ws->parallel->foreach(batches.begin(), batches.end(), [&](int start) {
+				int count = 0;
+				for (int k = start; k < std::min(start + cellBatchWidth, ctx.gridVolume); ++k) {
+					const real* p = (const real*)&metricPrimGrid.v[k];
+					const real* q = (const real*)&prims[k];
+					dirty[k] = false;
+					for (int j = 0; j < (int)(sizeof(MetricPrims) / sizeof(real)); ++j) {
+						if (fabs(p[j] - q[j]) > tolerance || (tolerance == 0 && p[j] != q[j])) dirty[k] = true;
+					}
+					count += dirty[k];
+				}
+				batchDirty[start / cellBatchWidth] = count;
+			});
+			numDirty = 0;
+			for (int count : batchDirty) numDirty += count;
+		}
+
+		if (numDirty > maxDirtyFraction * ctx.gridVolume) {
+			calcFull(ws_, metricPrimGrid, dt_metricPrimGrid, stressEnergyPrimGrid, EFEGrid);
+			ws = &ws_;
+			wsVersion = ws_.version;
+			prims.assign(metricPrimGrid.v, metricPrimGrid.v + ctx.gridVolume);
+			EFEs.assign(EFEGrid.v, EFEGrid.v + ctx.gridVolume);
+			return;
+		}
+
+		if (numDirty > 0) {
+			int radius = getStencilRadius(ctx);
+			//g_ab, g^ab at the dirty cells
+			std::vector<int> dirtyCells;
+			affected.assign(ctx.gridVolume, false);
+			Tensor::RangeObj<subDim> range(Tensor::Vector<int,subDim>(), ctx.sizev);
+			for (const Tensor::Vector<int, subDim>& index : range) {
+				int k = index(0) + ctx.sizev(0) * (index(1) + ctx.sizev(1) * index(2));
+				if (!dirty[k]) continue;
+				dirtyCells.push_back(k);
+				for (int l = std::max(0, index(2) - radius); l <= std::min(ctx.sizev(2)-1, index(2) + radius); ++l) {
+					for (int j = std::max(0, index(1) - radius); j <= std::min(ctx.sizev(1)-1, index(1) + radius); ++j) {
+						for (int i = std::max(0, index(0) - radius); i <= std::min(ctx.sizev(0)-1, index(0) + radius); ++i) {
+							affected[i + ctx.sizev(0) * (j + ctx.sizev(1) * l)] = true;
+						}
+					}
+				}
+			}
+			ws->parallel->foreach(dirtyCells.begin(), dirtyCells.end(), [&](int k) {
+				prims[k] = metricPrimGrid.v[k];
+				calc_gLL_and_gUU(prims[k], ws->gLLs.v[k], ws->gUUs.v[k]);
+			});
+
+			//Gamma^a_bc, then EFE_ab, within radius of them
+			std::vector<Tensor::Vector<int, subDim>> affectedIndexes;
+			for (const Tensor::Vector<int, subDim>& index : range) {
+				if (affected[index(0) + ctx.sizev(0) * (index(1) + ctx.sizev(1) * index(2))]) affectedIndexes.push_back(index);
+			}
+			ws->parallel->foreach(affectedIndexes.begin(), affectedIndexes.end(), [&](const Tensor::Vector<int, subDim>& index) {
+				calc_GammaULL<true>(*ws, index);
+			});
+			dispatchEinsteinPath(ctx, [&](auto einstein, auto dGamma) {
+				ws->parallel->foreach(affectedIndexes.begin(), affectedIndexes.end(), [&](const Tensor::Vector<int, subDim>& index) {
+					int k = index(0) + ctx.sizev(0) * (index(1) + ctx.sizev(1) * index(2));
+					TensorSL EFE = calc_EinsteinLL<true, decltype(einstein)::value, decltype(dGamma)::value>(*ws, index);
+					TensorSL _8piT_LL = calc_8piTLL(ctx, prims[k], ws->gLLs.v[k], ws->gUUs.v[k], stressEnergyPrimGrid, k);
+					for (int a = 0; a < dim; ++a) {
+						for (int b = 0; b <= a; ++b) {
+							EFE(a,b) += -1 * _8piT_LL(a,b);
+						}
+					}
+					EFEs[k] = EFE;
+				});
+			});
+			cellsRecomputed += affectedIndexes.size();
+		}
+		std::copy(EFEs.begin(), EFEs.end(), EFEGrid.v);
+	}
+};
+
+/*
+solves A x = b for a small dense m x m A, stored column-major: A[i + m * j]
+Gaussian elimination with partial pivoting.  A and b are overwritten
+components along zero pivots are set to zero
+*/
+void solveDense(int m, real* A, real* b, real* x) {
+	for (int i = 0; i < m; ++i) {
+		int pivot = i;
+		for (int j = i+1; j < m; ++j) {
+			if (fabs(A[j + m * i]) > fabs(A[pivot + m * i])) pivot = j;
+		}
+		if (pivot != i) {
+			for (int j = 0; j < m; ++j) std::swap(A[i + m * j], A[pivot + m * j]);
+			std::swap(b[i], b[pivot]);
+		}
+		if (A[i + m * i] == 0) continue;
+		for (int j = i+1; j < m; ++j) {
+			real s = A[j + m * i] / A[i + m * i];
+			for (int l = i; l < m; ++l) A[j + m * l] -= s * A[i + m * l];
+			b[j] -= s * b[i];
+		}
+	}
+	for (int i = m-1; i >= 0; --i) {
+		real sum = b[i];
+		for (int j = i+1; j < m; ++j) sum -= A[i + m * j] * x[j];
+		x[i] = A[i + m * i] == 0 ? 0 : sum / A[i + m * i];
+	}
+}
+
+//AInv = A^-1 for a small dense m x m A, column-major, by solveDense() on each column of I
+void invertDense(int m, const real* A, real* AInv) {
+	std::vector<real> LU(m * m), e(m);
+	for (int j = 0; j < m; ++j) {
+		std::copy(A, A + m * m, LU.begin());
+		std::fill(e.begin(), e.end(), 0);
+		e[j] = 1;
+		solveDense(m, LU.data(), e.data(), AInv + m * j);
+	}
+}
+
+struct EFESolver {
+	Context& ctx;	//the grid, threads, workspace and flags this solves with
+	int maxiter;
+	int FEvals = 0;	//calls to calcF
+	std::shared_ptr<DirtyRegionTracker> dirtyRegions;	//if set then calcF only recomputes what changed
+	EFESolver(Context& ctx_, int maxiter_) : ctx(ctx_), maxiter(maxiter_) {}
+	size_t getN() { return sizeof(MetricPrims) / sizeof(real) * ctx.gridVolume; }
+	
+	static real dot(size_t n, const real* a, const real* b) {
+		real sum = 0;
+		for (int i = 0; i < (int)n; ++i) {
+			sum += a[i] * b[i];
+		}
+		return sum;
+	}
+
+	/*
+	y = G_ab - 8 pi T_ab at x, for solvers that work on the whole grid of MetricPrims
+	leaves g_ab, g^ab and Gamma^a_bc of x in 'ws'
+	*/
+	void calcF(
+		real* y,
+		const real* x,
+		const Tensor::Grid<MetricPrims, subDim>& dt_metricPrimGrid,	//first deriv
+		const Tensor::Grid<StressEnergyPrims, subDim>& stressEnergyPrimGrid,
+		Workspace& ws
+	) {
+		++FEvals;
+		Tensor::Grid<MetricPrims, subDim> metricPrimGrid(ws.ctx->sizev, (MetricPrims*)x);
+		Tensor::Grid<TensorSL, subDim> EFEGrid(ws.ctx->sizev, (TensorSL*)y);
+		if (dirtyRegions) {
+			dirtyRegions->calc(ws, metricPrimGrid, dt_metricPrimGrid, stressEnergyPrimGrid, EFEGrid);
+			return;
+		}
+		calc_gLLs_and_gUUs(metricPrimGrid, dt_metricPrimGrid, ws);
+		calc_GammaULLs(ws);
+		calc_EFE_constraint(ws, metricPrimGrid, stressEnergyPrimGrid, EFEGrid);
+	}
+
+	//in the context's workspace
+	void calcF(
+		real* y,
+		const real* x,
+		const Tensor::Grid<MetricPrims, subDim>& dt_metricPrimGrid,	//first deriv
+		const Tensor::Grid<StressEnergyPrims, subDim>& stressEnergyPrimGrid
+	) {
+		calcF(y, x, dt_metricPrimGrid, stressEnergyPrimGrid, *ctx.workspace);
+	}
+
+	//|G_ab - 8 pi T_ab| at metricPrimGrid, and its max
+	real calcResidual(
+		const Tensor::Grid<MetricPrims, subDim>& metricPrimGrid,
+		const Tensor::Grid<MetricPrims, subDim>& dt_metricPrimGrid,	//first deriv
+		const Tensor::Grid<StressEnergyPrims, subDim>& stressEnergyPrimGrid,
+		real* maxAbs = nullptr
+	) {
+		int n = (int)getN();
+		std::vector<real> EFEs(n);
+		calcF(EFEs.data(), (const real*)metricPrimGrid.v, dt_metricPrimGrid, stressEnergyPrimGrid);
+		if (maxAbs) {
+			*maxAbs = 0;
+			for (real EFE : EFEs) {
+				*maxAbs = std::max(*maxAbs, (real)fabs(EFE));
+			}
+		}
+		return Solver::Vector<real>::normL2(n, EFEs.data());
+	}
+
+	//prints calcResidual(), for solvers that don't iterate on it themselves
+	void printResidual(
+		const std::string& name,
+		const Tensor::Grid<MetricPrims, subDim>& metricPrimGrid,
+		const Tensor::Grid<MetricPrims, subDim>& dt_metricPrimGrid,	//first deriv
+		const Tensor::Grid<StressEnergyPrims, subDim>& stressEnergyPrimGrid
+	) {
+		real maxAbs;
+		real residual = calcResidual(metricPrimGrid, dt_metricPrimGrid, stressEnergyPrimGrid, &maxAbs);
+		std::cout << name
+			<< " residual=" << std::setprecision(16) << residual
+			<< " max=" << maxAbs << std::setprecision(6)
+			<< std::endl;
+	}
+
+	virtual void solve(
+		//input/output
+		Tensor::Grid<MetricPrims, subDim>& metricPrimGrid,
+		//input
+		const Tensor::Grid<MetricPrims, subDim>& dt_metricPrimGrid,	//first deriv
+		const Tensor::Grid<StressEnergyPrims, subDim>& stressEnergyPrimGrid
+	) = 0;
+};
+
+/*
+use a linear solver and treat G_ab = 8 pi T_ab like a linear system A x = b for x = (alpha, beta, gamma), A x = G_ab(x), and b = 8 pi T_ab ... which is also a function of x ...
 nothing appears to be moving ...
 or it's diverging ...
 looks like there's an inherent problem in all the Krylov solvers, because they're based on A^n(x), and beacuse initial-condition flat A(x) gives all zeroes for G_ab(x)
@@ -1106,18 +2128,18 @@ struct KrylovSolver : public EFESolver {
 	Tensor::Grid<TensorSL, subDim> _8piTLLs;
 	std::shared_ptr<Solver::Krylov<real>> krylov;
 
-	KrylovSolver(int maxiter)
-	: Super(maxiter)
-	, _8piTLLs(sizev)
+	KrylovSolver(Context& ctx, int maxiter)
+	: Super(ctx, maxiter)
+	, _8piTLLs(ctx.sizev)
 	{}
 
 	virtual const char* name() = 0;
 
 	/*
 	x holds a grid of MetricPrims 
-	calls calc_8piTLL() at each point on the grid
+	calls calc_8piTLL() at each non-vacuum point on the grid
 	stores results in _8piTLLs
-	depends on: calc_gLLs_and_gUUs()
+	depends on: calc_gLLs_and_gUUs(), classifyStressEnergyCells()
 	*/
 	void calc_8piTLLs(
 		//input
@@ -1126,14 +2148,11 @@ struct KrylovSolver : public EFESolver {
 		//output
 		Tensor::Grid<TensorSL, subDim>& _8piTLLs
 	) {
-		Tensor::RangeObj<subDim> range(Tensor::Vector<int,subDim>(), sizev);
-		parallel.foreach(range.begin(), range.end(), [&](const Tensor::Vector<int, subDim>& index) {
-			_8piTLLs(index) = calc_8piTLL(
-				metricPrimGrid(index), 
-				gLLs(index), 
-				gUUs(index),
-				stressEnergyPrimGrid(index));
+		Tensor::RangeObj<subDim> range(Tensor::Vector<int,subDim>(), ctx.sizev);
+		ctx.workspace->parallel->foreach(range.begin(), range.end(), [&](const Tensor::Vector<int, subDim>& index) {
+			_8piTLLs(index) = TensorSL();
 		});
+		add_8piTLLs(*ctx.workspace, metricPrimGrid, stressEnergyPrimGrid, 1, _8piTLLs);
 	}
 
 	void linearFunc(
@@ -1149,30 +2168,24 @@ for (int i = 0; i < (int)getN(); ++i) {
 }
 #endif
 
-#ifdef PRINTTIME
-		std::cout << "iteration " << jfnk.iter << std::endl;
-		time("calculating g_ab and g^ab", [&](){
-#endif				
-			Tensor::Grid<MetricPrims, subDim> metricPrimGrid(sizev, (MetricPrims*)x);
+		if (printTime) std::cout << "iteration " << krylov->getIter() << std::endl;
+		timeIfPrintTime("calculating g_ab and g^ab", [&](){
+			Tensor::Grid<MetricPrims, subDim> metricPrimGrid(ctx.sizev, (MetricPrims*)x);
 			calc_gLLs_and_gUUs(
 				//input
 				metricPrimGrid,
 				dt_metricPrimGrid,	//first deriv
 				//output
-				gLLs, gUUs, dt_gLLs);
-#ifdef PRINTTIME
+				*ctx.workspace);
 		});
-		time("calculating Gamma^a_bc", [&](){
-#endif				
-			calc_GammaULLs(gLLs, gUUs, dt_gLLs, GammaULLs);
-#ifdef PRINTTIME
+		timeIfPrintTime("calculating Gamma^a_bc", [&](){
+			calc_GammaULLs(*ctx.workspace);
 		});
-		time("calculating G_ab", [&]{
-#endif
-			Tensor::Grid<TensorSL, subDim> EinsteinLLs(sizev, (TensorSL*)y);
+		timeIfPrintTime("calculating G_ab", [&]{
+			Tensor::Grid<TensorSL, subDim> EinsteinLLs(ctx.sizev, (TensorSL*)y);
 			calc_EinsteinLLs(
 				//input
-				gLLs, gUUs, GammaULLs,
+				*ctx.workspace,
 				//output
 				EinsteinLLs);
 //debugging
@@ -1181,23 +2194,16 @@ for (int i = 0; i < (int)getN(); ++i) {
 	assert(y[i] == y[i]);
 }
 #endif
-
-#ifdef PRINTTIME
 		});
-#endif				
 
 		//here's me abusing GMRES.
 		//I'm updating the 'b' vector mid-algorithm since it is dependent on the 'x' vector
 		//maybe I shouldn't be doing so here, but instead only before every linear solver solve()?
 		//that way the 'b' vector is constant during the linear solver solve() ...
 #if 0
-#ifdef PRINTTIME
-		time("calculating T_ab", [&]{
-#endif				
-			calc_8piTLLs(Tensor::Grid<const MetricPrims, subDim>(sizev, (const MetricPrims*)x), stressEnergyPrimGrid, _8piTLLs);
-#ifdef PRINTTIME
+		timeIfPrintTime("calculating T_ab", [&]{
+			calc_8piTLLs(Tensor::Grid<const MetricPrims, subDim>(ctx.sizev, (const MetricPrims*)x), stressEnergyPrimGrid, _8piTLLs);
 		});
-#endif
 #endif
 	}
 
@@ -1213,6 +2219,11 @@ for (int i = 0; i < (int)getN(); ++i) {
 		const Tensor::Grid<MetricPrims, subDim>& dt_metricPrimGrid,	//first deriv
 		const Tensor::Grid<StressEnergyPrims, subDim>& stressEnergyPrimGrid
 	) {
+		if (ctx.useChargeCurrentForEM) {
+			time("solving for A^a", [&]{
+				update_EMFields(*ctx.workspace, metricPrimGrid, dt_metricPrimGrid, stressEnergyPrimGrid);
+			});
+		}
 		time("calculating T_ab", [&]{
 			calc_8piTLLs(metricPrimGrid, stressEnergyPrimGrid, _8piTLLs);
 		});
@@ -1304,7 +2315,11 @@ struct ConjResSolver : public KrylovSolver {
 
 struct GMRES : public Solver::GMRES<real> {
 	using Solver::GMRES<real>::GMRES;
+	
+	real lastBNormL2 = 0;	//|b| of the current solve, for the JFNK forcing terms
+	
 	virtual real calcResidual(real rNormL2, real bNormL2, const real* r) {
+		lastBNormL2 = bNormL2;
 #if 0
 		//error is 16, is sqrt(total sum of errors) which is 256, which is 4 * 64
 		// 64 is the # of grid elements, 4 is how much error per grid
@@ -1317,7 +2332,7 @@ struct GMRES : public Solver::GMRES<real> {
 			<< " real_rNormL2=" << real_rNormL2 
 			<< std::endl;
 		int e = 0;
-		Tensor::RangeObj<subDim> range(Tensor::Vector<int,subDim>(), sizev);
+		Tensor::RangeObj<subDim> range(Tensor::Vector<int,subDim>(), ctx.sizev);
 		std::for_each(range.begin(), range.end(), [&](const Tensor::Vector<int, subDim>& index) {
 			std::cout << "r[" << index << "] =";
 			for (int j = 0; j < 10; ++j, ++e) {
@@ -1331,30 +2346,253 @@ struct GMRES : public Solver::GMRES<real> {
 	}
 };
 
-struct GMRESSolver : public KrylovSolver {
-	using Super = KrylovSolver;
-	using Super::Super;
-	
-	virtual const char* name() { return "gmres"; }
+/*
+GMRES that recycles a subspace from one solve to the next, GCRO style
+keeps U, and C = A U with C orthonormal, built from the corrections of the last 'recycle' restart cycles
+each cycle runs Arnoldi on (I - C C^T) A, so it doesn't spend iterations finding those directions again after a restart
+the correction is then d = V y - U B y, for B = C^T A V, and A d = V Hbar y is the next column of C
+at the start of each solve (i.e. each Newton step) A has changed, so C = A U is rebuilt, for 'recycle' products
+this is de Sturler's GCRO with the outer corrections as the recycled space, rather than GCRO-DR's harmonic Ritz vectors
+preconditioning is flexible (FGMRES): Z = M^-1 V is kept alongside V and U lives in x space,
+so M^-1 can be an inexact solve that isn't quite linear, like the Schwarz subdomain solves
+*/
+struct RecyclingGMRES : public GMRES {
+	using Super = GMRES;
 
-	virtual std::shared_ptr<Solver::Krylov<real>> makeSolver(
-		Tensor::Grid<MetricPrims, subDim>& metricPrimGrid,
-		const Tensor::Grid<MetricPrims, subDim>& dt_metricPrimGrid	//first deriv
-	) {
-		return std::make_shared<GMRES>(
-			getN(),	//n = vector size
-			(real*)metricPrimGrid.v,		//x = state vector
-			(const real*)_8piTLLs.v,		//b = solution vector
-			[&](real* y, const real* x) { linearFunc(y, x, dt_metricPrimGrid); },	//A = linear function to solve x for A(x) = b
-			1e-100,			//epsilon
-			getN(),			//maxiter ... = n^3 ... 262144
-			100				//restart
-		);
-		//the largest allocation is restart * maxiter, which would be 100 * n^3, 
-		// for a 64^3 grid is 2,621,440,000
-		// for a 32^3 grid is 327,680,000
-	}
-};
+	int restartIter;
+	int recycle;
+	std::vector<std::vector<real>> Us, Cs;
+
+	RecyclingGMRES(size_t n, real* x, const real* b, Func A, real epsilon, int maxiter, int restartIter_, int recycle_)
+	: Super(n, x, b, A, epsilon, maxiter, restartIter_)
+	, restartIter(restartIter_)
+	, recycle(recycle_)
+	{}
+
+	virtual void solve() {
+		using Vector = Solver::Vector<real>;
+		iter = 0;
+		
+		std::vector<real> r(n), w(n);
+		auto addCorrection = [&](const std::vector<real>& d) {
+			for (int i = 0; i < (int)n; ++i) {
+				x[i] += d[i];
+			}
+		};
+		auto dot = [&](const real* u, const real* v) -> real {
+			real sum = 0;
+			for (int i = 0; i < (int)n; ++i) {
+				sum += u[i] * v[i];
+			}
+			return sum;
+		};
+		//v -= s u
+		auto axpy = [&](std::vector<real>& v, real s, const std::vector<real>& u) {
+			for (int i = 0; i < (int)n; ++i) {
+				v[i] -= s * u[i];
+			}
+		};
+		
+		A(w.data(), x);
+		for (int i = 0; i < (int)n; ++i) {
+			r[i] = b[i] - w[i];
+		}
+		real bNormL2 = Vector::normL2(n, b);
+
+		//C = A U for this A, orthonormalized, with U carried along so it stays A U
+		std::vector<std::vector<real>> newUs, newCs;
+		for (std::vector<real>& u : Us) {
+			std::vector<real> c(n);
+			A(c.data(), u.data());
+			for (int i = 0; i < (int)newCs.size(); ++i) {
+				real s = dot(newCs[i].data(), c.data());
+				axpy(c, s, newCs[i]);
+				axpy(u, s, newUs[i]);
+			}
+			real cNormL2 = Vector::normL2(n, c.data());
+			if (!(cNormL2 > 0) || !std::isfinite(cNormL2)) continue;
+			for (int i = 0; i < (int)n; ++i) {
+				c[i] /= cNormL2;
+				u[i] /= cNormL2;
+			}
+			newUs.push_back(u);
+			newCs.push_back(c);
+		}
+		Us.swap(newUs);
+		Cs.swap(newCs);
+
+		//project the residual out of C first
+		if (!Cs.empty()) {
+			std::vector<real> d(n);
+			for (int l = 0; l < (int)Cs.size(); ++l) {
+				real s = dot(Cs[l].data(), r.data());
+				axpy(d, -s, Us[l]);
+				axpy(r, s, Cs[l]);
+			}
+			addCorrection(d);
+		}
+
+		int m = restartIter;
+		std::vector<std::vector<real>> V(m+1, std::vector<real>(n));
+		std::vector<std::vector<real>> Z(MInv ? m : 0, std::vector<real>(n));
+		auto getZ = [&](int j) -> std::vector<real>& { return MInv ? Z[j] : V[j]; };
+		std::vector<real> H((m+1) * m), Hbar((m+1) * m), g(m+1), cs(m), sn(m), y(m);
+		for (;;) {
+			real rNormL2 = Vector::normL2(n, r.data());
+			residual = calcResidual(rNormL2, bNormL2, r.data());
+			if (residual < epsilon || rNormL2 == 0 || iter >= maxiter) break;
+			if (stopCallback && stopCallback()) break;
+
+			int k = (int)Cs.size();
+			std::vector<real> B(k * m);
+			for (int i = 0; i < (int)n; ++i) {
+				V[0][i] = r[i] / rNormL2;
+			}
+			std::fill(g.begin(), g.end(), 0);
+			g[0] = rNormL2;
+			
+			//Arnoldi on (I - C C^T) A, with Givens rotations tracking the residual
+			bool done = false;
+			int j = 0;
+			while (j < m && iter < maxiter) {
+				if (MInv) MInv(Z[j].data(), V[j].data());
+				A(w.data(), getZ(j).data());
+				++iter;
+				for (int l = 0; l < k; ++l) {
+					real s = dot(Cs[l].data(), w.data());
+					B[l + k * j] = s;
+					for (int i = 0; i < (int)n; ++i) {
+						w[i] -= s * Cs[l][i];
+					}
+				}
+				for (int l = 0; l <= j; ++l) {
+					real s = dot(V[l].data(), w.data());
+					H[l + (m+1) * j] = s;
+					for (int i = 0; i < (int)n; ++i) {
+						w[i] -= s * V[l][i];
+					}
+				}
+				real h = Vector::normL2(n, w.data());
+				H[j+1 + (m+1) * j] = h;
+				if (h > 0) {
+					for (int i = 0; i < (int)n; ++i) {
+						V[j+1][i] = w[i] / h;
+					}
+				}
+				for (int l = 0; l <= j+1; ++l) {
+					Hbar[l + (m+1) * j] = H[l + (m+1) * j];
+				}
+				
+				for (int l = 0; l < j; ++l) {
+					real a = H[l + (m+1) * j];
+					real c = H[l+1 + (m+1) * j];
+					H[l + (m+1) * j] = cs[l] * a + sn[l] * c;
+					H[l+1 + (m+1) * j] = -sn[l] * a + cs[l] * c;
+				}
+				real a = H[j + (m+1) * j];
+				real denom = sqrt(a * a + h * h);
+				cs[j] = denom > 0 ? a / denom : 1;
+				sn[j] = denom > 0 ? h / denom : 0;
+				H[j + (m+1) * j] = denom;
+				H[j+1 + (m+1) * j] = 0;
+				g[j+1] = -sn[j] * g[j];
+				g[j] = cs[j] * g[j];
+				++j;
+
+				residual = calcResidual(fabs(g[j]), bNormL2, r.data());
+				if (residual < epsilon || h == 0) {
+					done = true;
+					break;
+				}
+				if (stopCallback && stopCallback()) {
+					done = true;
+					break;
+				}
+			}
+			
+			//R y = g
+			for (int l = j-1; l >= 0; --l) {
+				real sum = g[l];
+				for (int i = l+1; i < j; ++i) {
+					sum -= H[l + (m+1) * i] * y[i];
+				}
+				y[l] = H[l + (m+1) * l] != 0 ? sum / H[l + (m+1) * l] : 0;
+			}
+
+			//d = Z y - U B y
+			//c = A d = V Hbar y
+			std::vector<real> d(n), c(n);
+			for (int l = 0; l < j; ++l) {
+				axpy(d, -y[l], getZ(l));
+			}
+			for (int l = 0; l < k; ++l) {
+				real By = 0;
+				for (int i = 0; i < j; ++i) {
+					By += B[l + k * i] * y[i];
+				}
+				axpy(d, By, Us[l]);
+			}
+			for (int l = 0; l <= j; ++l) {
+				real Hy = 0;
+				for (int i = std::max(0, l-1); i < j; ++i) {
+					Hy += Hbar[l + (m+1) * i] * y[i];
+				}
+				axpy(c, -Hy, V[l]);
+			}
+			addCorrection(d);
+			axpy(r, 1, c);
+
+			//the correction goes into the recycled space, scaled so |A u| = 1
+			if (recycle > 0) {
+				for (int l = 0; l < k; ++l) {
+					real s = dot(Cs[l].data(), c.data());
+					axpy(c, s, Cs[l]);
+					axpy(d, s, Us[l]);
+				}
+				real cNormL2 = Vector::normL2(n, c.data());
+				if (cNormL2 > 0 && std::isfinite(cNormL2)) {
+					for (int i = 0; i < (int)n; ++i) {
+						c[i] /= cNormL2;
+						d[i] /= cNormL2;
+					}
+					Us.push_back(d);
+					Cs.push_back(c);
+					if ((int)Cs.size() > recycle) {
+						Us.erase(Us.begin());
+						Cs.erase(Cs.begin());
+					}
+				}
+			}
+
+			if (done) break;
+		}
+	}
+};
+
+struct GMRESSolver : public KrylovSolver {
+	using Super = KrylovSolver;
+	using Super::Super;
+	
+	virtual const char* name() { return "gmres"; }
+
+	virtual std::shared_ptr<Solver::Krylov<real>> makeSolver(
+		Tensor::Grid<MetricPrims, subDim>& metricPrimGrid,
+		const Tensor::Grid<MetricPrims, subDim>& dt_metricPrimGrid	//first deriv
+	) {
+		return std::make_shared<GMRES>(
+			getN(),	//n = vector size
+			(real*)metricPrimGrid.v,		//x = state vector
+			(const real*)_8piTLLs.v,		//b = solution vector
+			[&](real* y, const real* x) { linearFunc(y, x, dt_metricPrimGrid); },	//A = linear function to solve x for A(x) = b
+			1e-100,			//epsilon
+			getN(),			//maxiter ... = n^3 ... 262144
+			100				//restart
+		);
+		//the largest allocation is restart * maxiter, which would be 100 * n^3, 
+		// for a 64^3 grid is 2,621,440,000
+		// for a 32^3 grid is 327,680,000
+	}
+};
 
 //scale input to keep solution from being zero 
 const double jfnkInputScale = 1;
@@ -1380,6 +2618,605 @@ struct JFNK : public Solver::JFNK<real> {
 		return residual;
 	}
 	size_t getN() const { return n; }
+
+	int FEvals = 0;	//JFNKSolver's F counts itself here
+	int lineSearchEvals = 0;	//F evaluations spent in the last line search
+	
+	//the line search that lineSearch_counted runs
+	real (JFNK::*lineSearchMethod)() = &JFNK::lineSearch_bisect;
+	
+	//set this as 'lineSearch' so every method gets its evaluations counted
+	real lineSearch_counted() {
+		int startFEvals = FEvals;
+		real alpha = (this->*lineSearchMethod)();
+		lineSearchEvals = FEvals - startFEvals;
+		return alpha;
+	}
+
+	/*
+	Armijo backtracking
+	accepts alpha once |F(x - alpha dx)| < (1 - 1e-4 alpha) |F(x)|
+	the first backtrack halves alpha, after that it is the minimum of the parabola through the last two residuals and |F(x)|
+	*/
+	real lineSearch_armijo() {
+		const real armijoAlpha = 1e-4;
+		real FNorm0 = Solver::Vector<real>::normL2(n, &F_of_x[0]);
+		if (FNorm0 == 0) return 0;
+		real ff0 = FNorm0 * FNorm0;
+		real alpha = maxAlpha;
+		real FNorm = residualAtTrial(alpha);
+		real alphaPrev = alpha;
+		real ffPrev = FNorm * FNorm;
+		real ffCur = ffPrev;
+		for (int i = 0; i < lineSearchMaxIter; ++i) {
+			if (FNorm < (1. - armijoAlpha * alpha) * FNorm0) break;
+			real alphaCur = alpha;
+			alpha = i == 0 ? .5 * alphaCur : parabolicStep(alphaCur, alphaPrev, ff0, ffCur, ffPrev);
+			FNorm = residualAtTrial(alpha);
+			alphaPrev = alphaCur;
+			ffPrev = ffCur;
+			ffCur = FNorm * FNorm;
+		}
+		return alpha;
+	}
+
+	/*
+	trust region on the Newton step
+	a dogleg would bend toward the Cauchy point along -J^T F, but Jacobian-free we only have J v, so the path is just the Newton leg cut off at the trust radius
+	the predicted reduction comes from the linear model: |F - alpha J dx| <= (1 - alpha) |F| + alpha |F - J dx|, and |F - J dx| is what GMRES left
+	the radius carries over from one Newton step to the next
+	*/
+	real trustRadius = 0;	//0 = start with the full Newton step
+	real lineSearch_trustRegion() {
+		real FNorm0 = Solver::Vector<real>::normL2(n, &F_of_x[0]);
+		real linearResidual = getLinearSolver()->getResidual();
+		real dxNorm = Solver::Vector<real>::normL2(n, &dx[0]);
+		if (dxNorm == 0) return 0;
+		if (trustRadius <= 0) trustRadius = maxAlpha * dxNorm;
+		real alpha = 0;
+		for (int i = 0; i < lineSearchMaxIter; ++i) {
+			alpha = std::min<real>(maxAlpha, trustRadius / dxNorm);
+			real predicted = alpha * (FNorm0 - linearResidual);
+			real actual = FNorm0 - residualAtTrial(alpha);
+			real rho = predicted > 0 ? actual / predicted : (actual > 0 ? 1 : 0);
+			if (!std::isfinite(rho) || rho < .25) {
+				trustRadius = .25 * alpha * dxNorm;
+			} else if (rho > .75 && alpha * dxNorm >= .99 * trustRadius) {
+				trustRadius *= 2;
+			}
+			if (std::isfinite(rho) && rho > 1e-4) break;
+		}
+		return alpha;
+	}
+
+	/*
+	concurrent backtracking
+	evaluates numTrials step lengths at once: maxAlpha, maxAlpha/2, maxAlpha/4, ...
+	each on its own thread with FConcurrent, which gives every trial its own workspace
+	takes the largest that passes lineSearch_armijo's test, otherwise moves on to the next numTrials halvings
+	*/
+	int numTrials = 0;
+	std::function<void(int trial, real* y, const real* x)> FConcurrent;	//set by JFNKSolver
+	real lineSearch_parallel() {
+		if (numTrials < 1 || !FConcurrent) return lineSearch_armijo();
+		const real armijoAlpha = 1e-4;
+		real FNorm0 = Solver::Vector<real>::normL2(n, &F_of_x[0]);
+		if (FNorm0 == 0) return 0;
+		std::vector<std::vector<real>> xTrials(numTrials, std::vector<real>(n));
+		std::vector<std::vector<real>> FTrials(numTrials, std::vector<real>(n));
+		std::vector<real> alphas(numTrials), FNorms(numTrials);
+		real alpha = maxAlpha;
+		real bestAlpha = 0;
+		real bestFNorm = std::numeric_limits<real>::infinity();
+		for (int evals = 0; evals < lineSearchMaxIter; evals += numTrials) {
+			std::vector<std::thread> threads;
+			for (int j = 0; j < numTrials; ++j, alpha *= .5) {
+				alphas[j] = alpha;
+				threads.emplace_back([&, j]{
+					for (int i = 0; i < (int)n; ++i) {
+						xTrials[j][i] = x[i] - alphas[j] * dx[i];
+					}
+					FConcurrent(j, FTrials[j].data(), xTrials[j].data());
+					FNorms[j] = Solver::Vector<real>::normL2(n, FTrials[j].data());
+				});
+			}
+			for (std::thread& thread : threads) {
+				thread.join();
+			}
+			FEvals += numTrials;
+			for (int j = 0; j < numTrials; ++j) {
+				if (FNorms[j] < (1. - armijoAlpha * alphas[j]) * FNorm0) return alphas[j];
+				if (FNorms[j] < bestFNorm) {
+					bestFNorm = FNorms[j];
+					bestAlpha = alphas[j];
+				}
+			}
+		}
+		return std::isfinite(bestFNorm) ? bestAlpha : alphas[numTrials-1];
+	}
+
+protected:
+	std::vector<real> xTrial, FTrial;
+
+	//|F(x - alpha dx)|
+	real residualAtTrial(real alpha) {
+		xTrial.resize(n);
+		FTrial.resize(n);
+		for (int i = 0; i < (int)n; ++i) {
+			xTrial[i] = x[i] - alpha * dx[i];
+		}
+		F(FTrial.data(), xTrial.data());
+		return Solver::Vector<real>::normL2(n, FTrial.data());
+	}
+
+	/*
+	minimum of the parabola through (0, ff0), (alphaCur, ffCur), (alphaPrev, ffPrev), for ff = |F|^2
+	kept within [.1, .5] alphaCur
+	from Kelley, "Solving Nonlinear Equations with Newton's Method"
+	*/
+	static real parabolicStep(real alphaCur, real alphaPrev, real ff0, real ffCur, real ffPrev) {
+		const real sigma0 = .1;
+		const real sigma1 = .5;
+		if (!std::isfinite(ffCur) || !std::isfinite(ffPrev)) return sigma1 * alphaCur;
+		real c2 = alphaPrev * (ffCur - ff0) - alphaCur * (ffPrev - ff0);
+		if (c2 >= 0) return sigma1 * alphaCur;
+		real c1 = alphaCur * alphaCur * (ffPrev - ff0) - alphaPrev * alphaPrev * (ffCur - ff0);
+		real alpha = -.5 * c1 / c2;
+		return std::max(sigma0 * alphaCur, std::min(sigma1 * alphaCur, alpha));
+	}
+};
+
+/*
+inexact Newton forcing terms, Eisenstat & Walker choice 2:
+eta_k = gamma (|F(x_k)| / |F(x_k-1)|)^alpha
+safeguarded by gamma eta_k-1^alpha whenever that is over .1, and capped at etaMax
+the inner GMRES stops once |F(x_k) + J dx| <= eta_k |F(x_k)|
+and gets itersPerDecade iterations for every power of 10 that eta_k asks for
+*/
+struct ForcingTerms {
+	real gamma = .9;
+	real alpha = 2;
+	real etaMax = .9;
+	int itersPerDecade = 20;
+
+	real eta = .5;	//eta_0
+	real lastFNorm = 0;
+
+	//call once at the start of each Newton step
+	void update(real FNorm) {
+		if (lastFNorm > 0) {
+			real etaSafeguard = gamma * pow(eta, alpha);
+			eta = gamma * pow(FNorm / lastFNorm, alpha);
+			if (etaSafeguard > .1) eta = std::max(eta, etaSafeguard);
+			eta = std::min(eta, etaMax);
+		}
+		lastFNorm = FNorm;
+	}
+
+	int getMaxIter(int n) const {
+		int maxiter = (int)ceil(-log10(eta) * itersPerDecade);
+		return std::max(1, std::min(n, maxiter));
+	}
+};
+
+/*
+restricted additive Schwarz, as a preconditioner for the JFNK's GMRES
+the grid is cut into boxes, subdomainsPerThread of them per thread, and each box is grown by 'overlap' cells
+M^-1 v: each box solves its own linearized EFE, J_s z_s = v_s, with the metric outside of it held at the current iterate
+	J_s w = (F_s(x + eps w) - F_s(x)) / eps, where F_s is evaluated on a workspace covering just the box plus a halo
+	the local solve is localIters of GMRES from z_s = 0
+then each box writes z_s back only to the cells it owns, so the boxes run on their own threads without locking anything
+	(summing the overlapped parts too, plain additive Schwarz, counts the overlap twice)
+the halo is getStencilRadius() cells: F at a cell reads g_ab that far out, corners included
+	so the box's edge cells, whose derivatives are clamped to the box, are never read by a solve cell
+stationary metrics only
+*/
+struct SchwarzPreconditioner {
+	const Context& ctx;	//first, the defaults below read it
+	int subdomainsPerThread = 1;
+	int overlap = 1;
+	int halo = getStencilRadius(ctx);
+	int localIters = 20;
+	real jacobianEpsilon = 1e-10;	//same as the JFNK's
+
+	int cellSize = ctx.convergeAlphaOnly ? 1 : 10;	//alphaMinusOne in, sum of EFE_ab^2 out, same as JFNKSolver
+
+	struct Subdomain {
+		Tensor::Vector<int, subDim> ownedMin, ownedMax;	//[min, max) in the grid
+		Tensor::Vector<int, subDim> boxMin, boxSizev;	//the owned cells, grown by the overlap and then the halo
+		std::vector<Tensor::Vector<int, subDim>> solveIndexes;	//box-relative.  the owned cells, grown by the overlap
+		Workspace ws;
+		Tensor::Grid<MetricPrims, subDim> metricPrimGrid, savedMetricPrimGrid;
+		std::vector<real> F0, Fw, b, z;
+		Subdomain(const Context* ctx) : ws(ctx, nullptr) {}
+	};
+	std::vector<std::shared_ptr<Subdomain>> subdomains;
+
+	const Tensor::Grid<MetricPrims, subDim>& metricPrimGrid;	//the metric that isn't in x under convergeAlphaOnly
+	const Tensor::Grid<StressEnergyPrims, subDim>& stressEnergyPrimGrid;
+	const real* x;	//the JFNK iterate
+	bool dirty = true;	//x moved since the last setup()
+
+	SchwarzPreconditioner(
+		const Context& ctx_,
+		const Tensor::Grid<MetricPrims, subDim>& metricPrimGrid_,
+		const Tensor::Grid<StressEnergyPrims, subDim>& stressEnergyPrimGrid_,
+		const real* x_)
+	: ctx(ctx_)
+	, metricPrimGrid(metricPrimGrid_)
+	, stressEnergyPrimGrid(stressEnergyPrimGrid_)
+	, x(x_)
+	{
+		if (!ctx.isStationary) throw Common::Exception() << "the schwarz preconditioner needs a stationary metric";
+
+		//split the longest axis in two until there are enough boxes
+		Tensor::Vector<int, subDim> parts(1, 1, 1);
+		for (int remaining = ctx.numThreads * subdomainsPerThread; remaining > 1; remaining /= 2) {
+			int longest = 0;
+			for (int i = 1; i < subDim; ++i) {
+				if (ctx.sizev(i) / parts(i) > ctx.sizev(longest) / parts(longest)) longest = i;
+			}
+			if (ctx.sizev(longest) / parts(longest) < 2) break;
+			parts(longest) *= 2;
+		}
+
+		size_t totalSize = 0;
+		Tensor::RangeObj<subDim> partRange(Tensor::Vector<int,subDim>(), parts);
+		for (const Tensor::Vector<int, subDim>& part : partRange) {
+			std::shared_ptr<Subdomain> sub = std::make_shared<Subdomain>(&ctx);
+			Tensor::Vector<int, subDim> solveMin, solveMax;
+			for (int i = 0; i < subDim; ++i) {
+				sub->ownedMin(i) = ctx.sizev(i) * part(i) / parts(i);
+				sub->ownedMax(i) = ctx.sizev(i) * (part(i) + 1) / parts(i);
+				solveMin(i) = std::max(0, sub->ownedMin(i) - overlap);
+				solveMax(i) = std::min(ctx.sizev(i), sub->ownedMax(i) + overlap);
+				sub->boxMin(i) = std::max(0, solveMin(i) - halo);
+				sub->boxSizev(i) = std::min(ctx.sizev(i), solveMax(i) + halo) - sub->boxMin(i);
+			}
+			Tensor::RangeObj<subDim> solveRange(solveMin - sub->boxMin, solveMax - sub->boxMin);
+			for (const Tensor::Vector<int, subDim>& index : solveRange) {
+				sub->solveIndexes.push_back(index);
+			}
+			std::string name = "schwarz.subdomains[" + std::to_string(subdomains.size()) + "]";
+			allocateWorkspace(sub->ws, name + ".ws", true, sub->boxSizev, totalSize);
+			allocateGrid(sub->metricPrimGrid, name + ".metricPrimGrid", sub->boxSizev, totalSize);
+			allocateGrid(sub->savedMetricPrimGrid, name + ".savedMetricPrimGrid", sub->boxSizev, totalSize);
+			int n = (int)sub->solveIndexes.size() * cellSize;
+			sub->F0.resize(n);
+			sub->Fw.resize(n);
+			sub->b.resize(n);
+			sub->z.resize(n);
+			subdomains.push_back(sub);
+		}
+		std::cout << "schwarz subdomains: " << parts << std::endl;
+	}
+
+	int getGlobalIndex(const Subdomain& sub, const Tensor::Vector<int, subDim>& boxIndex) const {
+		Tensor::Vector<int, subDim> index = boxIndex + sub.boxMin;
+		return index(0) + ctx.sizev(0) * (index(1) + ctx.sizev(1) * index(2));
+	}
+
+	//F at the box's solve cells, from its metricPrimGrid
+	void calcLocalF(Subdomain& sub, real* y) {
+		Tensor::RangeObj<subDim> boxRange(Tensor::Vector<int,subDim>(), sub.boxSizev);
+		for (const Tensor::Vector<int, subDim>& index : boxRange) {
+			calc_gLL_and_gUU(sub.metricPrimGrid(index), sub.ws.gLLs(index), sub.ws.gUUs(index));
+		}
+		for (const Tensor::Vector<int, subDim>& index : boxRange) {
+			calc_GammaULL<true>(sub.ws, index);
+		}
+		dispatchEinsteinPath(ctx, [&](auto einstein, auto dGamma) {
+			for (int c = 0; c < (int)sub.solveIndexes.size(); ++c) {
+				const Tensor::Vector<int, subDim>& index = sub.solveIndexes[c];
+				TensorSL EFE = calc_EinsteinLL<true, decltype(einstein)::value, decltype(dGamma)::value>(sub.ws, index)
+					- calc_8piTLL(ctx, sub.metricPrimGrid(index), sub.ws.gLLs(index), sub.ws.gUUs(index), stressEnergyPrimGrid, getGlobalIndex(sub, index));
+				if (ctx.convergeAlphaOnly) {
+					real sum = 0;
+					for (int a = 0; a < dim; ++a) {
+						for (int b = 0; b <= a; ++b) {
+							real d = EFE(a,b) * jfnkOutputScale;
+							sum += d * d;
+						}
+					}
+					y[c] = sum;
+				} else {
+					real* p = &EFE(0,0);
+					for (int j = 0; j < cellSize; ++j) {
+						y[c * cellSize + j] = p[j] * jfnkOutputScale;
+					}
+				}
+			}
+		});
+	}
+
+	//copy the box out of the current iterate and evaluate F_s(x) there
+	void setup(Subdomain& sub) {
+		Tensor::RangeObj<subDim> boxRange(Tensor::Vector<int,subDim>(), sub.boxSizev);
+		for (const Tensor::Vector<int, subDim>& index : boxRange) {
+			int k = getGlobalIndex(sub, index);
+			MetricPrims prims;
+			if (ctx.convergeAlphaOnly) {
+				prims = metricPrimGrid.v[k];
+				prims.alphaMinusOne = x[k] / jfnkInputScale;
+			} else {
+				prims = ((const MetricPrims*)x)[k];
+			}
+			sub.savedMetricPrimGrid(index) = prims;
+			sub.metricPrimGrid(index) = prims;
+		}
+		calcLocalF(sub, sub.F0.data());
+	}
+
+	//J_s w, by finite difference
+	void applyLocalJacobian(Subdomain& sub, real* y, const real* w) {
+		std::copy(sub.savedMetricPrimGrid.v, sub.savedMetricPrimGrid.v + sub.boxSizev.volume(), sub.metricPrimGrid.v);
+		for (int c = 0; c < (int)sub.solveIndexes.size(); ++c) {
+			MetricPrims& prims = sub.metricPrimGrid(sub.solveIndexes[c]);
+			if (ctx.convergeAlphaOnly) {
+				prims.alphaMinusOne += jacobianEpsilon * w[c] / jfnkInputScale;
+			} else {
+				real* p = (real*)&prims;
+				for (int j = 0; j < cellSize; ++j) {
+					p[j] += jacobianEpsilon * w[c * cellSize + j];
+				}
+			}
+		}
+		calcLocalF(sub, sub.Fw.data());
+		for (int i = 0; i < (int)sub.Fw.size(); ++i) {
+			y[i] = (sub.Fw[i] - sub.F0[i]) / jacobianEpsilon;
+		}
+	}
+
+	//y = M^-1 v
+	void apply(real* y, const real* v) {
+		bool doSetup = dirty;
+		dirty = false;
+		ctx.parallel->foreach(subdomains.begin(), subdomains.end(), [&](const std::shared_ptr<Subdomain>& sub) {
+			if (doSetup) setup(*sub);
+
+			for (int c = 0; c < (int)sub->solveIndexes.size(); ++c) {
+				int k = getGlobalIndex(*sub, sub->solveIndexes[c]);
+				for (int j = 0; j < cellSize; ++j) {
+					sub->b[c * cellSize + j] = v[k * cellSize + j];
+				}
+			}
+			std::fill(sub->z.begin(), sub->z.end(), 0);
+			RecyclingGMRES localSolver(
+				sub->z.size(), sub->z.data(), sub->b.data(),
+				[&](real* Jw, const real* w) { applyLocalJacobian(*sub, Jw, w); },
+				1e-100,	//epsilon
+				localIters,	//maxiter
+				localIters,	//restart
+				0	//recycle
+			);
+			localSolver.solve();
+
+			//only the cells this box owns
+			for (int c = 0; c < (int)sub->solveIndexes.size(); ++c) {
+				Tensor::Vector<int, subDim> index = sub->solveIndexes[c] + sub->boxMin;
+				bool owned = true;
+				for (int i = 0; i < subDim; ++i) {
+					if (index(i) < sub->ownedMin(i) || index(i) >= sub->ownedMax(i)) owned = false;
+				}
+				if (!owned) continue;
+				int k = getGlobalIndex(*sub, sub->solveIndexes[c]);
+				for (int j = 0; j < cellSize; ++j) {
+					y[k * cellSize + j] = sub->z[c * cellSize + j];
+				}
+			}
+		});
+	}
+};
+
+/*
+block sparse row matrix, over the grid's cells
+each block is blockSize x blockSize, column-major like solveDense()
+the blocks of row k are at columns cols[rowStart[k]] ... cols[rowStart[k+1]-1], sorted
+*/
+struct BlockSparseMatrix {
+	int blockSize = 0;
+	std::vector<int> rowStart, cols, diag;	//diag[k] = where column k is in row k
+	std::vector<real> values;
+
+	int getNumRows() const { return (int)rowStart.size() - 1; }
+	real* block(int e) { return values.data() + e * blockSize * blockSize; }
+	const real* block(int e) const { return values.data() + e * blockSize * blockSize; }
+
+	//y = A x
+	void multiply(Parallel::Parallel* parallel, real* y, const real* x) const {
+		int b = blockSize;
+		int numRows = getNumRows();
+		std::vector<int> batches = getCellBatches(numRows);
+		parallel->foreach(batches.begin(), batches.end(), [&](int start) {
+			for (int k = start; k < std::min(start + cellBatchWidth, numRows); ++k) {
+				real* yk = y + k * b;
+				std::fill(yk, yk + b, 0);
+				for (int e = rowStart[k]; e < rowStart[k+1]; ++e) {
+					const real* A = block(e);
+					const real* xj = x + cols[e] * b;
+					for (int j = 0; j < b; ++j) {
+						for (int i = 0; i < b; ++i) {
+							yk[i] += A[i + b * j] * xj[j];
+						}
+					}
+				}
+			}
+		});
+	}
+};
+
+/*
+block ILU(0): L U = A on A's own sparsity pattern, with unit block diagonal L
+the factors overwrite a copy of A, and the diagonal blocks of U are stored inverted
+*/
+struct BlockILU {
+	BlockSparseMatrix LU;
+
+	void factor(const BlockSparseMatrix& A) {
+		LU = A;
+		int b = LU.blockSize;
+		std::vector<real> tmp(b * b);
+		for (int i = 0; i < LU.getNumRows(); ++i) {
+			for (int e = LU.rowStart[i]; e < LU.diag[i]; ++e) {
+				int k = LU.cols[e];
+				//L_ik = A_ik U_kk^-1
+				real* Lik = LU.block(e);
+				const real* UkkInv = LU.block(LU.diag[k]);
+				std::fill(tmp.begin(), tmp.end(), 0);
+				for (int j = 0; j < b; ++j) {
+					for (int l = 0; l < b; ++l) {
+						for (int r = 0; r < b; ++r) {
+							tmp[r + b * j] += Lik[r + b * l] * UkkInv[l + b * j];
+						}
+					}
+				}
+				std::copy(tmp.begin(), tmp.end(), Lik);
+				//A_ij -= L_ik U_kj, for the j's both rows have, past k
+				int f = e + 1;
+				for (int g = LU.diag[k] + 1; g < LU.rowStart[k+1]; ++g) {
+					while (f < LU.rowStart[i+1] && LU.cols[f] < LU.cols[g]) ++f;
+					if (f == LU.rowStart[i+1]) break;
+					if (LU.cols[f] != LU.cols[g]) continue;
+					real* Aij = LU.block(f);
+					const real* Ukj = LU.block(g);
+					for (int j = 0; j < b; ++j) {
+						for (int l = 0; l < b; ++l) {
+							for (int r = 0; r < b; ++r) {
+								Aij[r + b * j] -= Lik[r + b * l] * Ukj[l + b * j];
+							}
+						}
+					}
+				}
+			}
+			real* Uii = LU.block(LU.diag[i]);
+			invertDense(b, Uii, tmp.data());
+			std::copy(tmp.begin(), tmp.end(), Uii);
+		}
+	}
+
+	//y = U^-1 L^-1 v
+	void apply(real* y, const real* v) const {
+		int b = LU.blockSize;
+		int numRows = LU.getNumRows();
+		std::vector<real> w(b);
+		std::copy(v, v + numRows * b, y);
+		for (int i = 0; i < numRows; ++i) {
+			real* yi = y + i * b;
+			for (int e = LU.rowStart[i]; e < LU.diag[i]; ++e) {
+				const real* L = LU.block(e);
+				const real* yj = y + LU.cols[e] * b;
+				for (int j = 0; j < b; ++j) {
+					for (int r = 0; r < b; ++r) {
+						yi[r] -= L[r + b * j] * yj[j];
+					}
+				}
+			}
+		}
+		for (int i = numRows-1; i >= 0; --i) {
+			real* yi = y + i * b;
+			for (int e = LU.diag[i] + 1; e < LU.rowStart[i+1]; ++e) {
+				const real* U = LU.block(e);
+				const real* yj = y + LU.cols[e] * b;
+				for (int j = 0; j < b; ++j) {
+					for (int r = 0; r < b; ++r) {
+						yi[r] -= U[r + b * j] * yj[j];
+					}
+				}
+			}
+			const real* UiiInv = LU.block(LU.diag[i]);
+			for (int r = 0; r < b; ++r) {
+				w[r] = 0;
+				for (int j = 0; j < b; ++j) {
+					w[r] += UiiInv[r + b * j] * yi[j];
+				}
+			}
+			std::copy(w.begin(), w.end(), yi);
+		}
+	}
+};
+
+/*
+the JFNK's Jacobian, assembled explicitly by coloring the grid
+F at a cell only reads x within 'radius' cells of it, corners included, for radius = getStencilRadius()
+so cells 2 radius + 1 apart along every axis touch disjoint sets of F's,
+ and one F evaluation with all of one color's cells perturbed in the same component gives all of their columns
+that makes (2 radius + 1)^3 colors times cellSize components of F evaluations, 270 for radius 1 over all 10 metric prims,
+ no matter how big the grid is
+each cell is perturbed by jacobianEpsilon (1 + |x|)
+*/
+struct ColoredJacobian {
+	const Context& ctx;	//first, the defaults below read it
+	int cellSize = ctx.convergeAlphaOnly ? 1 : 10;	//same as JFNKSolver
+	int radius = getStencilRadius(ctx);
+	real jacobianEpsilon = 1e-7;
+
+	BlockSparseMatrix J;
+	std::vector<std::vector<int>> colors;	//cell indexes of each color
+	std::vector<real> F0, Fp, xp;
+
+	ColoredJacobian(const Context& ctx_) : ctx(ctx_) {
+		int n = ctx.gridVolume * cellSize;
+		F0.resize(n);
+		Fp.resize(n);
+		xp.resize(n);
+
+		int period = 2 * radius + 1;
+		colors.resize(period * period * period);
+		J.blockSize = cellSize;
+		J.rowStart.push_back(0);
+		Tensor::RangeObj<subDim> range(Tensor::Vector<int,subDim>(), ctx.sizev);
+		for (const Tensor::Vector<int, subDim>& index : range) {
+			int k = index(0) + ctx.sizev(0) * (index(1) + ctx.sizev(1) * index(2));
+			colors[index(0) % period + period * (index(1) % period + period * (index(2) % period))].push_back(k);
+			//neighbors in increasing k
+			for (int l = std::max(0, index(2) - radius); l <= std::min(ctx.sizev(2)-1, index(2) + radius); ++l) {
+				for (int j = std::max(0, index(1) - radius); j <= std::min(ctx.sizev(1)-1, index(1) + radius); ++j) {
+					for (int i = std::max(0, index(0) - radius); i <= std::min(ctx.sizev(0)-1, index(0) + radius); ++i) {
+						int m = i + ctx.sizev(0) * (j + ctx.sizev(1) * l);
+						if (m == k) J.diag.push_back((int)J.cols.size());
+						J.cols.push_back(m);
+					}
+				}
+			}
+			J.rowStart.push_back((int)J.cols.size());
+		}
+		J.values.resize(J.cols.size() * cellSize * cellSize);
+		std::cout << "colored jacobian: " << J.cols.size() << " blocks of " << cellSize << "x" << cellSize 
+			<< ", " << colors.size() * cellSize << " F evaluations per assembly" << std::endl;
+	}
+
+	//returns the number of F evaluations
+	int assemble(std::function<void(real* y, const real* x)> F, const real* x) {
+		int n = ctx.gridVolume * cellSize;
+		int b = cellSize;
+		F(F0.data(), x);
+		int FEvals = 1;
+		for (const std::vector<int>& color : colors) {
+			if (color.empty()) continue;
+			for (int j = 0; j < b; ++j) {
+				std::copy(x, x + n, xp.begin());
+				for (int k : color) {
+					xp[k * b + j] += jacobianEpsilon * (1 + fabs(x[k * b + j]));
+				}
+				F(Fp.data(), xp.data());
+				++FEvals;
+				//column j of block (m,k) for every cell m that reads cell k
+				ctx.parallel->foreach(color.begin(), color.end(), [&](int k) {
+					real eps = xp[k * b + j] - x[k * b + j];
+					for (int e = J.rowStart[k]; e < J.rowStart[k+1]; ++e) {
+						int m = J.cols[e];
+						//the pattern is symmetric, so block (m,k) is in row m where row k has m
+						int f = std::lower_bound(J.cols.begin() + J.rowStart[m], J.cols.begin() + J.rowStart[m+1], k) - J.cols.begin();
+						real* Jmk = J.block(f);
+						for (int r = 0; r < b; ++r) {
+							Jmk[r + b * j] = (Fp[m * b + r] - F0[m * b + r]) / eps;
+						}
+					}
+				});
+			}
+		}
+		return FEvals;
+	}
 };
 
 //use JFNK
@@ -1389,10 +3226,45 @@ struct JFNKSolver : public EFESolver {
 
 	Tensor::Grid<TensorSL, subDim> EFEGrid;	
 
-	JFNKSolver(int maxiter)
-	: Super(maxiter)
-	, EFEGrid(sizev)
+	real (JFNK::*lineSearchMethod)();
+	int gmresRecycle;	//0 = plain GMRES, otherwise RecyclingGMRES with this many recycled vectors
+	std::string preconditionerName;	//none, schwarz, ilu
+	std::string jacobianName;	//matrixfree, colored
+	int jacobianReuse;	//Newton steps between assemblies of the colored Jacobian
+
+	JFNKSolver(Context& ctx, int maxiter, std::string lineSearchName, int gmresRecycle_, std::string preconditionerName_, std::string jacobianName_, int jacobianReuse_)
+	: Super(ctx, maxiter)
+	, EFEGrid(ctx.sizev)
+	, lineSearchMethod(nullptr)
+	, gmresRecycle(gmresRecycle_)
+	, preconditionerName(preconditionerName_)
+	, jacobianName(jacobianName_)
+	, jacobianReuse(jacobianReuse_)
 	{
+		struct {
+			const char* name;
+			real (JFNK::*method)();
+		} lineSearches[] = {
+			{"none", &JFNK::lineSearch_none},
+			{"bisect", &JFNK::lineSearch_bisect},
+			{"armijo", &JFNK::lineSearch_armijo},
+			{"trust_region", &JFNK::lineSearch_trustRegion},
+			{"parallel", &JFNK::lineSearch_parallel},
+		}, *p;
+		for (p = lineSearches; p < endof(lineSearches); ++p) {
+			if (p->name == lineSearchName) {
+				lineSearchMethod = p->method;
+			}
+		}
+		if (!lineSearchMethod) {
+			throw Common::Exception() << "couldn't find line search named " << lineSearchName;
+		}
+		if (preconditionerName != "none" && preconditionerName != "schwarz" && preconditionerName != "ilu") {
+			throw Common::Exception() << "couldn't find preconditioner named " << preconditionerName;
+		}
+		if (jacobianName != "matrixfree" && jacobianName != "colored") {
+			throw Common::Exception() << "couldn't find jacobian named " << jacobianName;
+		}
 	}
 
 	virtual void solve(
@@ -1404,74 +3276,59 @@ struct JFNKSolver : public EFESolver {
 	) {
 	
 		std::ofstream jfnkFile("jfnk.txt");
-		jfnkFile << "#iter residual alpha" << std::endl;
+		jfnkFile << "#iter residual alpha eta gmres_iters line_search_evals" << std::endl;
 	
 		std::ofstream gmresFile("gmres.txt");
-		gmresFile << "#jfnk_iter gmres_iter residual" << std::endl;
+		gmresFile << "#jfnk_iter gmres_iter residual eta" << std::endl;
 		
 		assert(sizeof(MetricPrims) == sizeof(EFEGrid.v[0]));	//this should be 10 real numbers and nothing else
 		
-#ifdef CONVERGE_ALPHA_ONLY
-		std::vector<real> alphaMinusOnes(gridVolume);
-		for (int i = 0; i < gridVolume; ++i) {
-			alphaMinusOnes[i] = metricPrimGrid.v[i].alphaMinusOne;
-			//scale up alphas before feeding them to the EFE constraint, so they are further from zero
-			alphaMinusOnes[i] *= jfnkInputScale;
+		std::vector<real> alphaMinusOnes;
+		if (ctx.convergeAlphaOnly) {
+			alphaMinusOnes.resize(ctx.gridVolume);
+			for (int i = 0; i < ctx.gridVolume; ++i) {
+				alphaMinusOnes[i] = metricPrimGrid.v[i].alphaMinusOne;
+				//scale up alphas before feeding them to the EFE constraint, so they are further from zero
+				alphaMinusOnes[i] *= jfnkInputScale;
+			}
 		}
-#endif
+		//the state vector: the alphas, or the whole metric
+		size_t n = ctx.convergeAlphaOnly ? (size_t)ctx.gridVolume : getN();
+		real* x0 = ctx.convergeAlphaOnly ? alphaMinusOnes.data() : (real*)metricPrimGrid.v;
 		
-		const int gmresRestart = 100;
-		JFNK jfnk(
-#ifdef CONVERGE_ALPHA_ONLY
-			gridVolume,	//n = vector size
-			alphaMinusOnes.data(),	//x = state vector
-#else
-			getN(),	//n = vector size
-			(real*)metricPrimGrid.v,	//x = state vector
-#endif			
-			[&](real* y, const real* x) {	//A = vector function to minimize
-
-#ifdef CONVERGE_ALPHA_ONLY
-				//Tensor::Grid<MetricPrims, subDim> metricPrimGrid(sizev);
-				for (int k = 0; k < gridVolume; ++k) {
+		//F(x) = G_ab - 8 pi T_ab, computed on 'ws', through 'tracker' if there is one
+		//under convergeAlphaOnly the alphas of x are written into xMetricPrimGrid, which holds the rest of the metric
+		auto calcF = [&](Workspace& ws, Tensor::Grid<MetricPrims, subDim>& xMetricPrimGrid, DirtyRegionTracker* tracker, real* y, const real* x) {
+			Tensor::Grid<MetricPrims, subDim> metricPrimGrid(ctx.sizev, ctx.convergeAlphaOnly ? xMetricPrimGrid.v : (MetricPrims*)x);
+			if (ctx.convergeAlphaOnly) {
+				for (int k = 0; k < ctx.gridVolume; ++k) {
 					metricPrimGrid.v[k].alphaMinusOne = x[k];
 					//scale alphaMinusOne's back down now that we're inside the linear function 
 					metricPrimGrid.v[k].alphaMinusOne /= jfnkInputScale;
 				}
-#else
-				Tensor::Grid<MetricPrims, subDim> metricPrimGrid(sizev, (MetricPrims*)x); 
-#endif
+			}
 
-#ifdef PRINTTIME
-				std::cout << "iteration " << jfnk.iter << std::endl;
-				time("calculating g_ab and g^ab", [&](){
-#endif			
-				//g_ab = [-1/alpha^2, beta^i/alpha, gamma_ij]
-				//g^ab = inv(g_ab)
-				calc_gLLs_and_gUUs(
-					//input:
-					metricPrimGrid,
-					dt_metricPrimGrid,	//first deriv
-					//output:
-					gLLs, gUUs, dt_gLLs);
-#ifdef PRINTTIME
+			//under convergeAlphaOnly y only holds one real per cell, so the EFE gets its own
+			Tensor::Grid<TensorSL, subDim> EFEGrid(ctx.sizev, ctx.convergeAlphaOnly ? nullptr : (TensorSL*)y);
+			if (tracker) {
+				tracker->calc(ws, metricPrimGrid, dt_metricPrimGrid, stressEnergyPrimGrid, EFEGrid);
+			} else {
+				timeIfPrintTime("calculating g_ab and g^ab", [&](){
+					//g_ab = [-1/alpha^2, beta^i/alpha, gamma_ij]
+					//g^ab = inv(g_ab)
+					calc_gLLs_and_gUUs(
+						//input:
+						metricPrimGrid,
+						dt_metricPrimGrid,	//first deriv
+						//output:
+						ws);
 				});
-#endif
 
-#ifdef PRINTTIME
-				time("calculating Gamma^a_bc", [&](){
-#endif			
-				//Gamma^a_bc = 1/2 g^ad (g_db,c + g_dc,b - g_bc,d)
-				calc_GammaULLs(gLLs, gUUs, dt_gLLs, GammaULLs);
-#ifdef PRINTTIME
+				timeIfPrintTime("calculating Gamma^a_bc", [&](){
+					//Gamma^a_bc = 1/2 g^ad (g_db,c + g_dc,b - g_bc,d)
+					calc_GammaULLs(ws);
 				});
-#endif
 
-#ifdef CONVERGE_ALPHA_ONLY
-				Tensor::Grid<TensorSL, subDim> EFEGrid(sizev);
-#else				
-				Tensor::Grid<TensorSL, subDim> EFEGrid(sizev, (TensorSL*)y);
-#endif			
 				//EFE_ab = G_ab - 8 pi T_ab
 				//T_ab = stress energy constraint, whose calculations depend on g_ab and the stress-energy primitives 
 				//G_ab = R_ab - 1/2 R g_ab
@@ -1479,30 +3336,28 @@ struct JFNKSolver : public EFESolver {
 				//R_ab = R^c_acb = (pick a more optimized implementation)
 				//R^c_acb = Gamma^c_ab,c - Gamma^c_ac,b + Gamma^c_dc Gamma^d_ab - Gamma^c_db Gamma^d_ac
 
-#ifdef PRINTTIME
-				time("calculating G_ab = 8 pi T_ab", [&]{
-#endif
-				calc_EFE_constraint(
-					metricPrimGrid,
-					stressEnergyPrimGrid,
-					EFEGrid);
-#ifdef PRINTTIME
+				timeIfPrintTime("calculating G_ab = 8 pi T_ab", [&]{
+					calc_EFE_constraint(
+						ws,
+						metricPrimGrid,
+						stressEnergyPrimGrid,
+						EFEGrid);
 				});
-#endif
+			}
 
 //scale up the EFE constraint here, so the residual gets a better value
 #if 1
-				for (int k = 0; k < gridVolume; ++k) {
-					for (int a = 0; a < dim; ++a) {
-						for (int b = 0; b <= a; ++b) {
-							EFEGrid.v[k](a,b) *= jfnkOutputScale;
-						}
+			for (int k = 0; k < ctx.gridVolume; ++k) {
+				for (int a = 0; a < dim; ++a) {
+					for (int b = 0; b <= a; ++b) {
+						EFEGrid.v[k](a,b) *= jfnkOutputScale;
 					}
 				}
+			}
 #endif
 
-#ifdef CONVERGE_ALPHA_ONLY
-				for (int k = 0; k < gridVolume; ++k) {
+			if (ctx.convergeAlphaOnly) {
+				for (int k = 0; k < ctx.gridVolume; ++k) {
 					real sum = 0;
 					for (int a = 0; a < dim; ++a) {
 						for (int b = 0; b <= a; ++b) {
@@ -1512,18 +3367,18 @@ struct JFNKSolver : public EFESolver {
 					}
 					y[k] = sum;
 				}
-#endif
+			}
 
 #if 0 //debug output
 std::cout << "efe constraint" << std::endl;
-for (int i = 0; i < gridVolume*10; ++i) {
+for (int i = 0; i < ctx.gridVolume*10; ++i) {
 	std::cout << " " << y[i];
 }
 std::cout << std::endl;
 //this is happening after the first gmres iteration, but I don't think it should ...
 std::cout << "got jfnk residual == 0" << std::endl;
 int e = 0;
-Tensor::RangeObj<subDim> range(Tensor::Vector<int,subDim>(), sizev);
+Tensor::RangeObj<subDim> range(Tensor::Vector<int,subDim>(), ctx.sizev);
 std::for_each(range.begin(), range.end(), [&](const Tensor::Vector<int, subDim>& index) {
 	std::cout << "index=" << index;
 	std::cout << " metricPrims=";
@@ -1532,14 +3387,14 @@ std::for_each(range.begin(), range.end(), [&](const Tensor::Vector<int, subDim>&
 	}
 	
 	std::cout << " G_ab=";
-	TensorSL EinsteinLL = calc_EinsteinLL(index, gLLs, gUUs, GammaULLs);
+	TensorSL EinsteinLL = calc_EinsteinLL(ws, index);
 	real* p = &EinsteinLL(0,0);
 	for (int j = 0; j < 10; ++j, ++p) {
 		std::cout << " " << *p;
 	}
 
 	std::cout << " 8piT_ab=";
-	TensorSL _8piT_LL = calc_8piTLL(Tensor::Grid<MetricPrims, subDim>(sizev, (const MetricPrims*)x)(index), gLLs(index), stressEnergyPrimGrid(index));
+	TensorSL _8piT_LL = calc_8piTLL(ctx, Tensor::Grid<MetricPrims, subDim>(ctx.sizev, (const MetricPrims*)x)(index), ws.gLLs(index), ws.gUUs(index), stressEnergyPrimGrid, index(0) + ctx.sizev(0) * (index(1) + ctx.sizev(1) * index(2)));
 	for (int a = 0; a < dim; ++a) {
 		for (int b = 0; b <= a; ++b) {
 			std::cout << " " << _8piT_LL(a,b);
@@ -1549,89 +3404,197 @@ std::for_each(range.begin(), range.end(), [&](const Tensor::Vector<int, subDim>&
 	std::cout << std::endl;
 });
 #endif	//debug output
-			},
-			1e-100, 				//newton stop epsilon
-			maxiter, 			//newton max iter
-			[&](size_t n, real* x, real* b, JFNK::Func A) -> std::shared_ptr<Solver::Krylov<real>> {
-				return std::make_shared<GMRES>(
-					n, x, b, A,
-					1e-100,	 				//gmres stop epsilon
-					n, //n*10,				//gmres max iter
-					gmresRestart			//gmres restart iter
+		};
+
+		std::shared_ptr<SchwarzPreconditioner> schwarz;
+		if (preconditionerName == "schwarz") {
+			schwarz = std::make_shared<SchwarzPreconditioner>(
+				ctx,
+				metricPrimGrid,
+				stressEnergyPrimGrid,
+				x0);
+		}
+
+		//the explicit Jacobian, for jacobian = 'colored' and the ILU(0) preconditioner
+		std::shared_ptr<ColoredJacobian> coloredJacobian;
+		BlockILU ilu;
+		bool jacobianAssembled = false;
+		int stepsSinceJacobian = 0;	//Newton steps
+		if (jacobianName == "colored" || preconditionerName == "ilu") {
+			coloredJacobian = std::make_shared<ColoredJacobian>(ctx);
+		}
+		//reassemble once the last one is jacobianReuse Newton steps old
+		auto updateJacobian = [&]{
+			if (jacobianAssembled && stepsSinceJacobian < jacobianReuse) return;
+			jacobianAssembled = true;
+			stepsSinceJacobian = 0;
+			time("assembling the jacobian", [&]{
+				FEvals += coloredJacobian->assemble(
+					[&](real* y, const real* x) { calcF(*ctx.workspace, metricPrimGrid, dirtyRegions.get(), y, x); },
+					x0);
+			});
+			if (preconditionerName == "ilu") {
+				time("factoring block ILU(0)", [&]{
+					ilu.factor(coloredJacobian->J);
+				});
+			}
+		};
+
+		const int gmresRestart = 100;
+		JFNK jfnk(
+			n,	//n = vector size
+			x0,	//x = state vector
+			[&](real* y, const real* x) {	//A = vector function to minimize
+				++jfnk.FEvals;
+				if (printTime) std::cout << "iteration " << jfnk.getIter() << std::endl;
+				calcF(*ctx.workspace, metricPrimGrid, dirtyRegions.get(), y, x);
+			},
+			1e-100, 				//newton stop epsilon
+			maxiter, 			//newton max iter
+			[&](size_t n, real* x, real* b, JFNK::Func A) -> std::shared_ptr<Solver::Krylov<real>> {
+				//sparse products with the assembled Jacobian instead of an F evaluation each
+				if (jacobianName == "colored") {
+					A = [&](real* y, const real* x) {
+						updateJacobian();
+						coloredJacobian->J.multiply(ctx.parallel, y, x);
+					};
+				}
+				//the Schwarz subdomain solves aren't quite linear, so they need RecyclingGMRES's flexible preconditioning
+				if (gmresRecycle > 0 || schwarz) {
+					return std::make_shared<RecyclingGMRES>(
+						n, x, b, A,
+						1e-100,	 				//gmres stop epsilon ... the forcing terms stop it sooner
+						n, 						//gmres max iter ... ditto
+						gmresRestart,			//gmres restart iter
+						gmresRecycle			//recycled subspace size
+					);
+				}
+				return std::make_shared<GMRES>(
+					n, x, b, A,
+					1e-100,	 				//gmres stop epsilon ... the forcing terms stop it sooner
+					n, //n*10,				//gmres max iter ... ditto
+					gmresRestart			//gmres restart iter
 				);
 			}
 		);
 		jfnk.jacobianEpsilon = 1e-10;
 		jfnk.maxAlpha = 1;
-		//jfnk.lineSearch = &JFNK::lineSearch_none;
-		jfnk.lineSearch = &JFNK::lineSearch_bisect;
-#ifdef CONVERGE_ALPHA_ONLY	
-		jfnk.lineSearchMaxIter = 50;
-#else
-		jfnk.lineSearchMaxIter = 20;
-#endif
-		jfnk.stopCallback = [&]()->bool{
-			
-#ifdef PRINT_RANGES
-			TensorSL gLL_mins, gLL_maxs;
-			TensorSU gUU_mins, gUU_maxs;
-			TensorUSL GammaULL_mins, GammaULL_maxs;
-			TensorSL EFE_mins, EFE_maxs;
-			//TODO store EinsteinLL and _8piT_LL so I can see ranges on those too
-			for (int a = 0; a < dim; ++a) {
-				for (int b = 0; b <= a; ++b) {
-					gLL_maxs(a,b) = -(gLL_mins(a,b) = std::numeric_limits<real>::infinity());
-					gUU_maxs(a,b) = -(gUU_mins(a,b) = std::numeric_limits<real>::infinity());
-					EFE_maxs(a,b) = -(EFE_mins(a,b) = std::numeric_limits<real>::infinity());
+		//count the evaluations of whichever line search config.lua picked
+		jfnk.lineSearchMethod = lineSearchMethod;
+		jfnk.lineSearch = static_cast<real (Solver::JFNK<real>::*)()>(&JFNK::lineSearch_counted);
+		
+		//lineSearch_parallel's trials each get their own workspace and threads, so they don't share scratch
+		//nor a dirty region tracker, whose snapshot is of one workspace
+		struct LineSearchTrial {
+			Parallel::Parallel parallel;
+			Workspace ws;
+			Tensor::Grid<MetricPrims, subDim> metricPrimGrid;	//only used under convergeAlphaOnly
+			std::shared_ptr<DirtyRegionTracker> dirtyRegions;
+			LineSearchTrial(const Context* ctx, int numThreads) : parallel(numThreads), ws(ctx, &parallel) {}
+		};
+		std::vector<std::shared_ptr<LineSearchTrial>> lineSearchTrials;
+		if (lineSearchMethod == &JFNK::lineSearch_parallel) {
+			size_t totalSize = 0;
+			for (int j = 0; j < numLineSearchTrials; ++j) {
+				std::shared_ptr<LineSearchTrial> trial = std::make_shared<LineSearchTrial>(&ctx, std::max(1, ctx.numThreads / numLineSearchTrials));
+				allocateWorkspace(trial->ws, "lineSearchTrials[" + std::to_string(j) + "].ws", ctx.isStationary, ctx.sizev, totalSize);
+				if (ctx.convergeAlphaOnly) {
+					allocateGrid(trial->metricPrimGrid, "lineSearchTrials[" + std::to_string(j) + "].metricPrimGrid", ctx.sizev, totalSize);
+					std::copy(metricPrimGrid.v, metricPrimGrid.v + ctx.gridVolume, trial->metricPrimGrid.v);
 				}
+				if (dirtyRegions) {
+					trial->dirtyRegions = std::make_shared<DirtyRegionTracker>(dirtyRegions->tolerance);
+				}
+				lineSearchTrials.push_back(trial);
 			}
-			for (int a = 0; a < dim; ++a) {
-				for (int b = 0; b < dim; ++b) {
-					for (int c = 0; c <= b; ++c) {
-						GammaULL_maxs(a,b,c) = -(GammaULL_mins(a,b,c) = std::numeric_limits<real>::infinity());
-					}
+			jfnk.numTrials = numLineSearchTrials;
+			jfnk.FConcurrent = [&](int j, real* y, const real* x) {
+				calcF(lineSearchTrials[j]->ws, lineSearchTrials[j]->metricPrimGrid, lineSearchTrials[j]->dirtyRegions.get(), y, x);
+			};
+		}
+		jfnk.lineSearchMaxIter = ctx.convergeAlphaOnly ? 50 : 20;
+		//inner GMRES tolerance and budget per Newton step
+		ForcingTerms forcing;
+		int forcingJFNKIter = -1;	//the Newton step 'forcing.eta' was picked for
+		int gmresIters = 0;	//inner iterations of that step
+
+		//A^a is solved once per Newton iteration, with the metric of the current iterate
+		auto updateEMFields = [&]{
+			if (ctx.convergeAlphaOnly) {
+				for (int k = 0; k < ctx.gridVolume; ++k) {
+					metricPrimGrid.v[k].alphaMinusOne = alphaMinusOnes[k] / jfnkInputScale;
 				}
 			}
-			for (int k = 0; k < gridVolume; ++k) {
+			time("solving for A^a", [&]{
+				update_EMFields(*ctx.workspace, metricPrimGrid, dt_metricPrimGrid, stressEnergyPrimGrid);
+			});
+			//the trials' EFEs were of the old E & B
+			for (std::shared_ptr<LineSearchTrial>& trial : lineSearchTrials) {
+				if (trial->dirtyRegions) trial->dirtyRegions->invalidate();
+			}
+		};
+		jfnk.stopCallback = [&]()->bool{
+			
+			if (printRanges) {
+				TensorSL gLL_mins, gLL_maxs;
+				TensorSU gUU_mins, gUU_maxs;
+				TensorUSL GammaULL_mins, GammaULL_maxs;
+				TensorSL EFE_mins, EFE_maxs;
+				//TODO store EinsteinLL and _8piT_LL so I can see ranges on those too
 				for (int a = 0; a < dim; ++a) {
 					for (int b = 0; b <= a; ++b) {
-						real d = gLLs.v[k](a,b);
-						gLL_mins(a,b) = std::min(gLL_mins(a,b), d);
-						gLL_maxs(a,b) = std::max(gLL_maxs(a,b), d);
-						
-						d = gUUs.v[k](a,b);
-						gUU_mins(a,b) = std::min(gUU_mins(a,b), d);
-						gUU_maxs(a,b) = std::max(gUU_maxs(a,b), d);
-						
-						d = EFEGrid.v[k](a,b);
-						EFE_mins(a,b) = std::min(EFE_mins(a,b), d);
-						EFE_maxs(a,b) = std::max(EFE_maxs(a,b), d);
+						gLL_maxs(a,b) = -(gLL_mins(a,b) = std::numeric_limits<real>::infinity());
+						gUU_maxs(a,b) = -(gUU_mins(a,b) = std::numeric_limits<real>::infinity());
+						EFE_maxs(a,b) = -(EFE_mins(a,b) = std::numeric_limits<real>::infinity());
 					}
 				}
 				for (int a = 0; a < dim; ++a) {
 					for (int b = 0; b < dim; ++b) {
 						for (int c = 0; c <= b; ++c) {
-							real d = GammaULLs.v[k](a,b,c);
-							GammaULL_mins(a,b,c) = std::min(GammaULL_mins(a,b,c), d);
-							GammaULL_maxs(a,b,c) = std::max(GammaULL_maxs(a,b,c), d);
+							GammaULL_maxs(a,b,c) = -(GammaULL_mins(a,b,c) = std::numeric_limits<real>::infinity());
 						}
 					}
 				}
-			}
-			std::cout << "gLL range: " << std::endl;
-			std::cout << " mins " << gLL_mins << std::endl;
-			std::cout << " maxs " << gLL_maxs << std::endl;
-			std::cout << "gUU range: " << std::endl;
-			std::cout << " mins " << gUU_mins << std::endl;
-			std::cout << " maxs " << gUU_maxs << std::endl;
-			std::cout << "GammaULL range: " << std::endl;
-			std::cout << " mins " << GammaULL_mins << std::endl;
-			std::cout << " maxs " << GammaULL_maxs << std::endl;
-			std::cout << "EFE range: " << std::endl;
-			std::cout << " mins " << EFE_mins << std::endl;
-			std::cout << " maxs " << EFE_maxs << std::endl;
+				for (int k = 0; k < ctx.gridVolume; ++k) {
+					for (int a = 0; a < dim; ++a) {
+						for (int b = 0; b <= a; ++b) {
+							real d = ctx.workspace->gLLs.v[k](a,b);
+							gLL_mins(a,b) = std::min(gLL_mins(a,b), d);
+							gLL_maxs(a,b) = std::max(gLL_maxs(a,b), d);
+						
+							d = ctx.workspace->gUUs.v[k](a,b);
+							gUU_mins(a,b) = std::min(gUU_mins(a,b), d);
+							gUU_maxs(a,b) = std::max(gUU_maxs(a,b), d);
+						
+							d = EFEGrid.v[k](a,b);
+							EFE_mins(a,b) = std::min(EFE_mins(a,b), d);
+							EFE_maxs(a,b) = std::max(EFE_maxs(a,b), d);
+						}
+					}
+					for (int a = 0; a < dim; ++a) {
+						for (int b = 0; b < dim; ++b) {
+							for (int c = 0; c <= b; ++c) {
+								real d = ctx.workspace->GammaULLs.v[k](a,b,c);
+								GammaULL_mins(a,b,c) = std::min(GammaULL_mins(a,b,c), d);
+								GammaULL_maxs(a,b,c) = std::max(GammaULL_maxs(a,b,c), d);
+							}
+						}
+					}
+				}
+				std::cout << "gLL range: " << std::endl;
+				std::cout << " mins " << gLL_mins << std::endl;
+				std::cout << " maxs " << gLL_maxs << std::endl;
+				std::cout << "gUU range: " << std::endl;
+				std::cout << " mins " << gUU_mins << std::endl;
+				std::cout << " maxs " << gUU_maxs << std::endl;
+				std::cout << "GammaULL range: " << std::endl;
+				std::cout << " mins " << GammaULL_mins << std::endl;
+				std::cout << " maxs " << GammaULL_maxs << std::endl;
+				std::cout << "EFE range: " << std::endl;
+				std::cout << " mins " << EFE_mins << std::endl;
+				std::cout << " maxs " << EFE_maxs << std::endl;
 	
-#endif
+			}
 
 			
 			std::cout << "jfnk iter=" << jfnk.getIter() 
@@ -1642,14 +3605,34 @@ std::for_each(range.begin(), range.end(), [&](const Tensor::Vector<int, subDim>&
 			jfnkFile << jfnk.getIter() 
 				<< "\t" << std::setprecision(16) << jfnk.getResidual() << std::setprecision(6)
 				<< "\t" << std::setprecision(49) << jfnk.getAlpha() << std::setprecision(6)
+				<< "\t" << forcing.eta
+				<< "\t" << gmresIters
+				<< "\t" << jfnk.lineSearchEvals
 				<< std::endl;
 			gmresFile << std::endl;
+
+			if (ctx.useChargeCurrentForEM) {
+				updateEMFields();
+			}
+			if (schwarz) schwarz->dirty = true;
+			++stepsSinceJacobian;
 			
 			return false;
 		};
 		std::shared_ptr<GMRES> gmres = std::dynamic_pointer_cast<GMRES>(jfnk.getLinearSolver());
 		real lastResidual;
 		gmres->stopCallback = [&]()->bool{
+			//first inner iteration of a new Newton step?  then pick its forcing term from |F(x_k)|
+			if (jfnk.getIter() != forcingJFNKIter) {
+				forcingJFNKIter = jfnk.getIter();
+				forcing.update(gmres->lastBNormL2);
+				std::cout << "jfnk iter=" << jfnk.getIter() 
+					<< " forcing eta=" << forcing.eta
+					<< " gmres maxiter=" << forcing.getMaxIter(jfnk.getN())
+					<< std::endl;
+			}
+			gmresIters = gmres->getIter();
+
 			if (gmres->getIter() > (int)jfnk.getN()) {
 				if (gmres->getResidual() == lastResidual) {
 					std::cout << "gmres stuck -- aborting gmres" << std::endl;
@@ -1672,8 +3655,12 @@ std::for_each(range.begin(), range.end(), [&](const Tensor::Vector<int, subDim>&
 			gmresFile << jfnk.getIter()
 				<< "\t" << gmres->getIter()
 				<< "\t" << std::setprecision(16) << gmres->getResidual() << std::setprecision(6)
+				<< "\t" << forcing.eta
 				<< std::endl;
 
+			//inexact Newton: good enough for this step's forcing term, or out of budget
+			if (gmres->getResidual() <= forcing.eta * gmres->lastBNormL2) return true;
+			if (gmres->getIter() >= forcing.getMaxIter(jfnk.getN())) return true;
 			
 			return false;
 		};
@@ -1685,207 +3672,2119 @@ std::for_each(range.begin(), range.end(), [&](const Tensor::Vector<int, subDim>&
 			}
 		};
 #endif
+		if (preconditionerName == "ilu") {
+			gmres->MInv = [&](real* y, const real* x) {
+				updateJacobian();
+				ilu.apply(y, x);
+			};
+		}
+		if (schwarz) {
+			schwarz->jacobianEpsilon = jfnk.jacobianEpsilon;
+			gmres->MInv = [&](real* y, const real* x) {
+				schwarz->apply(y, x);
+			};
+		}
+		if (ctx.useChargeCurrentForEM) {
+			updateEMFields();
+		}
 		time("solving", [&](){
 			jfnk.solve();
 		});
+		FEvals += jfnk.FEvals;
 
-#ifdef CONVERGE_ALPHA_ONLY
-		for (int i = 0; i < gridVolume; ++i) {
-			metricPrimGrid.v[i].alphaMinusOne = alphaMinusOnes[i];
-			//scale back down the alphaMinusOnes now that we're done solving
-			metricPrimGrid.v[i].alphaMinusOne /= jfnkInputScale;
+		//count the trials' evaluations with the rest
+		for (std::shared_ptr<LineSearchTrial>& trial : lineSearchTrials) {
+			if (!trial->dirtyRegions) continue;
+			dirtyRegions->evaluations += trial->dirtyRegions->evaluations;
+			dirtyRegions->cellsRecomputed += trial->dirtyRegions->cellsRecomputed;
+		}
+
+		if (ctx.convergeAlphaOnly) {
+			for (int i = 0; i < ctx.gridVolume; ++i) {
+				metricPrimGrid.v[i].alphaMinusOne = alphaMinusOnes[i];
+				//scale back down the alphaMinusOnes now that we're done solving
+				metricPrimGrid.v[i].alphaMinusOne /= jfnkInputScale;
+			}
 		}
-#endif
 
 		jfnkFile.close();
 		gmresFile.close();
 	}
 };
 
-struct Body {
-	real radius;
-
-	Body(real radius_) : radius(radius_) {}
-
-	virtual void initStressEnergyPrim(
-		Tensor::Grid<StressEnergyPrims, subDim>& stressEnergyPrimGrid,
-		const Tensor::Grid<Tensor::Vector<real, subDim>, subDim>& xs
-	) = 0;
-};
+/*
+limited-memory Broyden
+keeps an approximation H of the inverse Jacobian from one iteration to the next,
+ so each step costs one residual evaluation (plus any backtracking) instead of a whole Krylov subspace
+H starts as (s.y / y.y) I, with s = x1 - x0 and y = F(x1) - F(x0) across a few JFNK steps taken up front
+each step does the 'good' Broyden update by Sherman-Morrison:
+	H += (s - H y) (H^T s)^T / (s . H y)
+stored as H = H0 + sum_i u_i v_i^T, and restarted from H0 once it holds 'memory' updates
+under convergeAlphaOnly H maps only onto the alphas, same as the seed JFNK steps:
+	H = H0 P + sum_i (P u_i) v_i^T, for P the projection onto the alphas
+*/
+struct BroydenSolver : public EFESolver {
+	using Super = EFESolver;
 
-struct NullBody : public Body {
-	using Body::Body;
+	int seedNewtonSteps = 2;	//JFNK steps to take before switching to Broyden
+	int memory = 10;	//updates to hold before restarting
+	int lineSearchMaxIter = 10;
+	real stopEpsilon = 1e-100;
+	std::string lineSearchName;	//for the seed JFNK steps
+	int gmresRecycle;	//ditto
+	std::string preconditionerName;	//ditto
+	std::string jacobianName;	//ditto
+	int jacobianReuse;	//ditto
+
+	real H0 = 1;
+	std::vector<std::vector<real>> us, vs;
+
+	BroydenSolver(Context& ctx, int maxiter, std::string lineSearchName_, int gmresRecycle_, std::string preconditionerName_, std::string jacobianName_, int jacobianReuse_)
+	: Super(ctx, maxiter)
+	, lineSearchName(lineSearchName_)
+	, gmresRecycle(gmresRecycle_)
+	, preconditionerName(preconditionerName_)
+	, jacobianName(jacobianName_)
+	, jacobianReuse(jacobianReuse_)
+	{}
 
-	virtual void initStressEnergyPrim(
-		Tensor::Grid<StressEnergyPrims, subDim>& stressEnergyPrimGrid,
-		const Tensor::Grid<Tensor::Vector<real, subDim>, subDim>& xs
-	) { }
-};
+	//whether x[i] is one of the metric prims being solved for
+	bool isSolved(int i) {
+		return !ctx.convergeAlphaOnly || i % (sizeof(MetricPrims) / sizeof(real)) == 0;
+	}
 
-struct SphericalBody : public Body {
-	real mass;
-	//derived:
-	real volume, density;
-	
-	SphericalBody(real radius_, real mass_)
-	: Body(radius_),
-	mass(mass_),
-	volume(4./3.*M_PI*radius*radius*radius),	// m^3
-	density(mass / volume)	// 1/m^2
-	{}
+	//y = H x
+	void applyH(real* y, const real* x) {
+		size_t n = getN();
+		for (int i = 0; i < (int)n; ++i) {
+			y[i] = isSolved(i) ? H0 * x[i] : 0;
+		}
+		for (int j = 0; j < (int)us.size(); ++j) {
+			real vx = dot(n, vs[j].data(), x);
+			for (int i = 0; i < (int)n; ++i) {
+				y[i] += us[j][i] * vx;
+			}
+		}
+	}
 
-	virtual void initStressEnergyPrim(
-		Tensor::Grid<StressEnergyPrims, subDim>& stressEnergyPrimGrid,
-		const Tensor::Grid<Tensor::Vector<real, subDim>, subDim>& xs
-	) {
-		Tensor::RangeObj<subDim> range(Tensor::Vector<int,subDim>(), sizev);
-		parallel.foreach(range.begin(), range.end(), [&](const Tensor::Vector<int, subDim>& index) {
-			StressEnergyPrims &stressEnergyPrims = stressEnergyPrimGrid(index);
-			real r = xs(index).length();
-			stressEnergyPrims.rho = r < radius ? density : 0;	// average density of Earth in m^-2
-			stressEnergyPrims.eInt = 0;	//internal energy / temperature of the Earth?
-			stressEnergyPrims.P = 0;	//pressure inside the Earth?
-			for (int i = 0; i < subDim; ++i) {
-				stressEnergyPrims.v(i) = 0;	//3-velocity
-				stressEnergyPrims.E(i) = 0;	//electric field
-				stressEnergyPrims.B(i) = 0;	//magnetic field
+	//y = H^T x
+	void applyHT(real* y, const real* x) {
+		size_t n = getN();
+		for (int i = 0; i < (int)n; ++i) {
+			y[i] = isSolved(i) ? H0 * x[i] : 0;
+		}
+		for (int j = 0; j < (int)us.size(); ++j) {
+			real ux = dot(n, us[j].data(), x);
+			for (int i = 0; i < (int)n; ++i) {
+				y[i] += vs[j][i] * ux;
 			}
-		});
+		}
 	}
-};
 
-//E_i = A_t,i - A_i,t
-//B_i = epsilon_i^jk A_k,j
+	//add the Sherman-Morrison update for the step s that changed F by y
+	void addUpdate(const std::vector<real>& s, const std::vector<real>& y) {
+		size_t n = getN();
+		std::vector<real> Hy(n), HTs(n);
+		applyH(Hy.data(), y.data());
+		applyHT(HTs.data(), s.data());
+		real denom = dot(n, s.data(), Hy.data());
+		if (denom == 0 || !std::isfinite(denom)) return;
+		std::vector<real> u(n);
+		for (int i = 0; i < (int)n; ++i) {
+			u[i] = isSolved(i) ? (s[i] - Hy[i]) / denom : 0;
+		}
+		us.push_back(u);
+		vs.push_back(HTs);
+	}
 
-//stress-energy of a uniform electric field in the x-direction
-struct EMUniformFieldBody : public Body {
-	using Body::Body;
-	virtual void initStressEnergyPrim(
-		Tensor::Grid<StressEnergyPrims, subDim>& stressEnergyPrimGrid,
-		const Tensor::Grid<Tensor::Vector<real, subDim>, subDim>& xs
-	) {
-		Tensor::RangeObj<subDim> range(Tensor::Vector<int,subDim>(), sizev);
-		parallel.foreach(range.begin(), range.end(), [&](const Tensor::Vector<int, subDim>& index) {
-			StressEnergyPrims &stressEnergyPrims = stressEnergyPrimGrid(index);
+	//forget the updates and rescale H0 by the last step
+	void restart(const std::vector<real>& s, const std::vector<real>& y) {
+		size_t n = getN();
+		us.clear();
+		vs.clear();
+		real sy = dot(n, s.data(), y.data());
+		real yy = dot(n, y.data(), y.data());
+		if (yy > 0 && sy != 0 && std::isfinite(sy / yy)) H0 = sy / yy;
+		addUpdate(s, y);
+	}
 
-			stressEnergyPrims.useEM = true; 
+	virtual void solve(
+		//input/output
+		Tensor::Grid<MetricPrims, subDim>& metricPrimGrid,
+		//input
+		const Tensor::Grid<MetricPrims, subDim>& dt_metricPrimGrid,	//first deriv
+		const Tensor::Grid<StressEnergyPrims, subDim>& stressEnergyPrimGrid
+	) {
+		size_t n = getN();
+		real* x = (real*)metricPrimGrid.v;
+
+		std::ofstream broydenFile("broyden.txt");
+		broydenFile << "#iter residual alpha F_evals updates" << std::endl;
+
+		std::vector<real> F(n), s(n), y(n);
+		bool seeded = false;
+		if (seedNewtonSteps > 0) {
+			std::vector<real> x0(x, x + n), F0(n);
+			if (ctx.useChargeCurrentForEM) {
+				update_EMFields(*ctx.workspace, metricPrimGrid, dt_metricPrimGrid, stressEnergyPrimGrid);
+			}
+			calcF(F0.data(), x0.data(), dt_metricPrimGrid, stressEnergyPrimGrid);
+			time("seeding with JFNK", [&]{
+				JFNKSolver seed(ctx, seedNewtonSteps, lineSearchName, gmresRecycle, preconditionerName, jacobianName, jacobianReuse);
+				seed.solve(metricPrimGrid, dt_metricPrimGrid, stressEnergyPrimGrid);
+				FEvals += seed.FEvals;
+			});
+			calcF(F.data(), x, dt_metricPrimGrid, stressEnergyPrimGrid);
+			for (int i = 0; i < (int)n; ++i) {
+				s[i] = x[i] - x0[i];
+				y[i] = F[i] - F0[i];
+			}
+			restart(s, y);
+			seeded = !us.empty();
+		} else {
+			if (ctx.useChargeCurrentForEM) {
+				update_EMFields(*ctx.workspace, metricPrimGrid, dt_metricPrimGrid, stressEnergyPrimGrid);
+			}
+			calcF(F.data(), x, dt_metricPrimGrid, stressEnergyPrimGrid);
+		}
+		if (!seeded) {
+			std::cout << "broyden has no secant pair to start from -- starting with H = " << H0 << " I" << std::endl;
+		}
+		real FNorm = Solver::Vector<real>::normL2(n, F.data());
 
-			real volts = 100000;			//V
-			real dist = 0.1;				//m
-			real E = volts / dist;			//V / m
-			E = E * sqrt(ke * G) / (c * c);	//m^-1
+		std::vector<real> d(n), xNew(n), FNew(n);
+		time("solving", [&]{
+			for (int iter = 0; iter < maxiter; ++iter) {
+				//d = -H F
+				applyH(d.data(), F.data());
+				
+				//backtrack until the residual drops enough
+				real alpha = 1;
+				real FNormNew = 0;
+				bool accepted = false;
+				for (int i = 0; i < lineSearchMaxIter; ++i, alpha *= .5) {
+					for (int j = 0; j < (int)n; ++j) {
+						xNew[j] = x[j] - alpha * d[j];
+					}
+					calcF(FNew.data(), xNew.data(), dt_metricPrimGrid, stressEnergyPrimGrid);
+					FNormNew = Solver::Vector<real>::normL2(n, FNew.data());
+					if (FNormNew < (1. - 1e-4 * alpha) * FNorm) {
+						accepted = true;
+						break;
+					}
+				}
+				if (!accepted) {
+					//H is no good.  forget the updates and try again from H0, unless that's what we just did
+					if (us.size() <= 1) {
+						std::cout << "broyden step didn't reduce the residual -- stopping" << std::endl;
+						break;
+					}
+					std::cout << "broyden step didn't reduce the residual -- restarting" << std::endl;
+					restart(s, y);
+					continue;
+				}
 
-			stressEnergyPrims.E(0) = E;
-			stressEnergyPrims.E(1) = 0;
-			stressEnergyPrims.E(2) = 0;
-	
-			stressEnergyPrims.B(0) = 0;
-			stressEnergyPrims.B(1) = 0;
-			stressEnergyPrims.B(2) = 0;
+				for (int j = 0; j < (int)n; ++j) {
+					s[j] = xNew[j] - x[j];
+					y[j] = FNew[j] - F[j];
+				}
+				std::copy(xNew.begin(), xNew.end(), x);
+				std::swap(F, FNew);
+				FNorm = FNormNew;
+
+				std::cout << "broyden"
+					<< " iter=" << iter
+					<< " alpha=" << alpha
+					<< " residual=" << std::setprecision(49) << FNorm << std::setprecision(6)
+					<< " FEvals=" << FEvals
+					<< std::endl;
+				broydenFile << iter
+					<< "\t" << std::setprecision(16) << FNorm << std::setprecision(6)
+					<< "\t" << alpha
+					<< "\t" << FEvals
+					<< "\t" << us.size()
+					<< std::endl;
+
+				if (FNorm <= stopEpsilon || !std::isfinite(FNorm)) break;
+
+				if ((int)us.size() >= memory) {
+					restart(s, y);
+					if (ctx.useChargeCurrentForEM) {
+						//A^a is held fixed between restarts, so the secant pairs all see the same F
+						update_EMFields(*ctx.workspace, metricPrimGrid, dt_metricPrimGrid, stressEnergyPrimGrid);
+						calcF(F.data(), x, dt_metricPrimGrid, stressEnergyPrimGrid);
+						FNorm = Solver::Vector<real>::normL2(n, F.data());
+					}
+				} else {
+					addUpdate(s, y);
+				}
+			}
 		});
+
+		broydenFile.close();
 	}
 };
 
-struct EMLineBody : public Body {
-	using Body::Body;
+/*
+pseudo-time relaxation
+	d/dtau g_ab = -(E_ab - 1/2 g_ab g^cd E_cd), for E_ab = G_ab - 8 pi T_ab
+the trace-reversed residual is R_ab - 8 pi (T_ab - 1/2 T g_ab), whose principal part is -1/2 g^ij g_ab,ij
+so this is a heat equation in g_ab, and each cell steps with its own dtau = cfl / (g^ij delta_ij / dx_i^2)
+the change in g_ab is then mapped back to alpha, beta^i and h_ij of the cell
+one residual evaluation per step, no Krylov basis, every cell independent
+the steps are then mixed by Anderson acceleration over the last andersonDepth iterates
+*/
+/*
+pseudo-time relaxation update of one cell's metric prims, for its local step dtau
+delta g_ab = -dtau (E_ab - 1/2 g_ab g^cd E_cd), mapped back onto alpha, beta^i, gamma_ij
+*/
+template<typename Real>
+void calc_relaxationUpdate(
+	//output
+	MetricPrimsOf<Real>& dxPrims,
+	//input
+	const MetricPrimsOf<Real>& metricPrims,
+	const TensorSLOf<Real>& gLL,
+	const TensorSUOf<Real>& gUU,
+	const TensorSLOf<Real>& EFE,
+	Real dtau
+) {
+	//E~_ab = E_ab - 1/2 g_ab g^cd E_cd
+	Real EFETrace = 0;
+	for (int a = 0; a < dim; ++a) {
+		for (int b = 0; b < dim; ++b) {
+			EFETrace += gUU(a,b) * EFE(a,b);
+		}
+	}
+	TensorSLOf<Real> delta_gLL;
+	for (int a = 0; a < dim; ++a) {
+		for (int b = 0; b <= a; ++b) {
+			delta_gLL(a,b) = -dtau * (EFE(a,b) - .5 * gLL(a,b) * EFETrace);
+		}
+	}
 
-	//torus-shaped-something
-	//radius is the big radius of the torus
-	virtual void initStressEnergyPrim(
-		Tensor::Grid<StressEnergyPrims, subDim>& stressEnergyPrimGrid,
-		const Tensor::Grid<Tensor::Vector<real, subDim>, subDim>& xs
-	) {
-		Tensor::RangeObj<subDim> range(Tensor::Vector<int,subDim>(), sizev);
-		parallel.foreach(range.begin(), range.end(), [&](const Tensor::Vector<int, subDim>& index) {
-			StressEnergyPrims &stressEnergyPrims = stressEnergyPrimGrid(index);
-			const Tensor::Vector<real, subDim>& xi = xs(index);
-			real x = xi(0);
-			real y = xi(1);
-			real z = xi(2);
-			real polar_rSq = x*x + y*y; 
-			real polar_r = sqrt(polar_rSq);		//r in polar coordinates	
-			real dr = polar_r - radius;	//difference from polar radius to torus big radius
-			real r = sqrt(z*z + dr*dr);			//r in torus radial coordinates
-			real theta = atan2(z, dr);			//angle around the small radius
-			real phi = atan2(x, y);				//angle around the big radius
-		
-			//F^uv_;v = -4 pi J^u
-			// means that the divergence of the EM is the 4-current 
-			//the divergence of the exterior of the 4-potential is the 4-current
-			//so if the 4-current is a Dirac delta function along the line in space where there is current
-			// then the EM tensor is going to be an inverse falloff around it
-	
-			//4-current
-			//t is current density
-			//i is charge density = current density * drift velocity
-			//stressEnergyPrims.chargeDensity
-			//stressEnergyPrims.A
+	//delta gamma_ij = delta g_ij
+	for (int i = 0; i < subDim; ++i) {
+		for (int j = 0; j <= i; ++j) {
+			dxPrims.hLL(i,j) = delta_gLL(i+1,j+1);
+		}
+	}
 	
-			/*
-			point on the surface:
-				r * cos(phi) * cos(theta)
-				r * sin(phi) * cos(theta)
-				r * sin(theta)
-			*/
-		
-			stressEnergyPrims.E(0) = -y / polar_rSq;
-			stressEnergyPrims.E(1) = x / polar_rSq;
-			stressEnergyPrims.E(2) = 0;
+	//delta beta^i = gamma^ij (delta g_tj - delta gamma_jk beta^k)
+	Real alpha = metricPrims.alphaMinusOne + 1.;
+	const TensorUsubOf<Real>& betaU = metricPrims.betaU;
+	TensorSLsubOf<Real> gammaLL = calc_gammaLL(metricPrims);
+	TensorSUsubOf<Real> gammaUU = inverse(gammaLL);
+	TensorLsubOf<Real> delta_betaL;
+	for (int j = 0; j < subDim; ++j) {
+		delta_betaL(j) = delta_gLL(j+1,0);
+		for (int l = 0; l < subDim; ++l) {
+			delta_betaL(j) -= dxPrims.hLL(j,l) * betaU(l);
+		}
+	}
+	for (int i = 0; i < subDim; ++i) {
+		dxPrims.betaU(i) = 0;
+		for (int j = 0; j < subDim; ++j) {
+			dxPrims.betaU(i) += gammaUU(i,j) * delta_betaL(j);
+		}
+	}
 	
-			stressEnergyPrims.B(0) = cos(theta) / r * cos(phi);
-			stressEnergyPrims.B(1) = cos(theta) / r * sin(phi);
-			stressEnergyPrims.B(2) = -sin(theta) / r;
-		});
+	//g_tt = -alpha^2 + gamma_ij beta^i beta^j
+	//delta alpha = (delta(gamma_ij beta^i beta^j) - delta g_tt) / (2 alpha)
+	Real delta_betaSq = 0;
+	for (int i = 0; i < subDim; ++i) {
+		for (int j = 0; j < subDim; ++j) {
+			delta_betaSq += dxPrims.hLL(i,j) * betaU(i) * betaU(j)
+				+ 2. * gammaLL(i,j) * dxPrims.betaU(i) * betaU(j);
+		}
 	}
-};
-
-struct InitCond {
-	virtual void initMetricPrims(
-		Tensor::Grid<MetricPrims, subDim>& metricPrimGrid,
-		const Tensor::Grid<Tensor::Vector<real, subDim>, subDim>& xs
-	) = 0;
-};
+	dxPrims.alphaMinusOne = (delta_betaSq - delta_gLL(0,0)) / (2. * alpha);
+}
 
-struct SphericalBodyInitCond : public InitCond {
-	std::shared_ptr<SphericalBody> body;	
-	SphericalBodyInitCond(std::shared_ptr<SphericalBody> body_) : body(body_) {}
-};
+struct PseudoTimeSolver : public EFESolver {
+	using Super = EFESolver;
+	using Super::Super;
 
-struct FlatInitCond : public InitCond {
-	//substitute the schwarzschild R for 2 m(r)
-	virtual void initMetricPrims(
-		Tensor::Grid<MetricPrims, subDim>& metricPrimGrid,
-		const Tensor::Grid<Tensor::Vector<real, subDim>, subDim>& xs
+	real cfl = .25;
+	int andersonDepth = 5;	//0 = plain relaxation
+	real andersonMixing = 1;	//beta: how much of the new update goes into the mix
+	real andersonRegularization = 1e-12;	//relative to the trace of the least squares normal matrix
+	real stopEpsilon = 1e-100;
+	
+	/*
+	dx = the relaxation update at x, given F = F(x)
+	g_ab and g^ab of x must be in 'workspace', which calcF leaves them
+	dtauMin and dtauMax are for reporting
+	under convergeAlphaOnly only alpha is updated, so the Anderson mix only moves alpha too, and the JFNK after a warm start gets the beta^i and h_ij it started with
+	*/
+	void calcRelaxationUpdate(
+		//output
+		Tensor::Grid<MetricPrims, subDim>& dxGrid,
+		real& dtauMin,
+		real& dtauMax,
+		//input
+		const Tensor::Grid<MetricPrims, subDim>& metricPrimGrid,
+		const Tensor::Grid<TensorSL, subDim>& EFEGrid
 	) {
-		Tensor::RangeObj<subDim> range(Tensor::Vector<int,subDim>(), sizev);
-		parallel.foreach(range.begin(), range.end(), [&](const Tensor::Vector<int, subDim>& index) {
-			MetricPrims& metricPrims = metricPrimGrid(index);
-			metricPrims.alphaMinusOne = 0;
+		std::vector<real> dtaus(ctx.gridVolume);
+		std::vector<int> cells(ctx.gridVolume);
+		for (int k = 0; k < ctx.gridVolume; ++k) cells[k] = k;
+		ctx.workspace->parallel->foreach(cells.begin(), cells.end(), [&](int k) {
+			const MetricPrims& metricPrims = metricPrimGrid.v[k];
+			const TensorSL& gLL = ctx.workspace->gLLs.v[k];
+			const TensorSU& gUU = ctx.workspace->gUUs.v[k];
+			const TensorSL& EFE = EFEGrid.v[k];
+			
+			//local time step from the diagonal of the 2nd derivative stencil
+			real diag = 0;
 			for (int i = 0; i < subDim; ++i) {
-				metricPrims.betaU(i) = 0;
-				for (int j = 0; j <= i; ++j) {
-					metricPrims.hLL(i,j) = 0;
+				diag += fabs(gUU(i+1,i+1)) / (ctx.dx(i) * ctx.dx(i));
+			}
+			real dtau = diag > 0 ? cfl / diag : 0;
+			dtaus[k] = dtau;
+			
+			calc_relaxationUpdate(dxGrid.v[k], metricPrims, gLL, gUU, EFE, dtau);
+			if (ctx.convergeAlphaOnly) {
+				real* dxPrims = (real*)&dxGrid.v[k];
+				for (int j = 1; j < (int)(sizeof(MetricPrims) / sizeof(real)); ++j) {
+					dxPrims[j] = 0;
 				}
 			}
 		});
+		dtauMin = *std::min_element(dtaus.begin(), dtaus.end());
+		dtauMax = *std::max_element(dtaus.begin(), dtaus.end());
 	}
-};
 
-/*
-The stellar Schwarzschild initial conditions have constraint value of zero outside Earth (good)
-but inside Earth they give a difference of 2 g/cm^3 ... off from the Earth's density of 5.51 g/cm^3
+	/*
+	Anderson mixing
+	given the fixed-point residual f = g(x) - x and the differences of the last few x's and f's,
+	gamma = argmin |f - dF gamma|
+	x_new = x + beta f - (dX + beta dF) gamma
+	*/
+	std::deque<std::vector<real>> dXs, dFs;
+	void andersonMix(
+		//output
+		real* xNew,
+		//input
+		const real* x,
+		const real* f
+	) {
+		size_t n = getN();
+		int m = (int)dFs.size();
+		
+		//normal equations (dF^T dF + reg I) gamma = dF^T f
+		std::vector<real> A(m * m), b(m), gamma(m);
+		real trace = 0;
+		for (int i = 0; i < m; ++i) {
+			b[i] = dot(n, dFs[i].data(), f);
+			for (int j = 0; j <= i; ++j) {
+				A[i + m * j] = A[j + m * i] = dot(n, dFs[i].data(), dFs[j].data());
+			}
+			trace += A[i + m * i];
+		}
+		for (int i = 0; i < m; ++i) {
+			A[i + m * i] += andersonRegularization * trace;
+		}
+		
+		solveDense(m, A.data(), b.data(), gamma.data());
+		
+		for (int i = 0; i < (int)n; ++i) {
+			xNew[i] = x[i] + andersonMixing * f[i];
+			for (int j = 0; j < m; ++j) {
+				xNew[i] -= gamma[j] * (dXs[j][i] + andersonMixing * dFs[j][i]);
+			}
+		}
+	}
+
+	virtual void solve(
+		//input/output
+		Tensor::Grid<MetricPrims, subDim>& metricPrimGrid,
+		//input
+		const Tensor::Grid<MetricPrims, subDim>& dt_metricPrimGrid,	//first deriv
+		const Tensor::Grid<StressEnergyPrims, subDim>& stressEnergyPrimGrid
+	) {
+		size_t n = getN();
+		real* x = (real*)metricPrimGrid.v;
+
+		std::ofstream pseudoTimeFile("pseudotime.txt");
+		pseudoTimeFile << "#iter residual dtau_min dtau_max anderson_depth" << std::endl;
+	
+		Tensor::Grid<TensorSL, subDim> EFEGrid(ctx.sizev);
+		Tensor::Grid<MetricPrims, subDim> dxGrid(ctx.sizev);
+		real* f = (real*)dxGrid.v;
+		std::vector<real> xPrev(n), fPrev(n), xNew(n);
+		real lastFNorm = std::numeric_limits<real>::infinity();
+		
+		if (ctx.useChargeCurrentForEM) {
+			//A^a is held at the initial metric, since every step only moves it a little
+			update_EMFields(*ctx.workspace, metricPrimGrid, dt_metricPrimGrid, stressEnergyPrimGrid);
+		}
+		time("solving", [&]{
+			for (int iter = 0; iter < maxiter; ++iter) {
+				calcF((real*)EFEGrid.v, x, dt_metricPrimGrid, stressEnergyPrimGrid);
+				real FNorm = Solver::Vector<real>::normL2(n, (real*)EFEGrid.v);
+				
+				real dtauMin, dtauMax;
+				calcRelaxationUpdate(dxGrid, dtauMin, dtauMax, metricPrimGrid, EFEGrid);
+
+				std::cout << "pseudo-time"
+					<< " iter=" << iter
+					<< " residual=" << std::setprecision(49) << FNorm << std::setprecision(6)
+					<< " dtau=[" << dtauMin << ", " << dtauMax << "]"
+					<< std::endl;
+				pseudoTimeFile << iter
+					<< "\t" << std::setprecision(16) << FNorm << std::setprecision(6)
+					<< "\t" << dtauMin
+					<< "\t" << dtauMax
+					<< "\t" << dFs.size()
+					<< std::endl;
+				
+				if (FNorm <= stopEpsilon || !std::isfinite(FNorm)) break;
+
+				//the mix made things worse?  start the history over
+				if (FNorm > lastFNorm) {
+					dXs.clear();
+					dFs.clear();
+				} else if (iter > 0 && andersonDepth > 0) {
+					std::vector<real> dX(n), dF(n);
+					for (int i = 0; i < (int)n; ++i) {
+						dX[i] = x[i] - xPrev[i];
+						dF[i] = f[i] - fPrev[i];
+					}
+					dXs.push_back(dX);
+					dFs.push_back(dF);
+					if ((int)dFs.size() > andersonDepth) {
+						dXs.pop_front();
+						dFs.pop_front();
+					}
+				}
+				lastFNorm = FNorm;
+				
+				andersonMix(xNew.data(), x, f);
+				std::copy(x, x + n, xPrev.begin());
+				std::copy(f, f + n, fPrev.begin());
+				std::copy(xNew.begin(), xNew.end(), x);
+			}
+		});
+		
+		pseudoTimeFile.close();
+	}
+};
+
+/*
+solves several configurations on the same grid at once, each in a lane of an Ensemble
+so one residual evaluation (calc_gLLs_and_gUUs, calc_GammaULLs, calc_EFE_constraint) advances ensembleWidth of them
+they share dt_metricPrimGrid, and differ in their metric prims and their sources
+a cell gets the matter or EM terms of T_ab if any configuration has them there, which the rest evaluate to zero
+plain pseudo-time relaxation, since then every lane steps on its own
+every metric prim is relaxed, even under convergeAlphaOnly: G_ij depends on alpha too, so stepping alpha alone down g_tt's residual stalls
+*/
+struct EnsembleSolver {
+	using EnsembleReal = Ensemble<real, ensembleWidth>;
+
+	const Context& ctx;
+	int maxiter;
+	real tolerance;	//stop once every lane's residual is this fraction of where it started
+	real cfl = .25;
+	EnsembleSolver(const Context& ctx_, int maxiter_, real tolerance_) : ctx(ctx_), maxiter(maxiter_), tolerance(tolerance_) {}
+
+	//lane l of a cell of EnsembleReals to or from a cell of reals, for cell types made of nothing but reals
+	template<typename CellType>
+	static void setLane(CellType& dst, const real* src, int l) {
+		EnsembleReal* d = (EnsembleReal*)&dst;
+		for (int j = 0; j < (int)(sizeof(CellType) / sizeof(EnsembleReal)); ++j) {
+			d[j][l] = src[j];
+		}
+	}
+	template<typename CellType>
+	static void getLane(real* dst, const CellType& src, int l) {
+		const EnsembleReal* s = (const EnsembleReal*)&src;
+		for (int j = 0; j < (int)(sizeof(CellType) / sizeof(EnsembleReal)); ++j) {
+			dst[j] = s[j][l];
+		}
+	}
+
+	//the flags are or'd, so dst has to start out default
+	static void setLane(StressEnergyPrimsOf<EnsembleReal>& dst, const StressEnergyPrims& src, int l) {
+		dst.rho[l] = src.rho;
+		dst.P[l] = src.P;
+		dst.eInt[l] = src.eInt;
+		dst.useV |= src.useV;
+		dst.useEM |= src.useEM;
+		for (int i = 0; i < subDim; ++i) {
+			dst.v(i)[l] = src.v(i);
+			dst.currentDensity(i)[l] = src.currentDensity(i);
+			dst.E(i)[l] = src.E(i);
+			dst.B(i)[l] = src.B(i);
+		}
+		dst.chargeDensity[l] = src.chargeDensity;
+	}
+
+	/*
+	metricPrimGrids[i] is solved in place for stressEnergyPrimGrids[i]
+	returns each one's |G_ab - 8 pi T_ab|
+	*/
+	std::vector<real> solve(
+		//input/output
+		const std::vector<Tensor::Grid<MetricPrims, subDim>*>& metricPrimGrids,
+		//input
+		const Tensor::Grid<MetricPrims, subDim>& dt_metricPrimGrid,	//first deriv
+		const std::vector<const Tensor::Grid<StressEnergyPrims, subDim>*>& stressEnergyPrimGrids
+	) {
+		int n = (int)metricPrimGrids.size();
+		std::vector<real> residuals(n);
+
+		//ctx's, but with the stress-energy cells of the ensemble
+		Context ensembleCtx = ctx;
+		WorkspaceOf<EnsembleReal> ws(&ensembleCtx, ctx.parallel);
+		size_t totalSize = 0;
+		allocateWorkspace(ws, "ensemble workspace", ctx.isStationary, ctx.sizev, totalSize);
+		Tensor::Grid<MetricPrimsOf<EnsembleReal>, subDim> ensembleMetricPrimGrid(ctx.sizev);
+		Tensor::Grid<MetricPrimsOf<EnsembleReal>, subDim> ensemble_dt_metricPrimGrid(ctx.sizev);
+		Tensor::Grid<MetricPrimsOf<EnsembleReal>, subDim> dxGrid(ctx.sizev);
+		Tensor::Grid<StressEnergyPrimsOf<EnsembleReal>, subDim> ensembleStressEnergyPrimGrid(ctx.sizev);
+		Tensor::Grid<TensorSLOf<EnsembleReal>, subDim> EFEGrid(ctx.sizev);
+		StressEnergyCellLists& cells = ensembleCtx.stressEnergyCells;
+
+		//the time derivatives are the same in every lane
+		for (int k = 0; k < ctx.gridVolume; ++k) {
+			for (int l = 0; l < ensembleWidth; ++l) {
+				setLane(ensemble_dt_metricPrimGrid.v[k], (const real*)&dt_metricPrimGrid.v[k], l);
+			}
+		}
+
+		std::vector<int> allCells(ctx.gridVolume);
+		for (int k = 0; k < ctx.gridVolume; ++k) allCells[k] = k;
+
+		for (int start = 0; start < n; start += ensembleWidth) {
+			//pad a short ensemble with its last configuration
+			auto configIndex = [&](int l) -> int { return std::min(start + l, n - 1); };
+
+			for (int k = 0; k < ctx.gridVolume; ++k) {
+				ensembleStressEnergyPrimGrid.v[k] = StressEnergyPrimsOf<EnsembleReal>();
+				for (int l = 0; l < ensembleWidth; ++l) {
+					setLane(ensembleMetricPrimGrid.v[k], (const real*)&metricPrimGrids[configIndex(l)]->v[k], l);
+					setLane(ensembleStressEnergyPrimGrid.v[k], stressEnergyPrimGrids[configIndex(l)]->v[k], l);
+				}
+			}
+			classifyStressEnergyCells(ensembleStressEnergyPrimGrid, cells);
+			if (ctx.useChargeCurrentForEM) {
+				if (!cells.EM.empty() || !cells.EMAndMatter.empty()) {
+					throw Common::Exception() << "EM fields from charge and current densities don't work with ensembles";
+				}
+			}
+
+			EnsembleReal FNorm, FNorm0;
+			time("solving ensemble", [&]{
+				for (int iter = 0;; ++iter) {
+					calc_gLLs_and_gUUs(ensembleMetricPrimGrid, ensemble_dt_metricPrimGrid, ws);
+					calc_GammaULLs(ws);
+					calc_EFE_constraint(ws, ensembleMetricPrimGrid, ensembleStressEnergyPrimGrid, EFEGrid);
+
+					EnsembleReal FNormSq;
+					for (int k = 0; k < ctx.gridVolume; ++k) {
+						const EnsembleReal* EFE = (const EnsembleReal*)&EFEGrid.v[k];
+						for (int j = 0; j < (int)(sizeof(TensorSLOf<EnsembleReal>) / sizeof(EnsembleReal)); ++j) {
+							FNormSq += EFE[j] * EFE[j];
+						}
+					}
+					FNorm = sqrt(FNormSq);
+					if (iter == 0) FNorm0 = FNorm;
+				
+					bool converged = true;
+					bool finite = true;
+					std::cout << "ensemble iter=" << iter << " residual=";
+					for (int l = 0; l < ensembleWidth; ++l) {
+						std::cout << (l ? ", " : "[") << FNorm[l];
+						converged &= FNorm[l] <= tolerance * FNorm0[l];
+						finite &= std::isfinite(FNorm[l]);
+					}
+					std::cout << "]" << std::endl;
+
+					if (iter >= maxiter || converged || !finite) break;
+
+					ctx.parallel->foreach(allCells.begin(), allCells.end(), [&](int k) {
+						const TensorSUOf<EnsembleReal>& gUU = ws.gUUs.v[k];
+						
+						//local time step from the diagonal of the 2nd derivative stencil, lane by lane
+						EnsembleReal diag;
+						for (int i = 0; i < subDim; ++i) {
+							diag += fabs(gUU(i+1,i+1)) / (ctx.dx(i) * ctx.dx(i));
+						}
+						EnsembleReal dtau;
+						for (int l = 0; l < ensembleWidth; ++l) {
+							dtau[l] = diag[l] > 0 ? cfl / diag[l] : 0;
+						}
+						
+						calc_relaxationUpdate(dxGrid.v[k], ensembleMetricPrimGrid.v[k], ws.gLLs.v[k], gUU, EFEGrid.v[k], dtau);
+
+						EnsembleReal* x = (EnsembleReal*)&ensembleMetricPrimGrid.v[k];
+						const EnsembleReal* dxPrims = (const EnsembleReal*)&dxGrid.v[k];
+						for (int j = 0; j < (int)(sizeof(MetricPrimsOf<EnsembleReal>) / sizeof(EnsembleReal)); ++j) {
+							x[j] += dxPrims[j];
+						}
+					});
+				}
+			});
+
+			for (int l = 0; l < ensembleWidth && start + l < n; ++l) {
+				Tensor::Grid<MetricPrims, subDim>& metricPrimGrid = *metricPrimGrids[start + l];
+				for (int k = 0; k < ctx.gridVolume; ++k) {
+					getLane((real*)&metricPrimGrid.v[k], ensembleMetricPrimGrid.v[k], l);
+				}
+				residuals[start + l] = FNorm[l];
+			}
+		}
+		return residuals;
+	}
+};
+
+//average of the 2^subDim fine cells under each coarse cell, for any cell type made of reals
+template<typename CellType>
+void restrictGrid(
+	Parallel::Parallel* parallel,
+	//output
+	Tensor::Grid<CellType, subDim>& coarseGrid,
+	//input
+	const Tensor::Grid<CellType, subDim>& fineGrid,
+	Tensor::Vector<int, subDim> coarseSizev
+) {
+	const int numReals = sizeof(CellType) / sizeof(real);
+	Tensor::RangeObj<subDim> range(Tensor::Vector<int,subDim>(), coarseSizev);
+	parallel->foreach(range.begin(), range.end(), [&](const Tensor::Vector<int, subDim>& index) {
+		real* dst = (real*)&coarseGrid(index);
+		for (int j = 0; j < numReals; ++j) dst[j] = 0;
+		for (int child = 0; child < (1 << subDim); ++child) {
+			Tensor::Vector<int, subDim> fineIndex;
+			for (int i = 0; i < subDim; ++i) {
+				fineIndex(i) = 2 * index(i) + ((child >> i) & 1);
+			}
+			const real* src = (const real*)&fineGrid(fineIndex);
+			for (int j = 0; j < numReals; ++j) dst[j] += src[j];
+		}
+		for (int j = 0; j < numReals; ++j) dst[j] /= (real)(1 << subDim);
+	});
+}
+
+/*
+fine += P coarse
+cell-centered trilinear: each fine cell takes 3/4 of its parent and 1/4 of the parent's neighbor on its side, per axis
+*/
+template<typename CellType>
+void prolongAddGrid(
+	Parallel::Parallel* parallel,
+	//input/output
+	Tensor::Grid<CellType, subDim>& fineGrid,
+	//input
+	const Tensor::Grid<CellType, subDim>& coarseGrid,
+	Tensor::Vector<int, subDim> fineSizev,
+	Tensor::Vector<int, subDim> coarseSizev
+) {
+	const int numReals = sizeof(CellType) / sizeof(real);
+	Tensor::RangeObj<subDim> range(Tensor::Vector<int,subDim>(), fineSizev);
+	parallel->foreach(range.begin(), range.end(), [&](const Tensor::Vector<int, subDim>& index) {
+		real* dst = (real*)&fineGrid(index);
+		for (int corner = 0; corner < (1 << subDim); ++corner) {
+			Tensor::Vector<int, subDim> coarseIndex;
+			real weight = 1;
+			for (int i = 0; i < subDim; ++i) {
+				int parent = index(i) / 2;
+				if ((corner >> i) & 1) {
+					int side = index(i) & 1 ? 1 : -1;
+					coarseIndex(i) = std::max<int>(0, std::min<int>(coarseSizev(i)-1, parent + side));
+					weight *= .25;
+				} else {
+					coarseIndex(i) = parent;
+					weight *= .75;
+				}
+			}
+			const real* src = (const real*)&coarseGrid(coarseIndex);
+			for (int j = 0; j < numReals; ++j) dst[j] += weight * src[j];
+		}
+	});
+}
+
+/*
+fine = coarse, by tensor-product cubic Lagrange interpolation between the cell centers of two grids over the same extent
+any ratio of sizes.  at the edges the 4-point stencil shifts inwards rather than clamping, so it stays cubic up to the boundary
+*/
+template<typename CellType>
+void interpolateGrid(
+	Parallel::Parallel* parallel,
+	//output
+	Tensor::Grid<CellType, subDim>& fineGrid,
+	//input
+	const Tensor::Grid<CellType, subDim>& coarseGrid,
+	Tensor::Vector<int, subDim> fineSizev,
+	Tensor::Vector<int, subDim> coarseSizev
+) {
+	const int numReals = sizeof(CellType) / sizeof(real);
+	Tensor::RangeObj<subDim> range(Tensor::Vector<int,subDim>(), fineSizev);
+	parallel->foreach(range.begin(), range.end(), [&](const Tensor::Vector<int, subDim>& index) {
+		int width[subDim], base[subDim];
+		real weights[subDim][4];
+		for (int i = 0; i < subDim; ++i) {
+			width[i] = std::min<int>(4, coarseSizev(i));
+			real f = ((real)index(i) + .5) * (real)coarseSizev(i) / (real)fineSizev(i) - .5;	//in coarse cells
+			base[i] = std::max<int>(0, std::min<int>(coarseSizev(i) - width[i], (int)floor(f) - 1));
+			for (int p = 0; p < width[i]; ++p) {
+				real w = 1;
+				for (int q = 0; q < width[i]; ++q) {
+					if (q != p) w *= (f - (real)(base[i] + q)) / (real)(p - q);
+				}
+				weights[i][p] = w;
+			}
+		}
+		real* dst = (real*)&fineGrid(index);
+		for (int j = 0; j < numReals; ++j) dst[j] = 0;
+		Tensor::RangeObj<subDim> stencil(Tensor::Vector<int,subDim>(), Tensor::Vector<int,subDim>(width[0], width[1], width[2]));
+		for (const Tensor::Vector<int, subDim>& offset : stencil) {
+			Tensor::Vector<int, subDim> coarseIndex;
+			real weight = 1;
+			for (int i = 0; i < subDim; ++i) {
+				coarseIndex(i) = base[i] + offset(i);
+				weight *= weights[i][offset(i)];
+			}
+			const real* src = (const real*)&coarseGrid(coarseIndex);
+			for (int j = 0; j < numReals; ++j) dst[j] += weight * src[j];
+		}
+	});
+}
+
+//average the sources, and keep a term on wherever any of the fine cells had it on
+void restrictStressEnergyPrims(
+	Parallel::Parallel* parallel,
+	//output
+	Tensor::Grid<StressEnergyPrims, subDim>& coarseGrid,
+	//input
+	const Tensor::Grid<StressEnergyPrims, subDim>& fineGrid,
+	Tensor::Vector<int, subDim> coarseSizev
+) {
+	Tensor::RangeObj<subDim> range(Tensor::Vector<int,subDim>(), coarseSizev);
+	parallel->foreach(range.begin(), range.end(), [&](const Tensor::Vector<int, subDim>& index) {
+		StressEnergyPrims& dst = coarseGrid(index);
+		dst = StressEnergyPrims();
+		const real scale = 1. / (real)(1 << subDim);
+		for (int child = 0; child < (1 << subDim); ++child) {
+			Tensor::Vector<int, subDim> fineIndex;
+			for (int i = 0; i < subDim; ++i) {
+				fineIndex(i) = 2 * index(i) + ((child >> i) & 1);
+			}
+			const StressEnergyPrims& src = fineGrid(fineIndex);
+			dst.rho += scale * src.rho;
+			dst.P += scale * src.P;
+			dst.eInt += scale * src.eInt;
+			dst.useV |= src.useV;
+			dst.useEM |= src.useEM;
+			dst.chargeDensity += scale * src.chargeDensity;
+			for (int i = 0; i < subDim; ++i) {
+				dst.v(i) += scale * src.v(i);
+				dst.currentDensity(i) += scale * src.currentDensity(i);
+				dst.E(i) += scale * src.E(i);
+				dst.B(i) += scale * src.B(i);
+			}
+		}
+	});
+}
+
+/*
+nonlinear multigrid, Full Approximation Scheme
+each level solves F_l(x_l) = tau_l, with tau = 0 on the finest and
+	tau_coarse = F_coarse(R x_fine) + R (tau_fine - F_fine(x_fine))
+and the fine level takes the change in the coarse solution back: x_fine += P (x_coarse - R x_fine)
+R averages the 8 children, P is cell-centered trilinear
+the grid halves until an axis would go odd or below minCoarseSize
+
+the smoother is nonlinear Gauss-Seidel: at each cell, one Newton step on the 10 EFE of that cell in the 10 MetricPrims of that cell, with the neighbors held fixed
+F at a cell reaches the cells around it, corners included for the mixed 2nd derivatives, so red-black isn't enough:
+ cells are colored by each index mod getStencilRadius() + 1, 8 colors by parity for the usual radius of 1,
+ and the colors are swept in turn, each color in parallel
+
+each level has its own copy of the solver's Context, with the level's grid size, spacing, stress-energy cells and workspace
+only handles stationary metrics, since coarse dt_metricPrimGrids would need the same treatment
+*/
+struct FASSolver : public EFESolver {
+	using Super = EFESolver;
+
+	int preSweeps = 2;
+	int postSweeps = 2;
+	int coarsestSweeps = 10;
+	int minCoarseSize = 4;
+	int correctionMaxHalvings = 4;
+	real jacobianEpsilon = 1e-7;	//per-cell finite-difference Jacobian
+	real stopEpsilon = 1e-100;
+
+	struct Level {
+		Context ctx;	//the solver's, on this level's grid
+		Tensor::Grid<MetricPrims, subDim> metricPrimGrid;
+		Tensor::Grid<MetricPrims, subDim> dt_metricPrimGrid;	//all zero
+		Tensor::Grid<StressEnergyPrims, subDim> stressEnergyPrimGrid;
+		Tensor::Grid<TensorSL, subDim> tauGrid;	//right hand side
+		Tensor::Grid<TensorSL, subDim> EFEGrid;
+		Tensor::Grid<MetricPrims, subDim> restrictedMetricPrimGrid;	//R x_fine, before the coarse solve
+		Tensor::Grid<MetricPrims, subDim> correctionGrid;	//P (x_coarse - R x_fine)
+		Tensor::Grid<MetricPrims, subDim> savedMetricPrimGrid;	//x before the coarse grid correction
+		Workspace ws;
+		std::vector<std::vector<Tensor::Vector<int, subDim>>> colors;
+		Level(const Context& solverCtx) : ctx(solverCtx), ws(&ctx, solverCtx.parallel) {
+			ctx.workspace = &ws;
+		}
+	};
+	std::vector<std::shared_ptr<Level>> levels;
+
+	using Super::Super;
+
+	void buildLevels(
+		const Tensor::Grid<MetricPrims, subDim>& metricPrimGrid,
+		const Tensor::Grid<StressEnergyPrims, subDim>& stressEnergyPrimGrid
+	) {
+		//each solve can bring new sources (continuation's steps) or a new grid (grid sequencing), so start over
+		levels.clear();
+		size_t totalSize = 0;
+		Tensor::Vector<int, subDim> levelSizev = ctx.sizev;
+		Tensor::Vector<real, subDim> levelDx = ctx.dx;
+		for (;;) {
+			std::shared_ptr<Level> level = std::make_shared<Level>(ctx);
+			int l = (int)levels.size();
+			level->ctx.sizev = levelSizev;
+			level->ctx.dx = levelDx;
+			level->ctx.gridVolume = levelSizev.volume();
+			std::string name = "fas.levels[" + std::to_string(l) + "]";
+			allocateGrid(level->metricPrimGrid, name + ".metricPrimGrid", levelSizev, totalSize);
+			allocateGrid(level->dt_metricPrimGrid, name + ".dt_metricPrimGrid", levelSizev, totalSize);
+			allocateGrid(level->stressEnergyPrimGrid, name + ".stressEnergyPrimGrid", levelSizev, totalSize);
+			allocateGrid(level->tauGrid, name + ".tauGrid", levelSizev, totalSize);
+			allocateGrid(level->EFEGrid, name + ".EFEGrid", levelSizev, totalSize);
+			allocateGrid(level->restrictedMetricPrimGrid, name + ".restrictedMetricPrimGrid", levelSizev, totalSize);
+			allocateGrid(level->correctionGrid, name + ".correctionGrid", levelSizev, totalSize);
+			allocateGrid(level->savedMetricPrimGrid, name + ".savedMetricPrimGrid", levelSizev, totalSize);
+			allocateWorkspace(level->ws, name + ".ws", true, levelSizev, totalSize);
+
+			if (l == 0) {
+				std::copy(stressEnergyPrimGrid.v, stressEnergyPrimGrid.v + level->ctx.gridVolume, level->stressEnergyPrimGrid.v);
+			} else {
+				restrictStressEnergyPrims(ctx.parallel, level->stressEnergyPrimGrid, levels.back()->stressEnergyPrimGrid, levelSizev);
+			}
+			classifyStressEnergyCells(level->stressEnergyPrimGrid, level->ctx.stressEnergyCells);
+
+			//a relaxed cell moves F within getStencilRadius(), so same-colored cells are one more than that apart
+			int period = getStencilRadius(ctx) + 1;
+			level->colors.resize(period * period * period);
+			Tensor::RangeObj<subDim> range(Tensor::Vector<int,subDim>(), levelSizev);
+			for (Tensor::Vector<int, subDim> index : range) {
+				level->colors[index(0) % period + period * (index(1) % period + period * (index(2) % period))].push_back(index);
+			}
+			levels.push_back(level);
+
+			bool canCoarsen = true;
+			for (int i = 0; i < subDim; ++i) {
+				canCoarsen &= levelSizev(i) % 2 == 0 && levelSizev(i) / 2 >= minCoarseSize;
+			}
+			if (!canCoarsen) break;
+			for (int i = 0; i < subDim; ++i) {
+				levelSizev(i) /= 2;
+				levelDx(i) *= 2;
+			}
+		}
+		std::cout << "fas levels:";
+		for (std::shared_ptr<Level> level : levels) {
+			std::cout << " " << level->ctx.sizev;
+		}
+		std::cout << std::endl;
+	}
+
+	//EFEGrid = F(x) - tau on the level
+	void calcLevelResidual(Level& level) {
+		calcF((real*)level.EFEGrid.v, (const real*)level.metricPrimGrid.v, level.dt_metricPrimGrid, level.stressEnergyPrimGrid, level.ws);
+		for (int k = 0; k < level.ctx.gridVolume; ++k) {
+			for (int a = 0; a < dim; ++a) {
+				for (int b = 0; b <= a; ++b) {
+					level.EFEGrid.v[k](a,b) -= level.tauGrid.v[k](a,b);
+				}
+			}
+		}
+	}
+
+	//F - tau at one cell, as 10 reals, after updating that cell's g_ab, g^ab and Gamma^a_bc in the workspace
+	template<EinsteinPath einstein, DGammaPath dGamma>
+	void calcCellResidual(Level& level, const Tensor::Vector<int, subDim>& index, real* r) {
+		int k = index(0) + level.ctx.sizev(0) * (index(1) + level.ctx.sizev(1) * index(2));
+		const MetricPrims& metricPrims = level.metricPrimGrid.v[k];
+		TensorSL& gLL = level.ws.gLLs.v[k];
+		TensorSU& gUU = level.ws.gUUs.v[k];
+		calc_gLL_and_gUU(metricPrims, gLL, gUU);
+		calc_GammaULL<true>(level.ws, index);
+		//differencing Gamma^a_bc reads it along the axes, where it depends on this cell's g_ab too
+		if (dGamma == DGammaPath::Gamma) {
+			for (int i = 0; i < subDim; ++i) {
+				for (int offset = -partialDerivativeOrder / 2; offset <= partialDerivativeOrder / 2; ++offset) {
+					Tensor::Vector<int, subDim> neighbor = index;
+					neighbor(i) += offset;
+					if (offset == 0 || neighbor(i) < 0 || neighbor(i) >= level.ctx.sizev(i)) continue;
+					calc_GammaULL<true>(level.ws, neighbor);
+				}
+			}
+		}
+		TensorSL EinsteinLL = calc_EinsteinLL<true, einstein, dGamma>(level.ws, index);
+		TensorSL _8piTLL = calc_8piTLL(level.ctx, metricPrims, gLL, gUU, level.stressEnergyPrimGrid, k);
+		const TensorSL& tau = level.tauGrid.v[k];
+		int j = 0;
+		for (int a = 0; a < dim; ++a) {
+			for (int b = 0; b <= a; ++b, ++j) {
+				r[j] = EinsteinLL(a,b) - _8piTLL(a,b) - tau(a,b);
+			}
+		}
+	}
+
+	//one Newton step on a cell's 10 unknowns, backtracking if it doesn't help
+	template<EinsteinPath einstein, DGammaPath dGamma>
+	void relaxCell(Level& level, const Tensor::Vector<int, subDim>& index) {
+		const int m = sizeof(MetricPrims) / sizeof(real);
+		real* x = (real*)&level.metricPrimGrid(index);
+		real r0[m], r[m], J[m * m], d[m], x0[m];
+		calcCellResidual<einstein, dGamma>(level, index, r0);
+		real r0Norm = Solver::Vector<real>::normL2(m, r0);
+		if (r0Norm == 0) return;
+		for (int j = 0; j < m; ++j) {
+			x0[j] = x[j];
+		}
+		for (int j = 0; j < m; ++j) {
+			x[j] += jacobianEpsilon;
+			calcCellResidual<einstein, dGamma>(level, index, r);
+			x[j] = x0[j];
+			for (int i = 0; i < m; ++i) {
+				J[i + m * j] = (r[i] - r0[i]) / jacobianEpsilon;
+			}
+		}
+		solveDense(m, J, r0, d);
+		real alpha = 1;
+		bool accepted = false;
+		for (int tries = 0; tries < 4; ++tries, alpha *= .5) {
+			for (int j = 0; j < m; ++j) {
+				x[j] = x0[j] - alpha * d[j];
+			}
+			calcCellResidual<einstein, dGamma>(level, index, r);
+			real rNorm = Solver::Vector<real>::normL2(m, r);
+			if (std::isfinite(rNorm) && rNorm < r0Norm) {
+				accepted = true;
+				break;
+			}
+		}
+		if (!accepted) {
+			for (int j = 0; j < m; ++j) {
+				x[j] = x0[j];
+			}
+			calcCellResidual<einstein, dGamma>(level, index, r);
+		}
+	}
+
+	//colored nonlinear Gauss-Seidel
+	void smooth(Level& level, int sweeps) {
+		calc_gLLs_and_gUUs<true>(level.metricPrimGrid, level.dt_metricPrimGrid, level.ws);
+		dispatchEinsteinPath(level.ctx, [&](auto einstein, auto dGamma) {
+			for (int sweep = 0; sweep < sweeps; ++sweep) {
+				for (std::vector<Tensor::Vector<int, subDim>>& color : level.colors) {
+					//the mixed 2nd derivatives at a cell come from g_ab,c of its neighbors, which the last color moved
+					calc_GammaULLs<true>(level.ws);
+					level.ws.parallel->foreach(color.begin(), color.end(), [&](const Tensor::Vector<int, subDim>& index) {
+						relaxCell<decltype(einstein)::value, decltype(dGamma)::value>(level, index);
+					});
+				}
+			}
+		});
+	}
+
+	void vcycle(int l) {
+		Level& level = *levels[l];
+		if (l == (int)levels.size() - 1) {
+			smooth(level, coarsestSweeps);
+			return;
+		}
+		Level& coarse = *levels[l+1];
+		smooth(level, preSweeps);
+		calcLevelResidual(level);	//EFEGrid = F - tau
+		real residual = Solver::Vector<real>::normL2(10 * level.ctx.gridVolume, (const real*)level.EFEGrid.v);
+		
+		//x_coarse = R x_fine, tau_coarse = F_coarse(x_coarse) - R (F_fine - tau_fine)
+		restrictGrid(ctx.parallel, coarse.metricPrimGrid, level.metricPrimGrid, coarse.ctx.sizev);
+		std::copy(coarse.metricPrimGrid.v, coarse.metricPrimGrid.v + coarse.ctx.gridVolume, coarse.restrictedMetricPrimGrid.v);
+		restrictGrid(ctx.parallel, coarse.tauGrid, level.EFEGrid, coarse.ctx.sizev);
+		calcF((real*)coarse.EFEGrid.v, (const real*)coarse.metricPrimGrid.v, coarse.dt_metricPrimGrid, coarse.stressEnergyPrimGrid, coarse.ws);
+		for (int k = 0; k < coarse.ctx.gridVolume; ++k) {
+			for (int a = 0; a < dim; ++a) {
+				for (int b = 0; b <= a; ++b) {
+					coarse.tauGrid.v[k](a,b) = coarse.EFEGrid.v[k](a,b) - coarse.tauGrid.v[k](a,b);
+				}
+			}
+		}
+		
+		vcycle(l+1);
+
+		//x_fine += omega P (x_coarse - R x_fine)
+		const int numReals = 10 * level.ctx.gridVolume;
+		for (int k = 0; k < coarse.ctx.gridVolume; ++k) {
+			real* dst = (real*)&coarse.restrictedMetricPrimGrid.v[k];
+			const real* src = (const real*)&coarse.metricPrimGrid.v[k];
+			for (int j = 0; j < (int)(sizeof(MetricPrims) / sizeof(real)); ++j) {
+				dst[j] = src[j] - dst[j];
+			}
+		}
+		std::fill((real*)level.correctionGrid.v, (real*)level.correctionGrid.v + numReals, 0);
+		prolongAddGrid(ctx.parallel, level.correctionGrid, coarse.restrictedMetricPrimGrid, level.ctx.sizev, coarse.ctx.sizev);
+		
+		//the EFE aren't elliptic in every component, so the coarse grid can suggest things the fine grid doesn't want
+		//halve the correction until it reduces the fine residual, or drop it
+		real* x = (real*)level.metricPrimGrid.v;
+		real* x0 = (real*)level.savedMetricPrimGrid.v;
+		const real* dx = (const real*)level.correctionGrid.v;
+		std::copy(x, x + numReals, x0);
+		bool accepted = false;
+		real omega = 1;
+		for (int i = 0; i < correctionMaxHalvings; ++i, omega *= .5) {
+			for (int j = 0; j < numReals; ++j) {
+				x[j] = x0[j] + omega * dx[j];
+			}
+			calcLevelResidual(level);
+			real newResidual = Solver::Vector<real>::normL2(numReals, (const real*)level.EFEGrid.v);
+			if (std::isfinite(newResidual) && newResidual < residual) {
+				accepted = true;
+				break;
+			}
+		}
+		if (!accepted) {
+			std::copy(x0, x0 + numReals, x);
+		}
+		
+		smooth(level, postSweeps);
+	}
+
+	virtual void solve(
+		//input/output
+		Tensor::Grid<MetricPrims, subDim>& metricPrimGrid,
+		//input
+		const Tensor::Grid<MetricPrims, subDim>& dt_metricPrimGrid,	//first deriv
+		const Tensor::Grid<StressEnergyPrims, subDim>& stressEnergyPrimGrid
+	) {
+		if (!ctx.isStationary) {
+			throw Common::Exception() << "fas only handles stationary metrics";
+		}
+		if (ctx.useChargeCurrentForEM) {
+			throw Common::Exception() << "fas doesn't restrict A^a, so it doesn't work with useChargeCurrentForEM";
+		}
+
+		std::ofstream fasFile("fas.txt");
+		fasFile << "#iter residual" << std::endl;
+
+		time("building fas levels", [&]{
+			buildLevels(metricPrimGrid, stressEnergyPrimGrid);
+		});
+		Level& finest = *levels[0];
+		std::copy(metricPrimGrid.v, metricPrimGrid.v + ctx.gridVolume, finest.metricPrimGrid.v);
+		
+		time("solving", [&]{
+			for (int iter = 0; iter < maxiter; ++iter) {
+				vcycle(0);
+				
+				calcLevelResidual(finest);
+				real residual = Solver::Vector<real>::normL2(getN(), (const real*)finest.EFEGrid.v);
+				std::cout << "fas"
+					<< " iter=" << iter
+					<< " residual=" << std::setprecision(49) << residual << std::setprecision(6)
+					<< std::endl;
+				fasFile << iter << "\t" << std::setprecision(16) << residual << std::setprecision(6) << std::endl;
+				if (residual <= stopEpsilon || !std::isfinite(residual)) break;
+			}
+		});
+
+		std::copy(finest.metricPrimGrid.v, finest.metricPrimGrid.v + ctx.gridVolume, metricPrimGrid.v);
+		fasFile.close();
+	}
+};
+
+/*
+geometric multigrid for lap u = f on a cell-centered grid, 7-point Laplacian,
+ with Dirichlet values given one cell outside of the grid (folded into f on the finest level, zero on the coarse ones)
+coarsens while every axis is even and at least 4, using restrictGrid() and prolongAddGrid()
+red-black Gauss-Seidel smoothing, and coarseSweeps of it on the coarsest level
+*/
+struct PoissonMultigrid {
+	Parallel::Parallel* parallel;
+	int preSmooth = 2;
+	int postSmooth = 2;
+	int coarseSweeps = 50;
+
+	struct Level {
+		Tensor::Vector<int, subDim> sizev;
+		Tensor::Vector<real, subDim> dx;
+		Tensor::Grid<real, subDim> u, f, r;
+		std::vector<Tensor::Vector<int, subDim>> colors[2];
+	};
+	std::vector<std::shared_ptr<Level>> levels;
+
+	PoissonMultigrid(Parallel::Parallel* parallel_, Tensor::Vector<int, subDim> levelSizev, Tensor::Vector<real, subDim> levelDx) : parallel(parallel_) {
+		for (;;) {
+			std::shared_ptr<Level> level = std::make_shared<Level>();
+			level->sizev = levelSizev;
+			level->dx = levelDx;
+			level->u.resize(levelSizev);
+			level->f.resize(levelSizev);
+			level->r.resize(levelSizev);
+			Tensor::RangeObj<subDim> range(Tensor::Vector<int,subDim>(), levelSizev);
+			for (const Tensor::Vector<int, subDim>& index : range) {
+				level->colors[(index(0) + index(1) + index(2)) & 1].push_back(index);
+			}
+			levels.push_back(level);
+
+			bool canCoarsen = true;
+			for (int i = 0; i < subDim; ++i) {
+				if (levelSizev(i) % 2 != 0 || levelSizev(i) < 4) canCoarsen = false;
+			}
+			if (!canCoarsen) break;
+			for (int i = 0; i < subDim; ++i) {
+				levelSizev(i) /= 2;
+				levelDx(i) *= 2;
+			}
+		}
+	}
+
+	//sum of the neighbors / dx^2, with zero outside the grid
+	static real neighborSum(const Level& level, const Tensor::Vector<int, subDim>& index) {
+		real sum = 0;
+		for (int i = 0; i < subDim; ++i) {
+			real invDxSq = 1. / (level.dx(i) * level.dx(i));
+			Tensor::Vector<int, subDim> neighbor = index;
+			if (index(i) > 0) {
+				neighbor(i) = index(i) - 1;
+				sum += level.u(neighbor) * invDxSq;
+			}
+			if (index(i) < level.sizev(i) - 1) {
+				neighbor(i) = index(i) + 1;
+				sum += level.u(neighbor) * invDxSq;
+			}
+		}
+		return sum;
+	}
+
+	static real diagonal(const Level& level) {
+		real sum = 0;
+		for (int i = 0; i < subDim; ++i) {
+			sum += 2. / (level.dx(i) * level.dx(i));
+		}
+		return sum;
+	}
+
+	void smooth(Level& level, int sweeps) {
+		real diag = diagonal(level);
+		for (int sweep = 0; sweep < sweeps; ++sweep) {
+			for (std::vector<Tensor::Vector<int, subDim>>& color : level.colors) {
+				parallel->foreach(color.begin(), color.end(), [&](const Tensor::Vector<int, subDim>& index) {
+					level.u(index) = (neighborSum(level, index) - level.f(index)) / diag;
+				});
+			}
+		}
+	}
+
+	//r = f - lap u, returns |r|
+	real calcResidual(Level& level) {
+		real diag = diagonal(level);
+		Tensor::RangeObj<subDim> range(Tensor::Vector<int,subDim>(), level.sizev);
+		parallel->foreach(range.begin(), range.end(), [&](const Tensor::Vector<int, subDim>& index) {
+			level.r(index) = level.f(index) - (neighborSum(level, index) - diag * level.u(index));
+		});
+		return Solver::Vector<real>::normL2(level.sizev.volume(), level.r.v);
+	}
+
+	void vcycle(int l) {
+		Level& level = *levels[l];
+		if (l == (int)levels.size() - 1) {
+			smooth(level, coarseSweeps);
+			return;
+		}
+		Level& coarse = *levels[l+1];
+		smooth(level, preSmooth);
+		calcResidual(level);
+		restrictGrid(parallel, coarse.f, level.r, coarse.sizev);
+		std::fill(coarse.u.v, coarse.u.v + coarse.sizev.volume(), 0);
+		vcycle(l+1);
+		prolongAddGrid(parallel, level.u, coarse.u, level.sizev, coarse.sizev);
+		smooth(level, postSmooth);
+	}
+
+	/*
+	solves lap u = f on the finest level, for u = boundary(x) one cell outside of the grid, where x is relative to xmin
+	u holds the initial guess, and gets the result
+	returns |f - lap u| / |f|
+	*/
+	real solve(
+		Tensor::Grid<real, subDim>& u,
+		const Tensor::Grid<real, subDim>& f,
+		std::function<real(const Tensor::Vector<real, subDim>&)> boundary,
+		real tolerance,
+		int maxCycles
+	) {
+		Level& finest = *levels[0];
+		Tensor::RangeObj<subDim> range(Tensor::Vector<int,subDim>(), finest.sizev);
+		parallel->foreach(range.begin(), range.end(), [&](const Tensor::Vector<int, subDim>& index) {
+			finest.u(index) = u(index);
+			real fi = f(index);
+			for (int i = 0; i < subDim; ++i) {
+				for (int side = -1; side <= 1; side += 2) {
+					if (index(i) + side >= 0 && index(i) + side < finest.sizev(i)) continue;
+					Tensor::Vector<real, subDim> x;
+					for (int j = 0; j < subDim; ++j) {
+						x(j) = ((real)index(j) + .5 + (j == i ? side : 0)) * finest.dx(j);
+					}
+					fi -= boundary(x) / (finest.dx(i) * finest.dx(i));
+				}
+			}
+			finest.f(index) = fi;
+		});
+		real fNorm = Solver::Vector<real>::normL2(finest.sizev.volume(), finest.f.v);
+		real residual = 0;
+		for (int cycle = 0; cycle < maxCycles; ++cycle) {
+			residual = fNorm > 0 ? calcResidual(finest) / fNorm : 0;
+			if (residual < tolerance) break;
+			vcycle(0);
+		}
+		residual = fNorm > 0 ? calcResidual(finest) / fNorm : 0;
+		std::copy(finest.u.v, finest.u.v + finest.sizev.volume(), u.v);
+		return residual;
+	}
+
+	//solve() for u falling off as -Q / (4 pi r) outside of the grid, for Q = int f dV and r from the grid center
+	real solveMonopole(
+		Tensor::Grid<real, subDim>& u,
+		const Tensor::Grid<real, subDim>& f,
+		real tolerance,
+		int maxCycles
+	) {
+		const Level& finest = *levels[0];
+		Tensor::Vector<real, subDim> center;
+		for (int i = 0; i < subDim; ++i) {
+			center(i) = .5 * finest.sizev(i) * finest.dx(i);
+		}
+		real Q = 0;
+		for (int k = 0; k < finest.sizev.volume(); ++k) {
+			Q += f.v[k];
+		}
+		Q *= finest.dx.volume();
+		return solve(u, f, [&](const Tensor::Vector<real, subDim>& x) -> real {
+			return -Q / (4. * M_PI * (x - center).length());
+		}, tolerance, maxCycles);
+	}
+};
+
+/*
+weak-field gravity: linearize g_ab = eta_ab + h_ab about flat space
+in the Lorenz gauge the trace-reversed hBar_ab = h_ab - 1/2 eta_ab h obeys box hBar_ab = -16 pi T_ab,
+ so for a stationary metric that is ten decoupled Poisson equations, lap hBar_ab = -2 (8 pi T_ab), with T_ab taken on flat space
+each is solved with PoissonMultigrid, with the monopole -Q / (4 pi r) of its source Q = int f dV outside of the grid
+then h_ab = hBar_ab - 1/2 eta_ab hBar, and alpha, beta, gamma are read back out of eta_ab + h_ab
+for static dust that is alpha - 1 = Phi and gamma_ij = (1 - 2 Phi) delta_ij, for lap Phi = 4 pi rho
+the full nonlinear EFE residual of the result is printed at the end, next to that of the metric it started from
+*/
+struct LinearizedSolver : public EFESolver {
+	using Super = EFESolver;
+	using Super::Super;
+
+	real tolerance = 1e-12;	//of each Poisson solve, relative to its source
+	int maxCycles = 50;
+
+	virtual void solve(
+		//input/output
+		Tensor::Grid<MetricPrims, subDim>& metricPrimGrid,
+		//input
+		const Tensor::Grid<MetricPrims, subDim>& dt_metricPrimGrid,	//first deriv
+		const Tensor::Grid<StressEnergyPrims, subDim>& stressEnergyPrimGrid
+	) {
+		if (!ctx.isStationary) throw Common::Exception() << "the linearized solver needs a stationary metric";
+
+		printResidual("linearized initial", metricPrimGrid, dt_metricPrimGrid, stressEnergyPrimGrid);
+
+		//8 pi T_ab on flat space
+		TensorSL eta;
+		eta(0,0) = -1;
+		for (int i = 0; i < subDim; ++i) {
+			eta(i+1,i+1) = 1;
+		}
+		Tensor::Grid<MetricPrims, subDim> flatMetricPrimGrid(ctx.sizev);
+		std::fill(flatMetricPrimGrid.v, flatMetricPrimGrid.v + ctx.gridVolume, MetricPrims());
+		if (ctx.useChargeCurrentForEM) {
+			update_EMFields(*ctx.workspace, flatMetricPrimGrid, dt_metricPrimGrid, stressEnergyPrimGrid);
+		}
+		Tensor::Grid<TensorSL, subDim> _8piTLLs(ctx.sizev);
+		{
+			TensorSU etaU;
+			for (int a = 0; a < dim; ++a) {
+				etaU(a,a) = eta(a,a);
+			}
+			Tensor::RangeObj<subDim> range(Tensor::Vector<int,subDim>(), ctx.sizev);
+			ctx.parallel->foreach(range.begin(), range.end(), [&](const Tensor::Vector<int, subDim>& index) {
+				int k = index(0) + ctx.sizev(0) * (index(1) + ctx.sizev(1) * index(2));
+				_8piTLLs.v[k] = calc_8piTLL(ctx, flatMetricPrimGrid.v[k], eta, etaU, stressEnergyPrimGrid, k);
+			});
+		}
+
+		//lap hBar_ab = -2 8piT_ab
+		Tensor::Grid<TensorSL, subDim> hBarLLs(ctx.sizev);
+		std::fill(hBarLLs.v, hBarLLs.v + ctx.gridVolume, TensorSL());
+		PoissonMultigrid multigrid(ctx.parallel, ctx.sizev, ctx.dx);
+		Tensor::Grid<real, subDim> u(ctx.sizev), f(ctx.sizev);
+		time("solving the linearized EFE", [&]{
+			for (int a = 0; a < dim; ++a) {
+				for (int b = 0; b <= a; ++b) {
+					bool hasSource = false;
+					for (int k = 0; k < ctx.gridVolume; ++k) {
+						f.v[k] = -2. * _8piTLLs.v[k](a,b);
+						u.v[k] = 0;
+						hasSource |= f.v[k] != 0;
+					}
+					if (!hasSource) continue;
+					real residual = multigrid.solveMonopole(u, f, tolerance, maxCycles);
+					std::cout << "hBar_" << a << b << " poisson residual=" << residual << std::endl;
+					for (int k = 0; k < ctx.gridVolume; ++k) {
+						hBarLLs.v[k](a,b) = u.v[k];
+					}
+				}
+			}
+		});
+
+		//h_ab = hBar_ab - 1/2 eta_ab hBar, then g_ab = eta_ab + h_ab into alpha, beta, gamma
+		//a source too strong for the weak-field limit can leave g_ab without a lapse or a positive spatial metric
+		std::vector<char> degenerate(ctx.gridVolume);
+		ctx.parallel->foreach(metricPrimGrid.v, metricPrimGrid.v + ctx.gridVolume, [&](MetricPrims& metricPrims) {
+			int k = &metricPrims - metricPrimGrid.v;
+			const TensorSL& hBarLL = hBarLLs.v[k];
+			real hBar = 0;
+			for (int a = 0; a < dim; ++a) {
+				hBar += eta(a,a) * hBarLL(a,a);
+			}
+			TensorSL hLL;
+			for (int a = 0; a < dim; ++a) {
+				for (int b = 0; b <= a; ++b) {
+					hLL(a,b) = hBarLL(a,b) - .5 * eta(a,b) * hBar;
+				}
+			}
+			TensorSLsub gammaLL;
+			for (int i = 0; i < subDim; ++i) {
+				for (int j = 0; j <= i; ++j) {
+					metricPrims.hLL(i,j) = hLL(i+1,j+1);
+					gammaLL(i,j) = delta3LL(i,j) + hLL(i+1,j+1);
+				}
+			}
+			real detGamma = Tensor::determinant33<real, TensorSLsub>(gammaLL);
+			TensorSUsub gammaUU = inverse(gammaLL);
+			real betaSq = 0;
+			for (int i = 0; i < subDim; ++i) {
+				real sum = 0;
+				for (int j = 0; j < subDim; ++j) {
+					sum += gammaUU(i,j) * hLL(j+1,0);
+				}
+				metricPrims.betaU(i) = sum;
+				betaSq += sum * hLL(i+1,0);
+			}
+			//alpha^2 = -g_tt + beta^2, and alpha - 1 = (alpha^2 - 1) / (alpha + 1) keeps the digits of a small perturbation
+			real alphaSqMinusOne = -hLL(0,0) + betaSq;
+			degenerate[k] = !(detGamma > 0 && 1. + alphaSqMinusOne > 0);
+			metricPrims.alphaMinusOne = alphaSqMinusOne / (sqrt(1. + alphaSqMinusOne) + 1.);
+		});
+		int numDegenerate = std::count(degenerate.begin(), degenerate.end(), 1);
+		if (numDegenerate) throw Common::Exception() << "the linearized metric is degenerate at " << numDegenerate << " cells -- the source is too strong for the weak-field limit";
+
+		printResidual("linearized final", metricPrimGrid, dt_metricPrimGrid, stressEnergyPrimGrid);
+	}
+};
+
+/*
+conformally flat condition (CFC), the stationary limit of the conformal thin sandwich with maximal slicing:
+gamma_ij = psi^4 delta_ij, and K_ij = psi^4 / (2 alpha) (L beta)_ij for (L beta)^ij = d^i beta^j + d^j beta^i - 2/3 delta^ij d_k beta^k
+then the Hamiltonian constraint, the slicing condition and the momentum constraint become flat-space Poisson equations:
+	lap psi = -2 pi psi^5 E - psi^5 K_ij K^ij / 8
+	lap (alpha psi) = alpha psi (2 pi psi^4 (E + 2 S) + 7/8 psi^4 K_ij K^ij)
+	lap beta^i + 1/3 d^i d_j beta^j = 16 pi alpha S_i + 2 Ahat^ij d_j (alpha psi^-6), for Ahat^ij = psi^6 / (2 alpha) (L beta)^ij
+with E = n^a n^b T_ab, S_i = -n^a T_ai, S = gamma^ij T_ij, all taken on the current metric
+each right hand side (and the grad-div term) lags one iteration behind, and each solve is a PoissonMultigrid with monopole boundaries
+the result goes back into the MetricPrims: alpha = (alpha psi) / psi, beta^i, h_ij = (psi^4 - 1) delta_ij
+*/
+struct CFCSolver : public EFESolver {
+	using Super = EFESolver;
+	using Super::Super;
+
+	real tolerance = 1e-10;	//stop once nothing moves by more than this, relative to the largest of psi - 1, alpha psi - 1, beta
+	real poissonTolerance = 1e-12;
+	int maxCycles = 50;
+
+	//d/dx^i of u, centered, and one-sided 2nd order at the edges
+	real partial(const Tensor::Grid<real, subDim>& u, const Tensor::Vector<int, subDim>& index, int i) {
+		Tensor::Vector<int, subDim> a = index, b = index, c = index;
+		if (index(i) == 0) {
+			b(i) = 1;
+			c(i) = 2;
+			return (-3. * u(a) + 4. * u(b) - u(c)) / (2. * ctx.dx(i));
+		}
+		if (index(i) == ctx.sizev(i) - 1) {
+			b(i) = index(i) - 1;
+			c(i) = index(i) - 2;
+			return (3. * u(a) - 4. * u(b) + u(c)) / (2. * ctx.dx(i));
+		}
+		a(i) = index(i) + 1;
+		b(i) = index(i) - 1;
+		return (u(a) - u(b)) / (2. * ctx.dx(i));
+	}
+
+	virtual void solve(
+		//input/output
+		Tensor::Grid<MetricPrims, subDim>& metricPrimGrid,
+		//input
+		const Tensor::Grid<MetricPrims, subDim>& dt_metricPrimGrid,	//first deriv
+		const Tensor::Grid<StressEnergyPrims, subDim>& stressEnergyPrimGrid
+	) {
+		if (!ctx.isStationary) throw Common::Exception() << "the CFC solver needs a stationary metric";
+		for (int i = 0; i < subDim; ++i) {
+			if (ctx.sizev(i) < 3) throw Common::Exception() << "the CFC solver needs at least 3 cells along each axis";
+		}
+
+		printResidual("cfc initial", metricPrimGrid, dt_metricPrimGrid, stressEnergyPrimGrid);
+
+		//psi - 1, alpha psi - 1, beta^i
+		Tensor::Grid<real, subDim> psiMinusOne(ctx.sizev), alphaPsiMinusOne(ctx.sizev);
+		Tensor::Grid<real, subDim> betaU[subDim] = {ctx.sizev, ctx.sizev, ctx.sizev};
+
+		//start from the conformal part of the metric we were given
+		ctx.parallel->foreach(metricPrimGrid.v, metricPrimGrid.v + ctx.gridVolume, [&](const MetricPrims& metricPrims) {
+			int k = &metricPrims - metricPrimGrid.v;
+			TensorSLsub gammaLL;
+			for (int i = 0; i < subDim; ++i) {
+				for (int j = 0; j <= i; ++j) {
+					gammaLL(i,j) = delta3LL(i,j) + metricPrims.hLL(i,j);
+				}
+			}
+			real psi = pow(Tensor::determinant33<real, TensorSLsub>(gammaLL), 1./12.);
+			psiMinusOne.v[k] = psi - 1.;
+			alphaPsiMinusOne.v[k] = (metricPrims.alphaMinusOne + 1.) * psi - 1.;
+			for (int i = 0; i < subDim; ++i) {
+				betaU[i].v[k] = metricPrims.betaU(i);
+			}
+		});
+
+		auto writeMetricPrims = [&]() {
+			ctx.parallel->foreach(metricPrimGrid.v, metricPrimGrid.v + ctx.gridVolume, [&](MetricPrims& metricPrims) {
+				int k = &metricPrims - metricPrimGrid.v;
+				real phi = psiMinusOne.v[k];
+				//psi^4 - 1 and alpha - 1 without subtracting ones from each other
+				real psi4MinusOne = phi * (4. + phi * (6. + phi * (4. + phi)));
+				metricPrims.alphaMinusOne = (alphaPsiMinusOne.v[k] - phi) / (1. + phi);
+				for (int i = 0; i < subDim; ++i) {
+					metricPrims.betaU(i) = betaU[i].v[k];
+					for (int j = 0; j <= i; ++j) {
+						metricPrims.hLL(i,j) = i == j ? psi4MinusOne : 0;
+					}
+				}
+			});
+		};
+
+		PoissonMultigrid multigrid(ctx.parallel, ctx.sizev, ctx.dx);
+		Tensor::Grid<real, subDim> E(ctx.sizev), S(ctx.sizev), KSq(ctx.sizev), divBeta(ctx.sizev), alphaPsiToTheMinus6(ctx.sizev);
+		Tensor::Grid<TensorSLsub, subDim> LBetaUU(ctx.sizev);
+		Tensor::Grid<TensorLsub, subDim> SL(ctx.sizev);
+		Tensor::Grid<real, subDim> f(ctx.sizev), u(ctx.sizev);
+		Tensor::Grid<real, subDim> lastPsiMinusOne(ctx.sizev), lastAlphaPsiMinusOne(ctx.sizev);
+		Tensor::Grid<real, subDim> lastBetaU[subDim] = {ctx.sizev, ctx.sizev, ctx.sizev};
+		Tensor::RangeObj<subDim> range(Tensor::Vector<int,subDim>(), ctx.sizev);
+
+		time("solving the CFC equations", [&]{
+			for (int iter = 0; iter < maxiter; ++iter) {
+				writeMetricPrims();
+				if (ctx.useChargeCurrentForEM) {
+					update_EMFields(*ctx.workspace, metricPrimGrid, dt_metricPrimGrid, stressEnergyPrimGrid);
+				}
+
+				//matter projections and (L beta)^ij at the current metric
+				ctx.parallel->foreach(range.begin(), range.end(), [&](const Tensor::Vector<int, subDim>& index) {
+					int k = index(0) + ctx.sizev(0) * (index(1) + ctx.sizev(1) * index(2));
+					const MetricPrims& metricPrims = metricPrimGrid.v[k];
+					TensorSL gLL;
+					TensorSU gUU;
+					calc_gLL_and_gUU(metricPrims, gLL, gUU);
+					TensorSL _8piTLL = calc_8piTLL(ctx, metricPrims, gLL, gUU, stressEnergyPrimGrid, k);
+					real alpha = metricPrims.alphaMinusOne + 1.;
+					real psi = psiMinusOne.v[k] + 1.;
+					real psiSq = psi * psi;
+					const TensorUsub& beta = metricPrims.betaU;
+
+					real _8piE = _8piTLL(0,0);
+					real _8piS = 0;
+					for (int i = 0; i < subDim; ++i) {
+						_8piE -= 2. * beta(i) * _8piTLL(i+1,0);
+						real _8piTbeta = 0;
+						for (int j = 0; j < subDim; ++j) {
+							_8piE += beta(i) * beta(j) * _8piTLL(i+1,j+1);
+							_8piTbeta += _8piTLL(i+1,j+1) * beta(j);
+						}
+						SL.v[k](i) = -(_8piTLL(i+1,0) - _8piTbeta) / (alpha * 8. * M_PI);
+						_8piS += _8piTLL(i+1,i+1);
+					}
+					E.v[k] = _8piE / (alpha * alpha * 8. * M_PI);
+					S.v[k] = _8piS / (psiSq * psiSq * 8. * M_PI);
+
+					TensorLsub dBeta[subDim];	//dBeta[i](j) = d_i beta^j
+					real div = 0;
+					for (int i = 0; i < subDim; ++i) {
+						for (int j = 0; j < subDim; ++j) {
+							dBeta[i](j) = partial(betaU[j], index, i);
+						}
+						div += dBeta[i](i);
+					}
+					real LBetaSq = 0;
+					for (int i = 0; i < subDim; ++i) {
+						for (int j = 0; j <= i; ++j) {
+							real LBeta = dBeta[i](j) + dBeta[j](i) - (i == j ? 2./3. * div : 0.);
+							LBetaUU.v[k](i,j) = LBeta;
+							LBetaSq += (i == j ? 1. : 2.) * LBeta * LBeta;
+						}
+					}
+					divBeta.v[k] = div;
+					KSq.v[k] = LBetaSq / (4. * alpha * alpha);
+					alphaPsiToTheMinus6.v[k] = alpha / (psiSq * psiSq * psiSq);
+				});
+
+				std::copy(psiMinusOne.v, psiMinusOne.v + ctx.gridVolume, lastPsiMinusOne.v);
+				std::copy(alphaPsiMinusOne.v, alphaPsiMinusOne.v + ctx.gridVolume, lastAlphaPsiMinusOne.v);
+				for (int i = 0; i < subDim; ++i) {
+					std::copy(betaU[i].v, betaU[i].v + ctx.gridVolume, lastBetaU[i].v);
+				}
+				auto solveFor = [&](Tensor::Grid<real, subDim>& x, std::function<real(const Tensor::Vector<int, subDim>&, int)> rhs) {
+					ctx.parallel->foreach(range.begin(), range.end(), [&](const Tensor::Vector<int, subDim>& index) {
+						int k = index(0) + ctx.sizev(0) * (index(1) + ctx.sizev(1) * index(2));
+						f.v[k] = rhs(index, k);
+					});
+					std::copy(x.v, x.v + ctx.gridVolume, u.v);
+					multigrid.solveMonopole(u, f, poissonTolerance, maxCycles);
+					std::copy(u.v, u.v + ctx.gridVolume, x.v);
+				};
+
+				solveFor(psiMinusOne, [&](const Tensor::Vector<int, subDim>& index, int k) -> real {
+					real psi = lastPsiMinusOne.v[k] + 1.;
+					real psi5 = psi * psi * psi * psi * psi;
+					return -psi5 * (2. * M_PI * E.v[k] + KSq.v[k] / 8.);
+				});
+
+				solveFor(alphaPsiMinusOne, [&](const Tensor::Vector<int, subDim>& index, int k) -> real {
+					real psi = lastPsiMinusOne.v[k] + 1.;
+					real psi4 = psi * psi * psi * psi;
+					return (lastAlphaPsiMinusOne.v[k] + 1.) * psi4 * (2. * M_PI * (E.v[k] + 2. * S.v[k]) + 7./8. * KSq.v[k]);
+				});
+
+				for (int i = 0; i < subDim; ++i) {
+					solveFor(betaU[i], [&](const Tensor::Vector<int, subDim>& index, int k) -> real {
+						real alpha = (lastAlphaPsiMinusOne.v[k] + 1.) / (lastPsiMinusOne.v[k] + 1.);
+						real psi = lastPsiMinusOne.v[k] + 1.;
+						real psi6 = psi * psi * psi * psi * psi * psi;
+						real AhatDAlphaPsi = 0;
+						for (int j = 0; j < subDim; ++j) {
+							AhatDAlphaPsi += psi6 / (2. * alpha) * LBetaUU.v[k](i,j) * partial(alphaPsiToTheMinus6, index, j);
+						}
+						return 16. * M_PI * alpha * SL.v[k](i) + 2. * AhatDAlphaPsi - partial(divBeta, index, i) / 3.;
+					});
+				}
+
+				real change = 0, scale = 0;
+				for (int k = 0; k < ctx.gridVolume; ++k) {
+					change = std::max(change, (real)fabs(psiMinusOne.v[k] - lastPsiMinusOne.v[k]));
+					change = std::max(change, (real)fabs(alphaPsiMinusOne.v[k] - lastAlphaPsiMinusOne.v[k]));
+					scale = std::max(scale, (real)std::max(fabs(psiMinusOne.v[k]), fabs(alphaPsiMinusOne.v[k])));
+					for (int i = 0; i < subDim; ++i) {
+						change = std::max(change, (real)fabs(betaU[i].v[k] - lastBetaU[i].v[k]));
+						scale = std::max(scale, (real)fabs(betaU[i].v[k]));
+					}
+				}
+				std::cout << "cfc iteration " << iter << " change=" << change << " scale=" << scale << std::endl;
+				if (!std::isfinite(change)) throw Common::Exception() << "the CFC iteration diverged";
+				if (change <= tolerance * scale) break;
+			}
+		});
+
+		writeMetricPrims();
+		printResidual("cfc final", metricPrimGrid, dt_metricPrimGrid, stressEnergyPrimGrid);
+	}
+};
+
+/*
+mass continuation: solve with the sources scaled by lambda, stepping lambda from 0 up to 1
+rho and P scale by lambda, and E and B (or the charge and current) by sqrt(lambda), so every T_ab scales by lambda
+lambda = 0 starts at the incoming metric, so the init cond and any warm start carry over,
+ or at flat space with flatStart, which solves lambda = 0 exactly but throws those away
+each step starts 'inner' from the secant through the last two solutions, which is exact while the response is linear
+ (until there are two, from the last one)
+a step that leaves the residual above the predictor's (past roundoff), or not finite, is thrown out and retried at half the size
+a step that takes no more F evaluations than the first one did doubles the step size, and one that takes over twice as many halves it
+*/
+struct ContinuationSolver : public EFESolver {
+	using Super = EFESolver;
+
+	std::shared_ptr<EFESolver> inner;
+	real step;
+	real minStep = 1e-6;
+	int maxSteps = 1000;
+	real maxResidualGrowth = 1e-3;	//relative to the predictor's residual.  past the discretization error the solver can only hold it steady
+	bool flatStart;
+
+	ContinuationSolver(std::shared_ptr<EFESolver> inner_, real step_, bool flatStart_)
+	: Super(inner_->ctx, inner_->maxiter), inner(inner_), step(step_), flatStart(flatStart_) {
+		dirtyRegions = inner->dirtyRegions;
+	}
+
+	void scaleStressEnergyPrims(
+		//output
+		Tensor::Grid<StressEnergyPrims, subDim>& dstGrid,
+		//input
+		const Tensor::Grid<StressEnergyPrims, subDim>& srcGrid,
+		real lambda
+	) {
+		real sqrtLambda = sqrt(lambda);
+		ctx.parallel->foreach(dstGrid.v, dstGrid.v + ctx.gridVolume, [&](StressEnergyPrims& dst) {
+			dst = srcGrid.v[&dst - dstGrid.v];
+			dst.rho *= lambda;
+			dst.P *= lambda;
+			dst.chargeDensity *= sqrtLambda;
+			dst.currentDensity *= sqrtLambda;
+			dst.E *= sqrtLambda;
+			dst.B *= sqrtLambda;
+		});
+	}
+
+	virtual void solve(
+		//input/output
+		Tensor::Grid<MetricPrims, subDim>& metricPrimGrid,
+		//input
+		const Tensor::Grid<MetricPrims, subDim>& dt_metricPrimGrid,	//first deriv
+		const Tensor::Grid<StressEnergyPrims, subDim>& stressEnergyPrimGrid
+	) {
+		const int n = (int)getN();
+		Tensor::Grid<StressEnergyPrims, subDim> scaledStressEnergyPrimGrid(ctx.sizev);
+
+		//the last two points on the path, starting with the incoming metric or flat space at lambda = 0
+		real lambda = 0, lastLambda = 0;
+		std::vector<real> x(n), lastX(n);
+		real* xs = (real*)metricPrimGrid.v;
+		if (!flatStart) {
+			std::copy(xs, xs + n, x.begin());
+			std::copy(xs, xs + n, lastX.begin());
+		}
+		//flat space is the lambda = 0 solution, the incoming metric isn't, so it doesn't count toward the secant
+		int solvedPoints = flatStart ? 1 : 0;
+
+		auto calcScaledResidual = [&]() -> real {
+			if (dirtyRegions) dirtyRegions->invalidate();	//the sources changed under it
+			if (ctx.useChargeCurrentForEM) {
+				update_EMFields(*ctx.workspace, metricPrimGrid, dt_metricPrimGrid, scaledStressEnergyPrimGrid);
+			}
+			return calcResidual(metricPrimGrid, dt_metricPrimGrid, scaledStressEnergyPrimGrid);
+		};
+
+		int targetFEvals = 0;
+		for (int stepIndex = 0; stepIndex < maxSteps && lambda < 1; ) {
+			real nextLambda = lambda + step;
+			if (nextLambda > 1. - 1e-9) nextLambda = 1;
+			scaleStressEnergyPrims(scaledStressEnergyPrimGrid, stressEnergyPrimGrid, nextLambda);
+
+			//secant predictor
+			real s = solvedPoints >= 2 ? (nextLambda - lambda) / (lambda - lastLambda) : 0;
+			for (int i = 0; i < n; ++i) {
+				xs[i] = x[i] + s * (x[i] - lastX[i]);
+			}
+			real predictorResidual = calcScaledResidual();
+
+			if (inner->dirtyRegions) inner->dirtyRegions->invalidate();
+			int startFEvals = inner->FEvals;
+			inner->solve(metricPrimGrid, dt_metricPrimGrid, scaledStressEnergyPrimGrid);
+			int stepFEvals = inner->FEvals - startFEvals;
+			real residual = calcScaledResidual();
+
+			std::cout << "continuation lambda=" << nextLambda
+				<< " step=" << (nextLambda - lambda)
+				<< " predictor residual=" << predictorResidual
+				<< " residual=" << residual
+				<< " F evals=" << stepFEvals
+				<< std::endl;
+
+			if (!std::isfinite(residual) || residual > predictorResidual * (1. + maxResidualGrowth)) {
+				step *= .5;
+				if (step < minStep) throw Common::Exception() << "continuation stalled at lambda=" << lambda;
+				continue;
+			}
+
+			++stepIndex;
+			++solvedPoints;
+			lastLambda = lambda;
+			lambda = nextLambda;
+			std::swap(lastX, x);
+			std::copy(xs, xs + n, x.begin());
+
+			if (!targetFEvals) targetFEvals = std::max(stepFEvals, 1);
+			if (stepFEvals <= targetFEvals) {
+				step *= 2.;
+			} else if (stepFEvals > 2 * targetFEvals) {
+				step *= .5;
+			}
+		}
+		std::copy(x.begin(), x.end(), xs);
+		if (lambda < 1) throw Common::Exception() << "continuation ran out of steps at lambda=" << lambda;
+		if (dirtyRegions) dirtyRegions->invalidate();
+	}
+};
+
+//cell centers of the grid from xmin to xmax
+void initCoords(const Context& ctx, Tensor::Grid<Tensor::Vector<real, subDim>, subDim>& xs) {
+	Tensor::RangeObj<subDim> range(Tensor::Vector<int,subDim>(), ctx.sizev);
+	ctx.parallel->foreach(range.begin(), range.end(), [&](const Tensor::Vector<int, subDim>& index) {
+		Tensor::Vector<real, subDim>& xi = xs(index);
+		for (int j = 0; j < subDim; ++j) {
+			xi(j) = (ctx.xmax(j) - ctx.xmin(j)) * ((real)index(j) + .5) / (real)ctx.sizev(j) + ctx.xmin(j);
+		}
+	});
+}
+
+struct Body {
+	real radius;
+
+	Body(real radius_) : radius(radius_) {}
+
+	virtual void initStressEnergyPrim(
+		const Context& ctx,
+		Tensor::Grid<StressEnergyPrims, subDim>& stressEnergyPrimGrid,
+		const Tensor::Grid<Tensor::Vector<real, subDim>, subDim>& xs
+	) = 0;
+};
+
+struct NullBody : public Body {
+	using Body::Body;
+
+	virtual void initStressEnergyPrim(
+		const Context& ctx,
+		Tensor::Grid<StressEnergyPrims, subDim>& stressEnergyPrimGrid,
+		const Tensor::Grid<Tensor::Vector<real, subDim>, subDim>& xs
+	) { }
+};
+
+struct SphericalBody : public Body {
+	real mass;
+	//derived:
+	real volume, density;
+	
+	SphericalBody(real radius_, real mass_)
+	: Body(radius_),
+	mass(mass_),
+	volume(4./3.*M_PI*radius*radius*radius),	// m^3
+	density(mass / volume)	// 1/m^2
+	{}
+
+	//rest-mass density at radius r, in 1/m^2
+	virtual real getDensity(real r) const {
+		return r < radius ? density : 0;
+	}
+
+	//pressure at radius r, in 1/m^2
+	virtual real getPressure(real r) const {
+		return 0;
+	}
+
+	virtual void initStressEnergyPrim(
+		const Context& ctx,
+		Tensor::Grid<StressEnergyPrims, subDim>& stressEnergyPrimGrid,
+		const Tensor::Grid<Tensor::Vector<real, subDim>, subDim>& xs
+	) {
+		Tensor::RangeObj<subDim> range(Tensor::Vector<int,subDim>(), ctx.sizev);
+		ctx.parallel->foreach(range.begin(), range.end(), [&](const Tensor::Vector<int, subDim>& index) {
+			StressEnergyPrims &stressEnergyPrims = stressEnergyPrimGrid(index);
+			real r = xs(index).length();
+			stressEnergyPrims.rho = getDensity(r);	// average density of Earth in m^-2
+			stressEnergyPrims.eInt = 0;	//internal energy / temperature of the Earth?
+			stressEnergyPrims.P = getPressure(r);	//pressure inside the Earth?
+			stressEnergyPrims.chargeDensity = 0;
+			for (int i = 0; i < subDim; ++i) {
+				stressEnergyPrims.v(i) = 0;	//3-velocity
+				stressEnergyPrims.currentDensity(i) = 0;
+				stressEnergyPrims.E(i) = 0;	//electric field
+				stressEnergyPrims.B(i) = 0;	//magnetic field
+			}
+		});
+	}
+};
+
+/*
+PREM (Dziewonski & Anderson 1981) layered Earth, read from prem.txt: radius, density and pressure every 100 km or so
+a radius listed twice is an interface between layers (the inner core at 1221.5 km, the outer core at 3480 km, ...) where rho jumps
+each layer gets its own monotone (Fritsch-Carlson) cubic through its samples, so nothing overshoots or leaks across an interface
+r exactly on an interface takes the outer layer, same as r < radius does at the surface
+the mass is the integral of that interpolation, exact by 3-point Gauss-Legendre since rho r^2 is a quintic
+*/
+struct PREMEarthBody : public SphericalBody {
+	struct Layer {
+		std::vector<real> rs, rhos, Ps;
+		std::vector<real> drho_drs, dP_drs;	//slopes at the samples
+
+		//slopes of a monotone cubic Hermite through ys
+		std::vector<real> calcSlopes(const std::vector<real>& ys) const {
+			int n = rs.size();
+			std::vector<real> deltas(n-1), slopes(n);
+			for (int i = 0; i < n-1; ++i) {
+				deltas[i] = (ys[i+1] - ys[i]) / (rs[i+1] - rs[i]);
+			}
+			slopes[0] = deltas[0];
+			slopes[n-1] = deltas[n-2];
+			for (int i = 1; i < n-1; ++i) {
+				if (deltas[i-1] * deltas[i] <= 0) {
+					slopes[i] = 0;
+				} else {
+					real hl = rs[i] - rs[i-1], hr = rs[i+1] - rs[i];
+					real wl = 2. * hr + hl, wr = hr + 2. * hl;
+					slopes[i] = (wl + wr) / (wl / deltas[i-1] + wr / deltas[i]);
+				}
+			}
+			return slopes;
+		}
+
+		void init() {
+			drho_drs = calcSlopes(rhos);
+			dP_drs = calcSlopes(Ps);
+		}
+
+		//cubic Hermite of ys, dys on interval i
+		real interpolate(const std::vector<real>& ys, const std::vector<real>& dys, int i, real r) const {
+			real h = rs[i+1] - rs[i];
+			real t = (r - rs[i]) / h;
+			real s = 1. - t;
+			return (1. + 2. * t) * s * s * ys[i]
+				+ t * s * s * h * dys[i]
+				+ t * t * (3. - 2. * t) * ys[i+1]
+				- t * t * s * h * dys[i+1];
+		}
+
+		int findInterval(real r) const {
+			int i = std::upper_bound(rs.begin(), rs.end(), r) - rs.begin() - 1;
+			return std::max<int>(0, std::min<int>(i, rs.size() - 2));
+		}
+	};
+	std::vector<Layer> layers;	//from the center out
+
+	PREMEarthBody(const std::string& filename) : SphericalBody(0, 0) {
+		std::ifstream file(filename);
+		if (!file) throw Common::Exception() << "couldn't open " << filename;
+		std::string line;
+		while (std::getline(file, line)) {
+			if (line.empty() || line[0] == '#') continue;
+			std::istringstream ss(line);
+			real depth, r, vp, vs, rho, Qmu, Qkappa, P;
+			if (!(ss >> depth >> r >> vp >> vs >> rho >> Qmu >> Qkappa >> P)) continue;
+			r *= 1e+3;	// km -> m
+			rho *= 1e+3 * G / (c * c);	// g/cm^3 -> kg/m^3 -> 1/m^2
+			P *= 1e+9 * G / (c * c * c * c);	// GPa -> Pa -> 1/m^2
+			if (layers.empty() || r == layers.back().rs.back()) layers.push_back(Layer());
+			Layer& layer = layers.back();
+			if (!layer.rs.empty() && r < layer.rs.back()) throw Common::Exception() << filename << " radii must increase";
+			layer.rs.push_back(r);
+			layer.rhos.push_back(rho);
+			layer.Ps.push_back(P);
+		}
+		for (Layer& layer : layers) {
+			if (layer.rs.size() < 2) throw Common::Exception() << filename << " has a layer with only one sample, at r=" << layer.rs[0];
+			layer.init();
+		}
+		if (layers.empty()) throw Common::Exception() << filename << " has no samples";
+
+		radius = layers.back().rs.back();
+		volume = 4./3.*M_PI*radius*radius*radius;
+		const real gaussPoints[3] = {-sqrt(.6), 0, sqrt(.6)};
+		const real gaussWeights[3] = {5./9., 8./9., 5./9.};
+		mass = 0;
+		for (const Layer& layer : layers) {
+			for (int i = 0; i < (int)layer.rs.size() - 1; ++i) {
+				real mid = .5 * (layer.rs[i] + layer.rs[i+1]);
+				real halfWidth = .5 * (layer.rs[i+1] - layer.rs[i]);
+				for (int j = 0; j < 3; ++j) {
+					real r = mid + halfWidth * gaussPoints[j];
+					mass += gaussWeights[j] * halfWidth * 4. * M_PI * r * r * layer.interpolate(layer.rhos, layer.drho_drs, i, r);
+				}
+			}
+		}
+		density = mass / volume;
+		std::cout << "PREM layers=" << layers.size() << " radius=" << radius << " mass=" << mass << " average density=" << density << std::endl;
+	}
+
+	//the layer holding r, or null outside of the body
+	const Layer* findLayer(real r) const {
+		for (const Layer& layer : layers) {
+			if (r < layer.rs.back()) return &layer;
+		}
+		return nullptr;
+	}
+
+	virtual real getDensity(real r) const {
+		const Layer* layer = findLayer(r);
+		if (!layer) return 0;
+		return layer->interpolate(layer->rhos, layer->drho_drs, layer->findInterval(r), r);
+	}
+
+	virtual real getPressure(real r) const {
+		const Layer* layer = findLayer(r);
+		if (!layer) return 0;
+		return layer->interpolate(layer->Ps, layer->dP_drs, layer->findInterval(r), r);
+	}
+};
+
+//E_i = A_t,i - A_i,t
+//B_i = epsilon_i^jk A_k,j
+
+//stress-energy of a uniform electric field in the x-direction
+struct EMUniformFieldBody : public Body {
+	using Body::Body;
+	virtual void initStressEnergyPrim(
+		const Context& ctx,
+		Tensor::Grid<StressEnergyPrims, subDim>& stressEnergyPrimGrid,
+		const Tensor::Grid<Tensor::Vector<real, subDim>, subDim>& xs
+	) {
+		if (ctx.useChargeCurrentForEM) {
+			//a uniform field has no source on the grid, and A^a is zero at the boundary
+			throw Common::Exception() << "EMUniformField needs E and B.  set useChargeCurrentForEM = false";
+		} else {
+			Tensor::RangeObj<subDim> range(Tensor::Vector<int,subDim>(), ctx.sizev);
+			ctx.parallel->foreach(range.begin(), range.end(), [&](const Tensor::Vector<int, subDim>& index) {
+				StressEnergyPrims &stressEnergyPrims = stressEnergyPrimGrid(index);
+
+				stressEnergyPrims.useEM = true; 
+
+				real volts = 100000;			//V
+				real dist = 0.1;				//m
+				real E = volts / dist;			//V / m
+				E = E * sqrt(ke * G) / (c * c);	//m^-1
+
+				stressEnergyPrims.E(0) = E;
+				stressEnergyPrims.E(1) = 0;
+				stressEnergyPrims.E(2) = 0;
+	
+				stressEnergyPrims.B(0) = 0;
+				stressEnergyPrims.B(1) = 0;
+				stressEnergyPrims.B(2) = 0;
+			});
+		}
+	}
+};
+
+struct EMLineBody : public Body {
+	using Body::Body;
+
+	//torus-shaped-something
+	//radius is the big radius of the torus
+	virtual void initStressEnergyPrim(
+		const Context& ctx,
+		Tensor::Grid<StressEnergyPrims, subDim>& stressEnergyPrimGrid,
+		const Tensor::Grid<Tensor::Vector<real, subDim>, subDim>& xs
+	) {
+		Tensor::RangeObj<subDim> range(Tensor::Vector<int,subDim>(), ctx.sizev);
+		ctx.parallel->foreach(range.begin(), range.end(), [&](const Tensor::Vector<int, subDim>& index) {
+			StressEnergyPrims &stressEnergyPrims = stressEnergyPrimGrid(index);
+			const Tensor::Vector<real, subDim>& xi = xs(index);
+			real x = xi(0);
+			real y = xi(1);
+			real z = xi(2);
+			real polar_rSq = x*x + y*y; 
+			real polar_r = sqrt(polar_rSq);		//r in polar coordinates	
+			real dr = polar_r - radius;	//difference from polar radius to torus big radius
+			real r = sqrt(z*z + dr*dr);			//r in torus radial coordinates
+			real theta = atan2(z, dr);			//angle around the small radius
+			real phi = atan2(x, y);				//angle around the big radius
+		
+			//F^uv_;v = -4 pi J^u
+			// means that the divergence of the EM is the 4-current 
+			//the divergence of the exterior of the 4-potential is the 4-current
+			//so if the 4-current is a Dirac delta function along the line in space where there is current
+			// then the EM tensor is going to be an inverse falloff around it
+	
+			//4-current
+			//t is current density
+			//i is charge density = current density * drift velocity
+			//stressEnergyPrims.chargeDensity
+			//stressEnergyPrims.A
+	
+			/*
+			point on the surface:
+				r * cos(phi) * cos(theta)
+				r * sin(phi) * cos(theta)
+				r * sin(theta)
+			*/
+		
+			if (ctx.useChargeCurrentForEM) {
+				//current around the big radius, within one cell of the line
+				//only the source is confined to the wire.  the field it makes is everywhere, see initStressEnergyFlags
+				if (r < ctx.dx.length()) {
+					stressEnergyPrims.currentDensity(0) = -y / polar_r;
+					stressEnergyPrims.currentDensity(1) = x / polar_r;
+					stressEnergyPrims.currentDensity(2) = 0;
+				}
+			} else {
+				stressEnergyPrims.E(0) = -y / polar_rSq;
+				stressEnergyPrims.E(1) = x / polar_rSq;
+				stressEnergyPrims.E(2) = 0;
+	
+				stressEnergyPrims.B(0) = cos(theta) / r * cos(phi);
+				stressEnergyPrims.B(1) = cos(theta) / r * sin(phi);
+				stressEnergyPrims.B(2) = -sin(theta) / r;
+			}
+		});
+	}
+};
+
+struct InitCond {
+	virtual void initMetricPrims(
+		const Context& ctx,
+		Tensor::Grid<MetricPrims, subDim>& metricPrimGrid,
+		const Tensor::Grid<Tensor::Vector<real, subDim>, subDim>& xs
+	) = 0;
+};
+
+struct SphericalBodyInitCond : public InitCond {
+	std::shared_ptr<SphericalBody> body;	
+	SphericalBodyInitCond(std::shared_ptr<SphericalBody> body_) : body(body_) {}
+};
+
+struct FlatInitCond : public InitCond {
+	//substitute the schwarzschild R for 2 m(r)
+	virtual void initMetricPrims(
+		const Context& ctx,
+		Tensor::Grid<MetricPrims, subDim>& metricPrimGrid,
+		const Tensor::Grid<Tensor::Vector<real, subDim>, subDim>& xs
+	) {
+		Tensor::RangeObj<subDim> range(Tensor::Vector<int,subDim>(), ctx.sizev);
+		ctx.parallel->foreach(range.begin(), range.end(), [&](const Tensor::Vector<int, subDim>& index) {
+			MetricPrims& metricPrims = metricPrimGrid(index);
+			metricPrims.alphaMinusOne = 0;
+			for (int i = 0; i < subDim; ++i) {
+				metricPrims.betaU(i) = 0;
+				for (int j = 0; j <= i; ++j) {
+					metricPrims.hLL(i,j) = 0;
+				}
+			}
+		});
+	}
+};
+
+/*
+The stellar Schwarzschild initial conditions have constraint value of zero outside Earth (good)
+but inside Earth they give a difference of 2 g/cm^3 ... off from the Earth's density of 5.51 g/cm^3
 */
 struct StellarSchwarzschildInitCond : public SphericalBodyInitCond {
 	using SphericalBodyInitCond::SphericalBodyInitCond;
 	virtual void initMetricPrims(
+		const Context& ctx,
 		Tensor::Grid<MetricPrims, subDim>& metricPrimGrid,
 		const Tensor::Grid<Tensor::Vector<real, subDim>, subDim>& xs
 	) {
 		real radius = body->radius;
 		real density = body->density;
 		real mass = body->mass;
-		Tensor::RangeObj<subDim> range(Tensor::Vector<int,subDim>(), sizev);
-		parallel.foreach(range.begin(), range.end(), [&](const Tensor::Vector<int, subDim>& index) {
+		Tensor::RangeObj<subDim> range(Tensor::Vector<int,subDim>(), ctx.sizev);
+		ctx.parallel->foreach(range.begin(), range.end(), [&](const Tensor::Vector<int, subDim>& index) {
 			MetricPrims& metricPrims = metricPrimGrid(index);
 			const Tensor::Vector<real, subDim>& xi = xs(index);
 			real r = xi.length();
@@ -2003,17 +5902,156 @@ struct StellarSchwarzschildInitCond : public SphericalBodyInitCond {
 	}
 };
 
+/*
+Tolman-Oppenheimer-Volkoff: the static spherical star for the body's density profile rho(r), in Schwarzschild coordinates
+	dm/dr = 4 pi r^2 rho
+	dP/dr = -(rho + P) (m + 4 pi r^3 P) / (r (r - 2 m))
+	dPhi/dr = (m + 4 pi r^3 P) / (r (r - 2 m)), alpha = exp(Phi)
+rho is given rather than an equation of state, so m is integrated outwards for the total mass M,
+ then m, P, Phi inwards from the surface, where P = 0 and Phi = 1/2 log(1 - 2 M / R) meets the exterior Schwarzschild metric
+both are RK4 on radialCells uniform steps, and the cells of the grid linearly interpolate the table
+P goes into the stress-energy prims.  it is only nonzero where rho is, so the stress-energy cell lists still hold
+the metric has the same form as StellarSchwarzschildInitCond, which this reproduces for a uniform density
+*/
+struct StellarTOVInitCond : public SphericalBodyInitCond {
+	Tensor::Grid<StressEnergyPrims, subDim>& stressEnergyPrimGrid;
+	int radialCells = 100000;
+
+	//radial table, at r = i * dr for i = 0..radialCells
+	real dr;
+	std::vector<real> ms, Ps, Phis;
+
+	StellarTOVInitCond(std::shared_ptr<SphericalBody> body_, Tensor::Grid<StressEnergyPrims, subDim>& stressEnergyPrimGrid_)
+	: SphericalBodyInitCond(body_), stressEnergyPrimGrid(stressEnergyPrimGrid_) {}
+
+	struct State {
+		real m, P, Phi;
+		State operator+(const State& b) const { return {m + b.m, P + b.P, Phi + b.Phi}; }
+		State operator*(real s) const { return {m * s, P * s, Phi * s}; }
+	};
+
+	State calcDerivative(real r, real rho, const State& y) const {
+		State dy_dr;
+		dy_dr.m = 4. * M_PI * r * r * rho;
+		if (r == 0) {	//m and the pressure term go as r^3, so everything else goes to zero with r
+			dy_dr.P = 0;
+			dy_dr.Phi = 0;
+			return dy_dr;
+		}
+		real dPhi_dr = (y.m + 4. * M_PI * r * r * r * y.P) / (r * (r - 2. * y.m));
+		dy_dr.P = -(rho + y.P) * dPhi_dr;
+		dy_dr.Phi = dPhi_dr;
+		return dy_dr;
+	}
+
+	//rho is held at its value mid-step, so a density jump on a step boundary (like the surface) doesn't smear into the step
+	State rk4(real r, const State& y, real h) const {
+		real rho = body->getDensity(r + .5 * h);
+		State k1 = calcDerivative(r, rho, y);
+		State k2 = calcDerivative(r + .5 * h, rho, y + k1 * (.5 * h));
+		State k3 = calcDerivative(r + .5 * h, rho, y + k2 * (.5 * h));
+		State k4 = calcDerivative(r + h, rho, y + k3 * h);
+		return y + (k1 + k2 * 2. + k3 * 2. + k4) * (h / 6.);
+	}
+
+	void integrate() {
+		real radius = body->radius;
+		dr = radius / (real)radialCells;
+		ms.resize(radialCells+1);
+		Ps.resize(radialCells+1);
+		Phis.resize(radialCells+1);
+
+		//outwards for the mass
+		State y = {0, 0, 0};
+		for (int i = 0; i < radialCells; ++i) {
+			y = rk4(i * dr, y, dr);
+		}
+		real mass = y.m;
+		if (2. * mass >= radius) throw Common::Exception() << "the TOV body is inside its Schwarzschild radius";
+
+		//inwards from the surface
+		y = {mass, 0, .5 * log1p(-2. * mass / radius)};
+		ms[radialCells] = y.m;
+		Ps[radialCells] = y.P;
+		Phis[radialCells] = y.Phi;
+		for (int i = radialCells; i > 0; --i) {
+			y = rk4(i * dr, y, -dr);
+			ms[i-1] = y.m;
+			Ps[i-1] = y.P;
+			Phis[i-1] = y.Phi;
+		}
+		ms[0] = 0;
+
+		std::cout << "TOV mass=" << std::setprecision(16) << mass
+			<< " (body mass=" << body->mass << ")"
+			<< " central pressure=" << Ps[0]
+			<< " central alpha-1=" << expm1(Phis[0]) << std::setprecision(6)
+			<< std::endl;
+	}
+
+	//m(r), P(r), Phi(r) inside the body
+	State interpolate(real r) const {
+		real f = r / dr;
+		int i = std::min<int>((int)f, radialCells - 1);
+		real s = f - (real)i;
+		return {
+			ms[i] + (ms[i+1] - ms[i]) * s,
+			Ps[i] + (Ps[i+1] - Ps[i]) * s,
+			Phis[i] + (Phis[i+1] - Phis[i]) * s,
+		};
+	}
+
+	virtual void initMetricPrims(
+		const Context& ctx,
+		Tensor::Grid<MetricPrims, subDim>& metricPrimGrid,
+		const Tensor::Grid<Tensor::Vector<real, subDim>, subDim>& xs
+	) {
+		integrate();
+
+		real radius = body->radius;
+		real mass = ms[radialCells];
+		Tensor::RangeObj<subDim> range(Tensor::Vector<int,subDim>(), ctx.sizev);
+		ctx.parallel->foreach(range.begin(), range.end(), [&](const Tensor::Vector<int, subDim>& index) {
+			MetricPrims& metricPrims = metricPrimGrid(index);
+			StressEnergyPrims& stressEnergyPrims = stressEnergyPrimGrid(index);
+			const Tensor::Vector<real, subDim>& xi = xs(index);
+			real r = xi.length();
+
+			real m;
+			if (r < radius) {
+				State y = interpolate(r);
+				m = y.m;
+				stressEnergyPrims.P = y.P;
+				metricPrims.alphaMinusOne = expm1(y.Phi);
+			} else {
+				m = mass;
+				stressEnergyPrims.P = 0;
+				//sqrt(1 - 2M/r) - 1 without the cancellation
+				metricPrims.alphaMinusOne = -2. * mass / r / (sqrt(1. - 2. * mass / r) + 1.);
+			}
+
+			for (int i = 0; i < subDim; ++i) {
+				metricPrims.betaU(i) = 0;
+				for (int j = 0; j <= i; ++j) {
+					metricPrims.hLL(i,j) = r == 0 ? 0 : xi(i)/r * xi(j)/r * 2*m/(r - 2*m);
+				}
+			}
+		});
+	}
+};
+
 struct StellarKerrNewmanInitCond : public SphericalBodyInitCond {
 	using SphericalBodyInitCond::SphericalBodyInitCond;
 	virtual void initMetricPrims(
+		const Context& ctx,
 		Tensor::Grid<MetricPrims, subDim>& metricPrimGrid,
 		const Tensor::Grid<Tensor::Vector<real, subDim>, subDim>& xs
 	) {
 		real radius = body->radius;
 		real mass = body->mass;
 		real density = body->density;
-		Tensor::RangeObj<subDim> range(Tensor::Vector<int,subDim>(), sizev);
-		parallel.foreach(range.begin(), range.end(), [&](const Tensor::Vector<int, subDim>& index) {
+		Tensor::RangeObj<subDim> range(Tensor::Vector<int,subDim>(), ctx.sizev);
+		ctx.parallel->foreach(range.begin(), range.end(), [&](const Tensor::Vector<int, subDim>& index) {
 			MetricPrims& metricPrims = metricPrimGrid(index);
 			const Tensor::Vector<real,subDim>& xi = xs(index);
 			
@@ -2042,41 +6080,396 @@ struct StellarKerrNewmanInitCond : public SphericalBodyInitCond {
 			real volumeOfMatterRadius = 4./3.*M_PI*matterRadius*matterRadius*matterRadius;
 			real m = density * volumeOfMatterRadius;	// m^3
 
-			real Q = 0;	//charge
-			real H = (r*m - Q*Q/2.)/(r*r + a*a*z*z/(r*r));
-		
-			//3.4.33 through 3.4.35 of Alcubierre "Introduction to 3+1 Numerical Relativity"
-			
-			/*TODO fix this for the metric within the star
-			 in other news, this is an unsolved problem!
-			https://arxiv.org/pdf/1503.02172.pdf section 3.11
-			https://arxiv.org/pdf/1410.2130.pdf section 4.2 last paragraph
-			*/
-			//metricPrims.alphaMinusOne = 1./sqrt(1. + 2*H) - 1.;
-			metricPrims.alphaMinusOne = sqrt(1. - 2*H/(1+2*H) ) - 1.;
-			
-			Tensor::Vector<real,subDim> l( (r*x + a*y)/(r*r + a*a), (r*y - a*x)/(r*r + a*a), z/r );
-			for (int i = 0; i < subDim; ++i) {
-				metricPrims.betaU(i) = 2. * H * l(i) / (1. + 2. * H);
-				for (int j = 0; j <= i; ++j) {
-					metricPrims.hLL(i,j) = 2 * H * l(i) * l(j); 
-				}
-			}
-		});
-	}
-};
+			real Q = 0;	//charge
+			real H = (r*m - Q*Q/2.)/(r*r + a*a*z*z/(r*r));
+		
+			//3.4.33 through 3.4.35 of Alcubierre "Introduction to 3+1 Numerical Relativity"
+			
+			/*TODO fix this for the metric within the star
+			 in other news, this is an unsolved problem!
+			https://arxiv.org/pdf/1503.02172.pdf section 3.11
+			https://arxiv.org/pdf/1410.2130.pdf section 4.2 last paragraph
+			*/
+			//metricPrims.alphaMinusOne = 1./sqrt(1. + 2*H) - 1.;
+			metricPrims.alphaMinusOne = sqrt(1. - 2*H/(1+2*H) ) - 1.;
+			
+			Tensor::Vector<real,subDim> l( (r*x + a*y)/(r*r + a*a), (r*y - a*x)/(r*r + a*a), z/r );
+			for (int i = 0; i < subDim; ++i) {
+				metricPrims.betaU(i) = 2. * H * l(i) / (1. + 2. * H);
+				for (int j = 0; j <= i; ++j) {
+					metricPrims.hLL(i,j) = 2 * H * l(i) * l(j); 
+				}
+			}
+		});
+	}
+};
+
+struct EMUniformFieldInitCond : public FlatInitCond {
+	std::shared_ptr<EMUniformFieldBody> body;	
+	EMUniformFieldInitCond(std::shared_ptr<EMUniformFieldBody> body_) : body(body_) {}
+	//use flat initial metric prims for now
+};
+
+struct EMLineInitCond : public FlatInitCond {
+	std::shared_ptr<EMLineBody> body;
+	EMLineInitCond(std::shared_ptr<EMLineBody> body_) : body(body_) {}
+};
+
+std::shared_ptr<Body> createBody(const std::string& bodyName) {
+	std::shared_ptr<Body> body;
+	struct {
+		const char* name;
+		std::function<std::shared_ptr<Body>()> func;
+	} bodies[] = {
+		{"Null", [&](){
+			return std::make_shared<NullBody>(2);
+		}},
+		
+		{"earth", [&](){
+			const real earthRadius = 6.37101e+6;	// m
+			const real earthMass = 5.9736e+24 * G / c / c;	// m
+			//earth volume: 1.0832120174985e+21 m^3
+			//earth density: 4.0950296770075e-24 1/m^2 = 5.5147098661212 g/cm^3, which is what Google says.
+			//note that G_tt = 8 pi T_tt = 8 pi rho ... for earth = 1.0291932119615e-22 m^-2
+			//const real schwarzschildRadius = 2 * mass;	//Schwarzschild radius: 8.87157 mm, which is accurate
+			//earth magnetic field at surface: .25-.26 gauss
+			//const real earthMagneticField = .45 * sqrt(.1 * G) / c;	// 1/m
+			return std::make_shared<SphericalBody>(earthRadius, earthMass);
+		}},
+	
+		{"earth_prem", [&](){
+			return std::make_shared<PREMEarthBody>("prem.txt");
+		}},
+	
+		{"sun", [&](){
+			const real sunRadius = 6.960e+8;	// m
+			const real sunMass = 1.9891e+30 * G / c / c;	// m
+			return std::make_shared<SphericalBody>(sunRadius, sunMass);
+		}},
+	
+		{"EMUniformField", [&](){
+			return std::make_shared<EMUniformFieldBody>(2);
+		}},
+		
+		{"em_line", [&](){
+			return std::make_shared<EMLineBody>(2);
+		}},
+	}, *p;
+
+	for (p = bodies; p < endof(bodies); ++p) {
+		if (p->name == bodyName) {
+std::cout << "creating body " << bodyName << std::endl;				
+			body = p->func();
+			break;
+		}
+	}
+	if (!body) {
+		throw Common::Exception() << "couldn't find body named " << bodyName;
+	}
+	return body;
+}
+
+std::shared_ptr<InitCond> createInitCond(
+	const std::string& initCondName,
+	std::shared_ptr<Body> body,
+	Tensor::Grid<StressEnergyPrims, subDim>& stressEnergyPrimGrid	//stellar_tov reads the body's pressure from here
+) {
+	struct {
+		const char* name;
+		std::function<std::shared_ptr<InitCond>()> func;
+	} initConds[] = {
+		{"flat", [&](){ return std::make_shared<FlatInitCond>(); }},
+		{"stellar_schwarzschild", [&](){ 
+			std::shared_ptr<SphericalBody> sphericalBody = std::dynamic_pointer_cast<SphericalBody>(body);
+			if (!sphericalBody) throw Common::Exception() << initCondName << " needs a spherical body";
+			return std::make_shared<StellarSchwarzschildInitCond>(sphericalBody);
+		}},
+		{"stellar_tov", [&](){ 
+			std::shared_ptr<SphericalBody> sphericalBody = std::dynamic_pointer_cast<SphericalBody>(body);
+			if (!sphericalBody) throw Common::Exception() << initCondName << " needs a spherical body";
+			return std::make_shared<StellarTOVInitCond>(sphericalBody, stressEnergyPrimGrid);
+		}},
+		{"stellar_kerr_newman", [&](){ 
+			std::shared_ptr<SphericalBody> sphericalBody = std::dynamic_pointer_cast<SphericalBody>(body);
+			if (!sphericalBody) throw Common::Exception() << initCondName << " needs a spherical body";
+			return std::make_shared<StellarKerrNewmanInitCond>(sphericalBody);
+		}},
+		{"EMUniformField", [&](){ 
+			std::shared_ptr<EMUniformFieldBody> emFieldBody = std::dynamic_pointer_cast<EMUniformFieldBody>(body);
+			if (!emFieldBody) throw Common::Exception() << initCondName << " needs the EMUniformField body";
+			return std::make_shared<EMUniformFieldInitCond>(emFieldBody);
+		}},
+		{"em_line", [&](){ 
+			std::shared_ptr<EMLineBody> emLineBody = std::dynamic_pointer_cast<EMLineBody>(body);
+			if (!emLineBody) throw Common::Exception() << initCondName << " needs the em_line body";
+			return std::make_shared<EMLineInitCond>(emLineBody);
+		}},
+	}, *p;
+
+	std::shared_ptr<InitCond> initCond;
+	for (p = initConds; p < endof(initConds); ++p) {
+		if (p->name == initCondName) {
+			initCond = p->func();
+			break;
+		}
+	}
+	if (!initCond) {
+		throw Common::Exception() << "couldn't find initial condition named " << initCondName;
+	}
+	return initCond;
+}
+
+std::shared_ptr<EFESolver> createSolver(
+	Context& ctx,
+	const std::string& solverName,
+	int maxiter,
+	//the rest are for jfnk and broyden
+	const std::string& lineSearchName,
+	int gmresRecycle,
+	const std::string& preconditionerName,
+	const std::string& jacobianName,
+	int jacobianReuse
+) {
+	std::shared_ptr<EFESolver> solver;
+	struct {
+		const char* name;
+		std::function<std::shared_ptr<EFESolver>()> func;
+	} solvers[] = {
+		{"jfnk", [&](){ return std::make_shared<JFNKSolver>(ctx, maxiter, lineSearchName, gmresRecycle, preconditionerName, jacobianName, jacobianReuse); }},
+		{"broyden", [&](){ return std::make_shared<BroydenSolver>(ctx, maxiter, lineSearchName, gmresRecycle, preconditionerName, jacobianName, jacobianReuse); }},
+		{"pseudotime", [&](){ return std::make_shared<PseudoTimeSolver>(ctx, maxiter); }},
+		{"fas", [&](){ return std::make_shared<FASSolver>(ctx, maxiter); }},
+		{"linearized", [&](){ return std::make_shared<LinearizedSolver>(ctx, maxiter); }},
+		{"cfc", [&](){ return std::make_shared<CFCSolver>(ctx, maxiter); }},
+		{"gmres", [&](){ return std::make_shared<GMRESSolver>(ctx, maxiter); }},
+		{"conjres", [&](){ return std::make_shared<ConjResSolver>(ctx, maxiter); }},
+		{"conjgrad", [&](){ return std::make_shared<ConjGradSolver>(ctx, maxiter); }},
+	}, *p;
+	for (p = solvers; p < endof(solvers); ++p) {
+		if (p->name == solverName) {
+			solver = p->func();
+		}
+	}
+	if (!solver) {
+		throw Common::Exception() << "couldn't find solver named " << solverName;
+	}
+	return solver;
+}
+
+//EFESoln::SolverContext::setBody with a function
+struct FunctionBody : public Body {
+	std::function<EFESoln::Source(double, double, double)> source;
+
+	FunctionBody(real radius_, std::function<EFESoln::Source(double, double, double)> source_)
+	: Body(radius_), source(source_) {}
+
+	virtual void initStressEnergyPrim(
+		const Context& ctx,
+		Tensor::Grid<StressEnergyPrims, subDim>& stressEnergyPrimGrid,
+		const Tensor::Grid<Tensor::Vector<real, subDim>, subDim>& xs
+	) {
+		Tensor::RangeObj<subDim> range(Tensor::Vector<int,subDim>(), ctx.sizev);
+		ctx.parallel->foreach(range.begin(), range.end(), [&](const Tensor::Vector<int, subDim>& index) {
+			const Tensor::Vector<real, subDim>& xi = xs(index);
+			EFESoln::Source src = source(xi(0), xi(1), xi(2));
+			StressEnergyPrims& stressEnergyPrims = stressEnergyPrimGrid(index);
+			stressEnergyPrims.rho = src.rho;
+			stressEnergyPrims.P = src.P;
+			stressEnergyPrims.eInt = src.eInt;
+			for (int i = 0; i < subDim; ++i) {
+				stressEnergyPrims.v(i) = src.v[i];
+				stressEnergyPrims.currentDensity(i) = src.currentDensity[i];
+				stressEnergyPrims.E(i) = src.E[i];
+				stressEnergyPrims.B(i) = src.B[i];
+			}
+			stressEnergyPrims.chargeDensity = src.chargeDensity;
+		});
+	}
+};
+
+//EFESoln::SolverContext::setInitCond with a function
+struct FunctionInitCond : public InitCond {
+	std::function<EFESoln::Metric(double, double, double)> initMetric;
+
+	FunctionInitCond(std::function<EFESoln::Metric(double, double, double)> initMetric_)
+	: initMetric(initMetric_) {}
+
+	virtual void initMetricPrims(
+		const Context& ctx,
+		Tensor::Grid<MetricPrims, subDim>& metricPrimGrid,
+		const Tensor::Grid<Tensor::Vector<real, subDim>, subDim>& xs
+	) {
+		Tensor::RangeObj<subDim> range(Tensor::Vector<int,subDim>(), ctx.sizev);
+		ctx.parallel->foreach(range.begin(), range.end(), [&](const Tensor::Vector<int, subDim>& index) {
+			const Tensor::Vector<real, subDim>& xi = xs(index);
+			EFESoln::Metric metric = initMetric(xi(0), xi(1), xi(2));
+			MetricPrims& metricPrims = metricPrimGrid(index);
+			metricPrims.alphaMinusOne = metric.alphaMinusOne;
+			for (int i = 0; i < subDim; ++i) {
+				metricPrims.betaU(i) = metric.betaU[i];
+			}
+			metricPrims.hLL(0,0) = metric.hLL[0];
+			metricPrims.hLL(0,1) = metric.hLL[1];
+			metricPrims.hLL(0,2) = metric.hLL[2];
+			metricPrims.hLL(1,1) = metric.hLL[3];
+			metricPrims.hLL(1,2) = metric.hLL[4];
+			metricPrims.hLL(2,2) = metric.hLL[5];
+		});
+	}
+};
+
+/*
+EFESoln::SolverContext, for programs that link the library instead of running main()
+a context owns everything a solve touches: its threads, workspace, grids and the Context the solvers read them through
+*/
+struct EFESoln::SolverContext::Impl {
+	Context ctx;
+	Parallel::Parallel parallel;
+	Workspace ws;
+	EMFieldGrids emFields;
+
+	Tensor::Grid<Tensor::Vector<real, subDim>, subDim> xs;
+	Tensor::Grid<MetricPrims, subDim> metricPrimGrid;
+	Tensor::Grid<MetricPrims, subDim> dt_metricPrimGrid;	//first deriv
+	Tensor::Grid<StressEnergyPrims, subDim> stressEnergyPrimGrid;
+
+	//same defaults as config.lua
+	std::shared_ptr<Body> body;	//earth if none is set
+	std::string initCondName = "stellar_schwarzschild";
+	std::shared_ptr<InitCond> initCond;	//used instead of initCondName if set
+	std::string solverName = "jfnk";
+	int maxiter = std::numeric_limits<int>::max();
+	real bodyRadii = 2;
+
+	real residual = 0;
+
+	Impl(int numThreads) : parallel(numThreads), ws(&ctx, &parallel) {
+		ctx.numThreads = numThreads;
+		ctx.parallel = &parallel;
+		ctx.workspace = &ws;
+		ctx.emFields = &emFields;
+		ctx.sizev = Tensor::Vector<int, subDim>(16, 16, 16);
+	}
+
+	//the same steps as one level of main()
+	void solve() {
+		if (!body) body = createBody("earth");
+
+		ctx.xmin = Tensor::Vector<real, subDim>(-bodyRadii*body->radius, -bodyRadii*body->radius, -bodyRadii*body->radius);
+		ctx.xmax = Tensor::Vector<real, subDim>(bodyRadii*body->radius, bodyRadii*body->radius, bodyRadii*body->radius);
+		ctx.gridVolume = ctx.sizev.volume();
+		ctx.dx = (ctx.xmax - ctx.xmin) / ctx.sizev;
+		//the init conds only set the metric, so dt_metricPrimGrid stays zero
+		ctx.isStationary = true;
+
+		size_t totalSize = 0;
+		allocateGrid(xs, "xs", ctx.sizev, totalSize);
+		allocateGrid(metricPrimGrid, "metricPrimGrid", ctx.sizev, totalSize);
+		allocateGrid(dt_metricPrimGrid, "dt_metricPrimGrid", ctx.sizev, totalSize);
+		allocateGrid(stressEnergyPrimGrid, "stressEnergyPrimGrid", ctx.sizev, totalSize);
+		allocateWorkspace(ws, "ws", ctx.isStationary, ctx.sizev, totalSize);
+		if (ctx.useChargeCurrentForEM) {
+			allocateGrid(emFields.AUs, "emFields.AUs", ctx.sizev, totalSize);
+			allocateGrid(emFields.EUs, "emFields.EUs", ctx.sizev, totalSize);
+			allocateGrid(emFields.BUs, "emFields.BUs", ctx.sizev, totalSize);
+		}
+
+		initCoords(ctx, xs);
+		body->initStressEnergyPrim(ctx, stressEnergyPrimGrid, xs);
+		initStressEnergyFlags(ctx, stressEnergyPrimGrid);
+		classifyStressEnergyCells(stressEnergyPrimGrid, ctx.stressEnergyCells);
+
+		std::shared_ptr<InitCond> useInitCond = initCond ? initCond : createInitCond(initCondName, body, stressEnergyPrimGrid);
+		useInitCond->initMetricPrims(ctx, metricPrimGrid, xs);
+		std::fill(dt_metricPrimGrid.v, dt_metricPrimGrid.v + ctx.gridVolume, MetricPrims());
+
+		std::shared_ptr<EFESolver> solver = createSolver(ctx, solverName, maxiter, "bisect", 0, "none", "matrixfree", 1);
+		if (maxiter > 0) {
+			solver->solve(metricPrimGrid, dt_metricPrimGrid, stressEnergyPrimGrid);
+		}
+		residual = solver->calcResidual(metricPrimGrid, dt_metricPrimGrid, stressEnergyPrimGrid);
+	}
+};
+
+EFESoln::SolverContext::SolverContext(int numThreads) : impl(std::make_unique<Impl>(numThreads)) {}
+EFESoln::SolverContext::~SolverContext() {}
+
+void EFESoln::SolverContext::setBody(const std::string& bodyName) {
+	impl->body = createBody(bodyName);
+}
+
+void EFESoln::SolverContext::setSphericalBody(double radius, double mass) {
+	impl->body = std::make_shared<SphericalBody>(radius, mass * G / c / c);
+}
+
+void EFESoln::SolverContext::setBody(double radius, std::function<Source(double x, double y, double z)> source) {
+	impl->body = std::make_shared<FunctionBody>(radius, source);
+}
+
+void EFESoln::SolverContext::setInitCond(const std::string& initCondName) {
+	impl->initCondName = initCondName;
+	impl->initCond = nullptr;
+}
+
+void EFESoln::SolverContext::setInitCond(std::function<Metric(double x, double y, double z)> initMetric) {
+	impl->initCond = std::make_shared<FunctionInitCond>(initMetric);
+}
+
+void EFESoln::SolverContext::setSolver(const std::string& solverName, int maxiter) {
+	impl->solverName = solverName;
+	impl->maxiter = maxiter;
+}
+
+void EFESoln::SolverContext::setSize(int nx, int ny, int nz) {
+	impl->ctx.sizev = Tensor::Vector<int, subDim>(nx, ny, nz);
+}
+
+void EFESoln::SolverContext::setBodyRadii(double bodyRadii) {
+	impl->bodyRadii = bodyRadii;
+}
+
+void EFESoln::SolverContext::setConvergeAlphaOnly(bool convergeAlphaOnly) {
+	impl->ctx.convergeAlphaOnly = convergeAlphaOnly;
+}
+
+void EFESoln::SolverContext::setEinsteinPath(const std::string& einsteinPath) {
+	impl->ctx.einsteinPath = getEinsteinPath(einsteinPath);
+}
+
+void EFESoln::SolverContext::setDGammaPath(const std::string& dGammaPath) {
+	impl->ctx.dGammaPath = getDGammaPath(dGammaPath);
+}
+
+void EFESoln::SolverContext::setUseChargeCurrentForEM(bool useChargeCurrentForEM) {
+	impl->ctx.useChargeCurrentForEM = useChargeCurrentForEM;
+}
+
+std::vector<EFESoln::Metric> EFESoln::SolverContext::solve() {
+	impl->solve();
 
-struct EMUniformFieldInitCond : public FlatInitCond {
-	std::shared_ptr<EMUniformFieldBody> body;	
-	EMUniformFieldInitCond(std::shared_ptr<EMUniformFieldBody> body_) : body(body_) {}
-	//use flat initial metric prims for now
-};
+	std::vector<Metric> metric(impl->ctx.gridVolume);
+	for (int k = 0; k < impl->ctx.gridVolume; ++k) {
+		const MetricPrims& metricPrims = impl->metricPrimGrid.v[k];
+		Metric& m = metric[k];
+		m.alphaMinusOne = metricPrims.alphaMinusOne;
+		for (int i = 0; i < subDim; ++i) {
+			m.betaU[i] = metricPrims.betaU(i);
+		}
+		m.hLL[0] = metricPrims.hLL(0,0);
+		m.hLL[1] = metricPrims.hLL(0,1);
+		m.hLL[2] = metricPrims.hLL(0,2);
+		m.hLL[3] = metricPrims.hLL(1,1);
+		m.hLL[4] = metricPrims.hLL(1,2);
+		m.hLL[5] = metricPrims.hLL(2,2);
+	}
+	return metric;
+}
 
-struct EMLineInitCond : public FlatInitCond {
-	std::shared_ptr<EMLineBody> body;
-	EMLineInitCond(std::shared_ptr<EMLineBody> body_) : body(body_) {}
-};
+double EFESoln::SolverContext::getResidual() const {
+	return impl->residual;
+}
 
+#ifndef EFESOLN_LIBRARY
 int main(int argc, char** argv) {	
 
 	//std::cout << "mass=" << mass << std::endl;		//m
@@ -2084,461 +6477,780 @@ int main(int argc, char** argv) {
 	//std::cout << "volume=" << volume << std::endl;	//m^3
 	//std::cout << "density=" << density << std::endl;	//m^-2
 
+	Context ctx;
+	Parallel::Parallel mainParallel(numThreads);
+	Workspace mainWorkspace(&ctx, &mainParallel);
+	EMFieldGrids mainEMFields;
+	ctx.numThreads = numThreads;
+	ctx.parallel = &mainParallel;
+	ctx.workspace = &mainWorkspace;
+	ctx.emFields = &mainEMFields;
+
 	LuaCxx::State lua;
 	lua.loadFile("config.lua");
-	
-	int maxiter = std::numeric_limits<int>::max();
-	if (!lua["maxiter"].isNil()) lua["maxiter"] >> maxiter;	
-	std::cout << "maxiter=" << maxiter << std::endl;
 
-	std::string bodyName = "earth";
-	if (!lua["body"].isNil()) lua["body"] >> bodyName;
-	std::cout << "body=\"" << bodyName << "\"" << std::endl;
+	/*
+	runs = {{body='earth'}, {body='sun', size=32}, ...} runs each one back to back in this process
+	the keys of a run override the globals of the same name, and anything it leaves out comes from the globals
+	grids are kept between runs of the same size, and each run starts from the solution of the nearest run before it
+	 with the same body and extent, scaled by the mass ratio (which is exact to first order in the mass)
+	*/
+	int numRuns = 1;
+	const bool hasRuns = !lua["runs"].isNil();
+	if (hasRuns) {
+		if (!lua["runs"].isTable()) throw Common::Exception() << "runs is not a table";
+		for (numRuns = 0; !lua["runs"][numRuns+1].isNil(); ++numRuns) {}
+		if (!numRuns) throw Common::Exception() << "runs is empty";
+	}
 
-	std::string initCondName = "stellar_schwarzschild";
-	if (!lua["initCond"].isNil()) lua["initCond"] >> initCondName;
-	std::cout << "initCond=\"" << initCondName << "\"" << std::endl;
+	Tensor::Grid<Tensor::Vector<real, subDim>, subDim> xs;
+	Tensor::Grid<MetricPrims, subDim> metricPrimGrid;
+	Tensor::Grid<MetricPrims, subDim> dt_metricPrimGrid;	//first deriv
+	Tensor::Grid<StressEnergyPrims, subDim> stressEnergyPrimGrid;
 
-	std::string solverName = "jfnk";
-	if (!lua["solver"].isNil()) lua["solver"] >> solverName;	
-	std::cout << "solver=\"" << solverName << "\"" << std::endl;
+	struct SolvedRun {
+		std::string bodyName;
+		Tensor::Vector<real, subDim> xmin, xmax;
+		real mass;	//0 for bodies that aren't spherical
+		Tensor::Vector<int, subDim> sizev;
+		std::shared_ptr<Tensor::Grid<MetricPrims, subDim>> metricPrimGrid;
+	};
+	std::vector<SolvedRun> solvedRuns;
+
+	struct RunReport {
+		std::string bodyName;
+		Tensor::Vector<int, subDim> sizev;
+		real residual;
+		real gravityError;	//max |numerical - analytical| / max |analytical|, for spherical bodies
+		double seconds;
+	};
+	std::vector<RunReport> runReports;
+
+	for (int runIndex = 0; runIndex < numRuns; ++runIndex) {
+		auto runStart = std::chrono::high_resolution_clock::now();
+		if (hasRuns) std::cout << "run " << (runIndex+1) << " of " << numRuns << std::endl;
+
+		auto config = [&](const char* key) -> LuaCxx::Ref {
+			if (hasRuns && !lua["runs"][runIndex+1][key].isNil()) return lua["runs"][runIndex+1][key];
+			return lua[key];
+		};
+		
+		int maxiter = std::numeric_limits<int>::max();
+		if (!config("maxiter").isNil()) config("maxiter") >> maxiter;	
+		std::cout << "maxiter=" << maxiter << std::endl;
+
+		std::string bodyName = "earth";
+		if (!config("body").isNil()) config("body") >> bodyName;
+		std::cout << "body=\"" << bodyName << "\"" << std::endl;
+
+		std::string initCondName = "stellar_schwarzschild";
+		if (!config("initCond").isNil()) config("initCond") >> initCondName;
+		std::cout << "initCond=\"" << initCondName << "\"" << std::endl;
+
+		std::string solverName = "jfnk";
+		if (!config("solver").isNil()) config("solver") >> solverName;	
+		std::cout << "solver=\"" << solverName << "\"" << std::endl;
+
+		std::string lineSearchName = "bisect";
+		if (!config("lineSearch").isNil()) config("lineSearch") >> lineSearchName;	
+		std::cout << "lineSearch=\"" << lineSearchName << "\"" << std::endl;
+
+		//vectors the jfnk's GMRES carries between restarts and Newton steps
+		int gmresRecycle = 0;
+		if (!config("gmresRecycle").isNil()) config("gmresRecycle") >> gmresRecycle;
+		std::cout << "gmresRecycle=" << gmresRecycle << std::endl;
+
+		std::string preconditionerName = "none";
+		if (!config("preconditioner").isNil()) config("preconditioner") >> preconditionerName;
+		std::cout << "preconditioner=\"" << preconditionerName << "\"" << std::endl;
+
+		std::string jacobianName = "matrixfree";
+		if (!config("jacobian").isNil()) config("jacobian") >> jacobianName;
+		std::cout << "jacobian=\"" << jacobianName << "\"" << std::endl;
+
+		int jacobianReuse = 1;
+		if (!config("jacobianReuse").isNil()) config("jacobianReuse") >> jacobianReuse;
+		std::cout << "jacobianReuse=" << jacobianReuse << std::endl;
+
+		bool dirtyRegions = false;
+		if (!config("dirtyRegions").isNil()) config("dirtyRegions") >> dirtyRegions;
+		std::cout << "dirtyRegions=" << dirtyRegions << std::endl;
+
+		double dirtyRegionTolerance = 0;
+		if (!config("dirtyRegionTolerance").isNil()) config("dirtyRegionTolerance") >> dirtyRegionTolerance;
+		std::cout << "dirtyRegionTolerance=" << dirtyRegionTolerance << std::endl;
+
+		//pseudo-time steps to take before handing off to the solver
+		int warmStartSteps = 0;
+		if (!config("warmStartSteps").isNil()) config("warmStartSteps") >> warmStartSteps;
+		std::cout << "warmStartSteps=" << warmStartSteps << std::endl;
+
+		//weak-field solution to start from, before any warm start steps and the solver
+		bool linearizedWarmStart = false;
+		if (!config("linearizedWarmStart").isNil()) config("linearizedWarmStart") >> linearizedWarmStart;
+		std::cout << "linearizedWarmStart=" << linearizedWarmStart << std::endl;
+
+		//ramp the sources up from flat space, with the solver taking each step
+		bool continuation = false;
+		if (!config("continuation").isNil()) config("continuation") >> continuation;
+		std::cout << "continuation=" << continuation << std::endl;
+
+		double continuationStep = .1;
+		if (!config("continuationStep").isNil()) config("continuationStep") >> continuationStep;
+		std::cout << "continuationStep=" << continuationStep << std::endl;
+
+		//start the continuation from flat space instead of the init cond and warm starts
+		bool continuationFlatStart = false;
+		if (!config("continuationFlatStart").isNil()) config("continuationFlatStart") >> continuationFlatStart;
+		std::cout << "continuationFlatStart=" << continuationFlatStart << std::endl;
+
+		//these were #defines.  they are set each run, back to their defaults if the run doesn't say
+		ctx.convergeAlphaOnly = true;
+		if (!config("convergeAlphaOnly").isNil()) config("convergeAlphaOnly") >> ctx.convergeAlphaOnly;
+		std::cout << "convergeAlphaOnly=" << ctx.convergeAlphaOnly << std::endl;
+
+		printTime = false;
+		if (!config("printTime").isNil()) config("printTime") >> printTime;
+		std::cout << "printTime=" << printTime << std::endl;
+
+		printRanges = true;
+		if (!config("printRanges").isNil()) config("printRanges") >> printRanges;
+		std::cout << "printRanges=" << printRanges << std::endl;
+
+		ctx.useChargeCurrentForEM = false;
+		if (!config("useChargeCurrentForEM").isNil()) config("useChargeCurrentForEM") >> ctx.useChargeCurrentForEM;
+		std::cout << "useChargeCurrentForEM=" << ctx.useChargeCurrentForEM << std::endl;
+
+		//which calc_EinsteinLL kernel every residual evaluation uses
+		{
+			std::string einsteinName = "generated";
+			if (!config("einstein").isNil()) config("einstein") >> einsteinName;
+			std::cout << "einstein=\"" << einsteinName << "\"" << std::endl;
+			ctx.einsteinPath = getEinsteinPath(einsteinName);
+
+			std::string dGammaName = "metric";
+			if (!config("dGamma").isNil()) config("dGamma") >> dGammaName;
+			std::cout << "dGamma=\"" << dGammaName << "\"" << std::endl;
+			ctx.dGammaPath = getDGammaPath(dGammaName);
+		}
 
-	sizev = Tensor::Vector<int, subDim>(16, 16, 16);
-	if (!lua["size"].isNil()) {
-		if (lua["size"].isNumber()) {
-			for (int i = 0; i < subDim; ++i) {
-				lua["size"] >> sizev(i);
+		/*
+		size = 16 for a cube, or size = {16, 16, 32} per axis
+		or a sequence of grids, each solved in turn from the last one's solution: sizes = {16, 32, 64}, whose entries can be per-axis too
+		*/
+		std::vector<Tensor::Vector<int, subDim>> sizeSequence;
+		{
+			//a number is a cube, a table is per-axis
+			auto readSize = [&](LuaCxx::Ref ref, std::string name) -> Tensor::Vector<int, subDim> {
+				Tensor::Vector<int, subDim> size;
+				if (ref.isNumber()) {
+					int n;
+					ref >> n;
+					size = Tensor::Vector<int, subDim>(n, n, n);
+				} else if (ref.isTable()) {
+					for (int i = 0; i < subDim; ++i) {
+						if (!ref[i+1].isNumber()) throw Common::Exception() << name << "[" << (i+1) << "] is not a number";
+						ref[i+1] >> size(i);
+					}
+					if (!ref[subDim+1].isNil()) throw Common::Exception() << name << " has more than " << subDim << " entries.  use sizes for a sequence of grids";
+				} else {
+					throw Common::Exception() << name << " is not a number or a table";
+				}
+				return size;
+			};
+
+			//a run's size or sizes replaces both of the global ones
+			bool runSetsSize = hasRuns && !lua["runs"][runIndex+1]["size"].isNil();
+			bool runSetsSizes = hasRuns && !lua["runs"][runIndex+1]["sizes"].isNil();
+			bool hasSize = !config("size").isNil() && (runSetsSize || !runSetsSizes);
+			bool hasSizes = !config("sizes").isNil() && (runSetsSizes || !runSetsSize);
+			if (hasSize && hasSizes) {
+				throw Common::Exception() << "size and sizes are both set";
 			}
-		} else if (lua["size"].isTable()) {
-			for (int i = 0; i < subDim; ++i) {
-				if (!lua["size"][i+1].isNumber()) throw Common::Exception() << "size[" << (i+1) << "] is not a number";
-				lua["size"][i+1] >> sizev(i);
+			if (hasSizes) {
+				LuaCxx::Ref sizesRef = config("sizes");
+				if (!sizesRef.isTable()) throw Common::Exception() << "sizes is not a table";
+				for (int level = 0; !sizesRef[level+1].isNil(); ++level) {
+					sizeSequence.push_back(readSize(sizesRef[level+1], "sizes[" + std::to_string(level+1) + "]"));
+				}
+				if (sizeSequence.empty()) throw Common::Exception() << "sizes is empty";
+			} else if (hasSize) {
+				sizeSequence.push_back(readSize(config("size"), "size"));
+			} else {
+				sizeSequence.push_back(Tensor::Vector<int, subDim>(16, 16, 16));
 			}
 		}
-	}
-	std::cout << "size=" << sizev << std::endl;
+		std::cout << "size=";
+		{
+			const char* sep = "";
+			for (const Tensor::Vector<int, subDim>& size : sizeSequence) {
+				std::cout << sep << size;
+				sep = ", ";
+			}
+		}
+		std::cout << std::endl;
 
-	real bodyRadii = 2;
-	if (!lua["bodyRadii"].isNil()) {
-		double d = bodyRadii; lua["bodyRadii"] >> d; bodyRadii = d;
-	}
-	std::cout << "bodyRadii=" << bodyRadii << std::endl;
+		real bodyRadii = 2;
+		if (!config("bodyRadii").isNil()) {
+			double d = bodyRadii; config("bodyRadii") >> d; bodyRadii = d;
+		}
+		std::cout << "bodyRadii=" << bodyRadii << std::endl;
 
 
-	std::shared_ptr<Body> body;
-	{
-		struct {
-			const char* name;
-			std::function<std::shared_ptr<Body>()> func;
-		} bodies[] = {
-			{"Null", [&](){
-				return std::make_shared<NullBody>(2);
-			}},
-			
-			{"earth", [&](){
-				const real earthRadius = 6.37101e+6;	// m
-				const real earthMass = 5.9736e+24 * G / c / c;	// m
-				//earth volume: 1.0832120174985e+21 m^3
-				//earth density: 4.0950296770075e-24 1/m^2 = 5.5147098661212 g/cm^3, which is what Google says.
-				//note that G_tt = 8 pi T_tt = 8 pi rho ... for earth = 1.0291932119615e-22 m^-2
-				//const real schwarzschildRadius = 2 * mass;	//Schwarzschild radius: 8.87157 mm, which is accurate
-				//earth magnetic field at surface: .25-.26 gauss
-				//const real earthMagneticField = .45 * sqrt(.1 * G) / c;	// 1/m
-				return std::make_shared<SphericalBody>(earthRadius, earthMass);
-			}},
-		
-			{"sun", [&](){
-				const real sunRadius = 6.960e+8;	// m
-				const real sunMass = 1.9891e+30 * G / c / c;	// m
-				return std::make_shared<SphericalBody>(sunRadius, sunMass);
-			}},
-		
-			{"EMUniformField", [&](){
-				return std::make_shared<EMUniformFieldBody>(2);
-			}},
-			
-			{"em_line", [&](){
-				return std::make_shared<EMLineBody>(2);
-			}},
-		}, *p;
-	
-		for (p = bodies; p < endof(bodies); ++p) {
-			if (p->name == bodyName) {
-std::cout << "creating body " << bodyName << std::endl;				
-				body = p->func();
-				break;
+		std::shared_ptr<Body> body = createBody(bodyName);
+
+		//per-run overrides of a uniform spherical body's mass (kg) and radius (m)
+		if (!config("mass").isNil() || !config("radius").isNil()) {
+			std::shared_ptr<SphericalBody> sphericalBody = std::dynamic_pointer_cast<SphericalBody>(body);
+			if (!sphericalBody || std::dynamic_pointer_cast<PREMEarthBody>(body)) {
+				throw Common::Exception() << "mass and radius can only be overridden for uniform spherical bodies, not " << bodyName;
 			}
+			real radius = sphericalBody->radius;
+			real mass = sphericalBody->mass;
+			if (!config("radius").isNil()) {
+				double d; config("radius") >> d; radius = d;
+			}
+			if (!config("mass").isNil()) {
+				double d; config("mass") >> d; mass = d * G / c / c;
+			}
+			std::cout << "radius=" << radius << std::endl;
+			std::cout << "mass=" << mass << std::endl;
+			body = std::make_shared<SphericalBody>(radius, mass);
 		}
-		if (!body) {
-			throw Common::Exception() << "couldn't find body named " << bodyName;
-		}
-	}
-
 
-	xmin = Tensor::Vector<real, subDim>(-bodyRadii*body->radius, -bodyRadii*body->radius, -bodyRadii*body->radius),
-	xmax = Tensor::Vector<real, subDim>(bodyRadii*body->radius, bodyRadii*body->radius, bodyRadii*body->radius);
-	gridVolume = sizev.volume();
-	dx = (xmax - xmin) / sizev;
 
-	Tensor::Grid<Tensor::Vector<real, subDim>, subDim> xs;
-	Tensor::Grid<MetricPrims, subDim> metricPrimGrid;
-	Tensor::Grid<MetricPrims, subDim> dt_metricPrimGrid;	//first deriv
-	Tensor::Grid<StressEnergyPrims, subDim> stressEnergyPrimGrid;
+		ctx.xmin = Tensor::Vector<real, subDim>(-bodyRadii*body->radius, -bodyRadii*body->radius, -bodyRadii*body->radius),
+		ctx.xmax = Tensor::Vector<real, subDim>(bodyRadii*body->radius, bodyRadii*body->radius, bodyRadii*body->radius);
+		//the last level's solution, for the next to start from
+		Tensor::Vector<int, subDim> lastSizev;
+		Tensor::Grid<MetricPrims, subDim> lastMetricPrimGrid;
+		Tensor::Grid<MetricPrims, subDim> last_dt_metricPrimGrid;
 
-	time("allocating", [&]{ 
-		std::cout << std::endl;
-		size_t totalSize = 0;
-#define ALLOCATE_GRID(x)	allocateGrid(x, #x, sizev, totalSize)
-		ALLOCATE_GRID(xs);
-		ALLOCATE_GRID(metricPrimGrid);
-		ALLOCATE_GRID(dt_metricPrimGrid);	//first deriv
-		ALLOCATE_GRID(stressEnergyPrimGrid);
-		ALLOCATE_GRID(gLLs);
-		ALLOCATE_GRID(gUUs);
-		ALLOCATE_GRID(dt_gLLs);
-		ALLOCATE_GRID(d2t_gLLs);
-		//ALLOCATE_GRID(dt_gUUs);
-		ALLOCATE_GRID(dgLLLs);
-		//ALLOCATE_GRID(GammaLLLs);
-		ALLOCATE_GRID(GammaULLs);
+		struct LevelReport {
+			Tensor::Vector<int, subDim> sizev;
+			double seconds;
+			real residual;
+		};
+		std::vector<LevelReport> levelReports;
+
+		for (int level = 0; level < (int)sizeSequence.size(); ++level) {
+			auto levelStart = std::chrono::high_resolution_clock::now();
+			ctx.sizev = sizeSequence[level];
+			std::cout << "level " << level << " size=" << ctx.sizev << std::endl;
+			ctx.gridVolume = ctx.sizev.volume();
+			ctx.dx = (ctx.xmax - ctx.xmin) / ctx.sizev;
+
+			size_t totalSize = 0;
+			time("allocating", [&]{ 
+				std::cout << std::endl;
+#define ALLOCATE_GRID(x)	allocateGrid(x, #x, ctx.sizev, totalSize)
+				ALLOCATE_GRID(xs);
+				ALLOCATE_GRID(metricPrimGrid);
+				ALLOCATE_GRID(dt_metricPrimGrid);	//first deriv
+				ALLOCATE_GRID(stressEnergyPrimGrid);
+				ALLOCATE_GRID(ctx.workspace->gLLs);
+				ALLOCATE_GRID(ctx.workspace->gUUs);
+				//dt_gLLs and d2t_gLLs are allocated once we know if we are stationary
+				//ALLOCATE_GRID(dt_gUUs);
+				ALLOCATE_GRID(ctx.workspace->dgLLLs);
+				//ALLOCATE_GRID(GammaLLLs);
+				ALLOCATE_GRID(ctx.workspace->GammaULLs);
+				if (ctx.useChargeCurrentForEM) {
+					ALLOCATE_GRID(ctx.emFields->AUs);
+					ALLOCATE_GRID(ctx.emFields->EUs);
+					ALLOCATE_GRID(ctx.emFields->BUs);
+				}
 #undef ALLOCATE_GRID
-	});
+			});
 
-	//specify coordinates
-	time("calculating grid", [&]{
-		Tensor::RangeObj<subDim> range(Tensor::Vector<int,subDim>(), sizev);
-		parallel.foreach(range.begin(), range.end(), [&](const Tensor::Vector<int, subDim>& index) {
-			Tensor::Vector<real, subDim>& xi = xs(index);
-			for (int j = 0; j < subDim; ++j) {
-				xi(j) = (xmax(j) - xmin(j)) * ((real)index(j) + .5) / (real)sizev(j) + xmin(j);
+			//specify coordinates
+			time("calculating grid", [&]{
+				initCoords(ctx, xs);
+			});
+
+			//specify stress-energy primitives
+			//the stress-energy primitives combined with the current metric are used to compute the stress-energy tensor 
+			//this is done by choosing the 'body'
+
+			//initialize metric primitives
+			time("calculating stress-energy primitives", [&]{
+				body->initStressEnergyPrim(ctx, stressEnergyPrimGrid, xs);
+			});
+
+			//while we're here, set the 'useE' and 'useV' flags, to spare our calculations
+			time("determine what stress-energy variables to use", [&]() {
+				initStressEnergyFlags(ctx, stressEnergyPrimGrid);
+			});
+
+			//now group the cells by those flags, so calc_EFE_constraint can skip vacuum and run each group without branching
+			time("sorting stress-energy cells", [&]{
+				classifyStressEnergyCells(stressEnergyPrimGrid, ctx.stressEnergyCells);
+			});
+
+			{
+				std::shared_ptr<InitCond> initCond = createInitCond(initCondName, body, stressEnergyPrimGrid);
+
+				//initialize metric primitives
+				time("calculating metric primitives", [&]{
+					initCond->initMetricPrims(ctx, metricPrimGrid, xs);
+				});
+
+				//past the first level, start from the last level's solution instead
+				//the init cond still runs for whatever sources it sets, like stellar_tov's pressure
+				if (level > 0) {
+					time("interpolating the last level's solution", [&]{
+						interpolateGrid(ctx.parallel, metricPrimGrid, lastMetricPrimGrid, ctx.sizev, lastSizev);
+						interpolateGrid(ctx.parallel, dt_metricPrimGrid, last_dt_metricPrimGrid, ctx.sizev, lastSizev);
+					});
+				} else if (!solvedRuns.empty()) {
+					//start from the nearest already-solved run of the same body over the same domain:
+					//closest in log mass first, then closest in size
+					std::shared_ptr<SphericalBody> sphericalBody = std::dynamic_pointer_cast<SphericalBody>(body);
+					real mass = sphericalBody ? sphericalBody->mass : 0;
+					const SolvedRun* nearest = nullptr;
+					real nearestMassDist = 0;
+					int nearestSizeDist = 0;
+					for (const SolvedRun& solved : solvedRuns) {
+						if (solved.bodyName != bodyName || solved.xmin != ctx.xmin || solved.xmax != ctx.xmax) continue;
+						real massDist = mass > 0 && solved.mass > 0 ? fabs(log(mass / solved.mass)) : 0;
+						int sizeDist = 0;
+						for (int i = 0; i < subDim; ++i) sizeDist += abs(solved.sizev(i) - ctx.sizev(i));
+						if (!nearest || massDist < nearestMassDist || (massDist == nearestMassDist && sizeDist < nearestSizeDist)) {
+							nearest = &solved;
+							nearestMassDist = massDist;
+							nearestSizeDist = sizeDist;
+						}
+					}
+					if (nearest) {
+						time("interpolating the nearest solved run", [&]{
+							interpolateGrid(ctx.parallel, metricPrimGrid, *nearest->metricPrimGrid, ctx.sizev, nearest->sizev);
+							//weak field: the metric perturbation goes linearly with the mass
+							if (mass > 0 && nearest->mass > 0 && mass != nearest->mass) {
+								real scale = mass / nearest->mass;
+								for (int k = 0; k < ctx.gridVolume; ++k) {
+									real* x = (real*)&metricPrimGrid.v[k];
+									for (int j = 0; j < (int)(sizeof(MetricPrims) / sizeof(real)); ++j) {
+										x[j] *= scale;
+									}
+								}
+							}
+						});
+					}
+				}
 			}
-		});
-	});
 
-	//specify stress-energy primitives
-	//the stress-energy primitives combined with the current metric are used to compute the stress-energy tensor 
-	//this is done by choosing the 'body'
+			//no time derivatives?  then use the stationary calc_* functions and skip the d/dt grids
+			//(d2t_gLLs is only ever zero so far)
+			time("determining if the spacetime is stationary", [&]{
+				ctx.isStationary = true;
+				for (int k = 0; k < ctx.gridVolume; ++k) {
+					const MetricPrims& dt_metricPrims = dt_metricPrimGrid.v[k];
+					ctx.isStationary &= dt_metricPrims.alphaMinusOne == 0;
+					for (int i = 0; i < subDim; ++i) {
+						ctx.isStationary &= dt_metricPrims.betaU(i) == 0;
+						for (int j = 0; j <= i; ++j) {
+							ctx.isStationary &= dt_metricPrims.hLL(i,j) == 0;
+						}
+					}
+				}
+			});
+			std::cout << "stationary=" << ctx.isStationary << std::endl;
+			if (!ctx.isStationary) {
+				allocateGrid(ctx.workspace->dt_gLLs, "workspace.dt_gLLs", ctx.sizev, totalSize);
+				allocateGrid(ctx.workspace->d2t_gLLs, "workspace.d2t_gLLs", ctx.sizev, totalSize);
+			}
 
-	//initialize metric primitives
-	time("calculating stress-energy primitives", [&]{
-		body->initStressEnergyPrim(stressEnergyPrimGrid, xs);
-	});
+			std::shared_ptr<EFESolver> solver = createSolver(ctx, solverName, maxiter, lineSearchName, gmresRecycle, preconditionerName, jacobianName, jacobianReuse);
 
-	//while we're here, set the 'useE' and 'useV' flags, to spare our calculations
-	time("determine what stress-energy variables to use", [&]() {
-		Tensor::RangeObj<subDim> range(Tensor::Vector<int,subDim>(), sizev);
-		parallel.foreach(range.begin(), range.end(), [&](const Tensor::Vector<int, subDim>& index) {
-			StressEnergyPrims& stressEnergyPrims = stressEnergyPrimGrid(index);
-			
-			stressEnergyPrims.useV = false;
-			for (int i = 0; i < subDim; ++i) {
-				stressEnergyPrims.useV |= stressEnergyPrims.v(i) != 0;
+			if (dirtyRegions) {
+				solver->dirtyRegions = std::make_shared<DirtyRegionTracker>(dirtyRegionTolerance);
 			}
-			
-			stressEnergyPrims.useEM = false;
-#ifdef USE_CHARGE_CURRENT_FOR_EM
-			stressEnergyPrims.useEM |= stressEnergyPrims.chargeDensity != 0;
-			for (int i = 0; i < subDim; ++i) {
-				stressEnergyPrims.useEM |= stressEnergyPrims.currentDensity(i) != 0;
+
+			//the continuation and the warm starts are only for the first level.  the rest start from the level before them
+			if (continuation && level == 0) {
+				solver = std::make_shared<ContinuationSolver>(solver, continuationStep, continuationFlatStart);
 			}
-#else
-			for (int i = 0; i < subDim; ++i) {
-				stressEnergyPrims.useEM |= stressEnergyPrims.E(i) != 0;
-				stressEnergyPrims.useEM |= stressEnergyPrims.B(i) != 0;
+
+			if (linearizedWarmStart && level == 0) {
+				time("linearized warm start", [&]{
+					LinearizedSolver warmStart(ctx, 1);
+					warmStart.dirtyRegions = solver->dirtyRegions;
+					warmStart.solve(
+						metricPrimGrid, 
+						dt_metricPrimGrid, 	//first deriv
+						stressEnergyPrimGrid);
+				});
 			}
-#endif
-		});
-	});
 
-	{
-		struct {
-			const char* name;
-			std::function<std::shared_ptr<InitCond>()> func;
-		} initConds[] = {
-			{"flat", [&](){ return std::make_shared<FlatInitCond>(); }},
-			{"stellar_schwarzschild", [&](){ 
-				std::shared_ptr<SphericalBody> sphericalBody = std::dynamic_pointer_cast<SphericalBody>(body);
-				assert(sphericalBody);
-				return std::make_shared<StellarSchwarzschildInitCond>(sphericalBody);
-			}},
-			{"stellar_kerr_newman", [&](){ 
-				std::shared_ptr<SphericalBody> sphericalBody = std::dynamic_pointer_cast<SphericalBody>(body);
-				assert(sphericalBody);
-				return std::make_shared<StellarKerrNewmanInitCond>(sphericalBody);
-			}},
-			{"EMUniformField", [&](){ 
-				std::shared_ptr<EMUniformFieldBody> emFieldBody = std::dynamic_pointer_cast<EMUniformFieldBody>(body);
-				assert(emFieldBody);
-				return std::make_shared<EMUniformFieldInitCond>(emFieldBody);
-			}},
-			{"em_line", [&](){ 
-				std::shared_ptr<EMLineBody> emLineBody = std::dynamic_pointer_cast<EMLineBody>(body);
-				assert(emLineBody);
-				return std::make_shared<EMLineInitCond>(emLineBody);
-			}},
-		}, *p;
+			if (warmStartSteps > 0 && level == 0) {
+				time("warm start", [&]{
+					PseudoTimeSolver warmStart(ctx, warmStartSteps);
+					warmStart.dirtyRegions = solver->dirtyRegions;
+					warmStart.solve(
+						metricPrimGrid, 
+						dt_metricPrimGrid, 	//first deriv
+						stressEnergyPrimGrid);
+				});
+			}
 
-		std::shared_ptr<InitCond> initCond;
-		for (p = initConds; p < endof(initConds); ++p) {
-			if (p->name == initCondName) {
-				initCond = p->func();
-				break;
+			if (maxiter > 0) {
+				solver->solve(
+					metricPrimGrid, 
+					dt_metricPrimGrid, 	//first deriv
+					stressEnergyPrimGrid);
+			}
+
+			if (solver->dirtyRegions) {
+				std::cout << "dirty regions: recomputed " << solver->dirtyRegions->cellsRecomputed 
+					<< " cells over " << solver->dirtyRegions->evaluations << " evaluations"
+					<< " of " << (long)ctx.gridVolume * solver->dirtyRegions->evaluations 
+					<< std::endl;
+			}
+
+			real residual = solver->calcResidual(metricPrimGrid, dt_metricPrimGrid, stressEnergyPrimGrid);
+			std::chrono::duration<double> levelTime = std::chrono::high_resolution_clock::now() - levelStart;
+			levelReports.push_back({ctx.sizev, levelTime.count(), residual});
+			std::cout << "level " << level << " size=" << ctx.sizev << " time=" << levelTime.count() << "s residual=" << residual << std::endl;
+
+			if (level < (int)sizeSequence.size() - 1) {
+				lastSizev = ctx.sizev;
+				lastMetricPrimGrid.resize(ctx.sizev);
+				last_dt_metricPrimGrid.resize(ctx.sizev);
+				std::copy(metricPrimGrid.v, metricPrimGrid.v + ctx.gridVolume, lastMetricPrimGrid.v);
+				std::copy(dt_metricPrimGrid.v, dt_metricPrimGrid.v + ctx.gridVolume, last_dt_metricPrimGrid.v);
 			}
 		}
-		if (!initCond) {
-			throw Common::Exception() << "couldn't find initial condition named " << initCondName;
+
+		if (levelReports.size() > 1) {
+			std::cout << "level\tsize\ttime(s)\tresidual" << std::endl;
+			for (int level = 0; level < (int)levelReports.size(); ++level) {
+				const LevelReport& report = levelReports[level];
+				std::cout << level << "\t" << report.sizev << "\t" << report.seconds << "\t" << report.residual << std::endl;
+			}
 		}
 
-		//initialize metric primitives
-		time("calculating metric primitives", [&]{
-			initCond->initMetricPrims(metricPrimGrid, xs);
-		});
-	}
+		//solve this body for each of ensembleMasses (kg) together, starting from this solution scaled by the mass ratio
+		if (!config("ensembleMasses").isNil()) {
+			std::shared_ptr<SphericalBody> sphericalBody = std::dynamic_pointer_cast<SphericalBody>(body);
+			if (!sphericalBody || std::dynamic_pointer_cast<PREMEarthBody>(body)) {
+				throw Common::Exception() << "ensembleMasses only works with uniform spherical bodies, not " << bodyName;
+			}
+			std::vector<real> masses;
+			for (int i = 1; !config("ensembleMasses")[i].isNil(); ++i) {
+				double d; config("ensembleMasses")[i] >> d;
+				masses.push_back(d * G / c / c);
+			}
+			std::cout << "ensembleMasses=" << masses.size() << " in ensembles of " << ensembleWidth << std::endl;
+
+			int ensembleMaxIter = 1000;
+			if (!config("ensembleMaxIter").isNil()) config("ensembleMaxIter") >> ensembleMaxIter;
+			std::cout << "ensembleMaxIter=" << ensembleMaxIter << std::endl;
+
+			//relative to each mass's starting residual
+			double ensembleTolerance = 1e-6;
+			if (!config("ensembleTolerance").isNil()) config("ensembleTolerance") >> ensembleTolerance;
+			std::cout << "ensembleTolerance=" << ensembleTolerance << std::endl;
+
+			std::vector<std::shared_ptr<Tensor::Grid<MetricPrims, subDim>>> ensembleMetricPrimGrids;
+			std::vector<std::shared_ptr<Tensor::Grid<StressEnergyPrims, subDim>>> ensembleStressEnergyPrimGrids;
+			std::vector<Tensor::Grid<MetricPrims, subDim>*> metricPrimGridPtrs;
+			std::vector<const Tensor::Grid<StressEnergyPrims, subDim>*> stressEnergyPrimGridPtrs;
+			for (real mass : masses) {
+				std::shared_ptr<Tensor::Grid<MetricPrims, subDim>> ensembleMetricPrimGrid = std::make_shared<Tensor::Grid<MetricPrims, subDim>>(ctx.sizev);
+				std::shared_ptr<Tensor::Grid<StressEnergyPrims, subDim>> ensembleStressEnergyPrimGrid = std::make_shared<Tensor::Grid<StressEnergyPrims, subDim>>(ctx.sizev);
+				std::shared_ptr<SphericalBody> ensembleBody = std::make_shared<SphericalBody>(sphericalBody->radius, mass);
+				ensembleBody->initStressEnergyPrim(ctx, *ensembleStressEnergyPrimGrid, xs);
+				//stellar_tov's pressure depends on the mass, so it gets recomputed.  its metric is overwritten below
+				if (initCondName == "stellar_tov") {
+					StellarTOVInitCond(ensembleBody, *ensembleStressEnergyPrimGrid).initMetricPrims(ctx, *ensembleMetricPrimGrid, xs);
+				}
+				initStressEnergyFlags(ctx, *ensembleStressEnergyPrimGrid);
+				real scale = mass / sphericalBody->mass;
+				for (int k = 0; k < ctx.gridVolume; ++k) {
+					const real* src = (const real*)&metricPrimGrid.v[k];
+					real* dst = (real*)&ensembleMetricPrimGrid->v[k];
+					for (int j = 0; j < (int)(sizeof(MetricPrims) / sizeof(real)); ++j) {
+						dst[j] = src[j] * scale;
+					}
+				}
+				ensembleMetricPrimGrids.push_back(ensembleMetricPrimGrid);
+				ensembleStressEnergyPrimGrids.push_back(ensembleStressEnergyPrimGrid);
+				metricPrimGridPtrs.push_back(ensembleMetricPrimGrid.get());
+				stressEnergyPrimGridPtrs.push_back(ensembleStressEnergyPrimGrid.get());
+			}
 
-	std::shared_ptr<EFESolver> solver;
-	{
-		struct {
-			const char* name;
-			std::function<std::shared_ptr<EFESolver>()> func;
-		} solvers[] = {
-			{"jfnk", [&](){ return std::make_shared<JFNKSolver>(maxiter); }},
-			{"gmres", [&](){ return std::make_shared<GMRESSolver>(maxiter); }},
-			{"conjres", [&](){ return std::make_shared<ConjResSolver>(maxiter); }},
-			{"conjgrad", [&](){ return std::make_shared<ConjGradSolver>(maxiter); }},
-		}, *p;
-		for (p = solvers; p < endof(solvers); ++p) {
-			if (p->name == solverName) {
-				solver = p->func();
+			std::vector<real> residuals = EnsembleSolver(ctx, ensembleMaxIter, ensembleTolerance).solve(metricPrimGridPtrs, dt_metricPrimGrid, stressEnergyPrimGridPtrs);
+
+			std::cout << "mass(kg)\tresidual\tmin alpha" << std::endl;
+			for (int i = 0; i < (int)masses.size(); ++i) {
+				real minAlpha = std::numeric_limits<real>::infinity();
+				for (int k = 0; k < ctx.gridVolume; ++k) {
+					minAlpha = std::min<real>(minAlpha, ensembleMetricPrimGrids[i]->v[k].alphaMinusOne + 1.);
+				}
+				std::cout << masses[i] * c * c / G << "\t" << residuals[i] << "\t" << std::setprecision(16) << minAlpha << std::setprecision(6) << std::endl;
 			}
 		}
-		if (!solver) {
-			throw Common::Exception() << "couldn't find solver named " << solverName;
-		}
-	}
 
-	if (maxiter > 0) {
-		solver->solve(
-			metricPrimGrid, 
-			dt_metricPrimGrid, 	//first deriv
-			stressEnergyPrimGrid);
-	}
+		//once all is solved for, do some final calculations ...
 
-	//once all is solved for, do some final calculations ...
+		time("calculating g_ab and g^ab", [&]{
+			calc_gLLs_and_gUUs(
+				//input:
+				metricPrimGrid,
+				dt_metricPrimGrid,	//first deriv
+				//output:
+				*ctx.workspace);
+		});
 
-	time("calculating g_ab and g^ab", [&]{
-		calc_gLLs_and_gUUs(
-			//input:
-			metricPrimGrid,
-			dt_metricPrimGrid,	//first deriv
-			//output:
-			gLLs, gUUs, dt_gLLs);
-	});
+		time("calculating Gamma^a_bc", [&]{
+			calc_GammaULLs(*ctx.workspace);
+		});
 
-	time("calculating Gamma^a_bc", [&]{
-		calc_GammaULLs(gLLs, gUUs, dt_gLLs, GammaULLs);
-	});
+		if (ctx.useChargeCurrentForEM) {
+			time("solving for A^a", [&]{
+				calc_EMFields(*ctx.workspace, stressEnergyPrimGrid);
+			});
+		}
 
-	Tensor::Grid<TensorSL, subDim> EFEGrid(sizev);
-	time("calculating EFE constraint", [&]{
-		calc_EFE_constraint(metricPrimGrid, stressEnergyPrimGrid, EFEGrid);
-	});
+		Tensor::Grid<TensorSL, subDim> EFEGrid(ctx.sizev);
+		time("calculating EFE constraint", [&]{
+			calc_EFE_constraint(*ctx.workspace, metricPrimGrid, stressEnergyPrimGrid, EFEGrid);
+		});
 
-	Tensor::Grid<real, subDim> numericalGravity(sizev);
-	time("calculating numerical gravitational force", [&]{
-		Tensor::RangeObj<subDim> range(Tensor::Vector<int,subDim>(), sizev);
-		parallel.foreach(range.begin(), range.end(), [&](const Tensor::Vector<int, subDim>& index) {
-			Tensor::Vector<real, subDim> xi = xs(index);
-			real r = xi.length();
-			//numerical computational...		
-			TensorUSL &GammaULL = GammaULLs(index);
-//the analytical calculations on these are identical, provided Gamma^i_tt is the schwarzschild metric connection
-//but the acceleration magnitude method can't show sign
+		Tensor::Grid<real, subDim> numericalGravity(ctx.sizev);
+		time("calculating numerical gravitational force", [&]{
+			Tensor::RangeObj<subDim> range(Tensor::Vector<int,subDim>(), ctx.sizev);
+			ctx.parallel->foreach(range.begin(), range.end(), [&](const Tensor::Vector<int, subDim>& index) {
+				Tensor::Vector<real, subDim> xi = xs(index);
+				real r = xi.length();
+				//numerical computational...		
+				TensorUSL &GammaULL = ctx.workspace->GammaULLs(index);
+	//the analytical calculations on these are identical, provided Gamma^i_tt is the schwarzschild metric connection
+	//but the acceleration magnitude method can't show sign
 #if 1 // here's change-of-coordinate from G^i_tt to G^r_tt
-			//Gamma^r_tt = Gamma^i_tt dr/dx^i
-			//r^2 = x^2 + y^2 + z^2
-			//so dr/dx^i = x^i / r
-			numericalGravity(index) = (GammaULL(1,0,0) * xi(0) / r
-									+ GammaULL(2,0,0) * xi(1) / r
-									+ GammaULL(3,0,0) * xi(2) / r)
-									* c * c;	//times c twice because of the two timelike components of a^i = Gamma^i_tt
+				//Gamma^r_tt = Gamma^i_tt dr/dx^i
+				//r^2 = x^2 + y^2 + z^2
+				//so dr/dx^i = x^i / r
+				numericalGravity(index) = (GammaULL(1,0,0) * xi(0) / r
+										+ GammaULL(2,0,0) * xi(1) / r
+										+ GammaULL(3,0,0) * xi(2) / r)
+										* c * c;	//times c twice because of the two timelike components of a^i = Gamma^i_tt
 #endif
 #if 0	//here's taking the acceleration in cartesian and computing the magnitude of the acceleration vector
-			numericalGravity(index) = sqrt(GammaULL(1,0,0) * GammaULL(1,0,0)
-										+ GammaULL(2,0,0) * GammaULL(2,0,0)
-										+ GammaULL(3,0,0) * GammaULL(3,0,0))
-										* c * c;	//times c twice because of the two timelike components of a^i = Gamma^i_tt
+				numericalGravity(index) = sqrt(GammaULL(1,0,0) * GammaULL(1,0,0)
+											+ GammaULL(2,0,0) * GammaULL(2,0,0)
+											+ GammaULL(3,0,0) * GammaULL(3,0,0))
+											* c * c;	//times c twice because of the two timelike components of a^i = Gamma^i_tt
 #endif
+			});
 		});
-	});
-
-	Tensor::Grid<real, subDim> analyticalGravity(sizev);
-	std::shared_ptr<SphericalBody> sphericalBody = std::dynamic_pointer_cast<SphericalBody>(body);
-	if (sphericalBody) {
-		time("calculating analytical gravitational force", [&]{
-			Tensor::RangeObj<subDim> range(Tensor::Vector<int,subDim>(), sizev);
-			parallel.foreach(range.begin(), range.end(), [&](const Tensor::Vector<int, subDim>& index) {
-				Tensor::Vector<real, subDim> xi = xs(index);
-				real r = xi.length();
-				//substitute the schwarzschild R for 2 m(r)
-				real matterRadius = std::min<real>(r, sphericalBody->radius);
-				real volumeOfMatterRadius = 4./3.*M_PI*matterRadius*matterRadius*matterRadius;
-				real m = sphericalBody->density * volumeOfMatterRadius;	// m^3
-
-				//now that I'm using the correct alpha equation, my dm/dr term is causing the analytical gravity calculation to be off ...
-				//real dm_dr = r > radius ? 0 : density * 4 * M_PI * matterRadius * matterRadius;
-				// ... maybe it shouldn't be there to begin with?
-				real dm_dr = 0;
-				real GammaUr_tt = (2*m * (r - 2*m) + 2 * dm_dr * r * (2*m - r)) / (2 * r * r * r)
-					* c * c;	//+9 at earth surface, without matter derivatives
 
-				//acceleration is -Gamma^r_tt along the radial direction (i.e. upwards from the surface), or Gamma^r_tt downward into the surface
-				analyticalGravity(index) = GammaUr_tt;
+		Tensor::Grid<real, subDim> analyticalGravity(ctx.sizev);
+		std::shared_ptr<SphericalBody> sphericalBody = std::dynamic_pointer_cast<SphericalBody>(body);
+		if (sphericalBody) {
+			time("calculating analytical gravitational force", [&]{
+				Tensor::RangeObj<subDim> range(Tensor::Vector<int,subDim>(), ctx.sizev);
+				ctx.parallel->foreach(range.begin(), range.end(), [&](const Tensor::Vector<int, subDim>& index) {
+					Tensor::Vector<real, subDim> xi = xs(index);
+					real r = xi.length();
+					//substitute the schwarzschild R for 2 m(r)
+					real matterRadius = std::min<real>(r, sphericalBody->radius);
+					real volumeOfMatterRadius = 4./3.*M_PI*matterRadius*matterRadius*matterRadius;
+					real m = sphericalBody->density * volumeOfMatterRadius;	// m^3
+
+					//now that I'm using the correct alpha equation, my dm/dr term is causing the analytical gravity calculation to be off ...
+					//real dm_dr = r > radius ? 0 : density * 4 * M_PI * matterRadius * matterRadius;
+					// ... maybe it shouldn't be there to begin with?
+					real dm_dr = 0;
+					real GammaUr_tt = (2*m * (r - 2*m) + 2 * dm_dr * r * (2*m - r)) / (2 * r * r * r)
+						* c * c;	//+9 at earth surface, without matter derivatives
+
+					//acceleration is -Gamma^r_tt along the radial direction (i.e. upwards from the surface), or Gamma^r_tt downward into the surface
+					analyticalGravity(index) = GammaUr_tt;
+				});
 			});
-		});
-	}
+		}
 
-	{
-		struct Col {
-			std::string name;
-			std::function<real(Tensor::Vector<int,subDim>)> func;
-		};
-		std::vector<Col> cols = {
-			{"ix", [&](Tensor::Vector<int,subDim> index)->real{ return index(0); }},
-			{"iy", [&](Tensor::Vector<int,subDim> index)->real{ return index(1); }},
-			{"iz", [&](Tensor::Vector<int,subDim> index)->real{ return index(2); }},
-			{"rho", [&](Tensor::Vector<int,subDim> index)->real{ return stressEnergyPrimGrid(index).rho; }},
-			{"det_h", [&](Tensor::Vector<int,subDim> index)->real{ return Tensor::determinant33<real, TensorSLsub>(metricPrimGrid(index).hLL); }},
-			{"alpha-1", [&](Tensor::Vector<int,subDim> index)->real{ return metricPrimGrid(index).alphaMinusOne; }},
+		real gravityError = NAN;
+		if (sphericalBody) {
+			real maxError = 0, maxAnalytical = 0;
+			for (int k = 0; k < ctx.gridVolume; ++k) {
+				maxError = std::max<real>(maxError, fabs(numericalGravity.v[k] - analyticalGravity.v[k]));
+				maxAnalytical = std::max<real>(maxAnalytical, fabs(analyticalGravity.v[k]));
+			}
+			gravityError = maxError / maxAnalytical;
+			std::cout << "gravity error=" << gravityError << std::endl;
+		}
+
+		{
+			struct Col {
+				std::string name;
+				std::function<real(Tensor::Vector<int,subDim>)> func;
+			};
+			std::vector<Col> cols = {
+				{"ix", [&](Tensor::Vector<int,subDim> index)->real{ return index(0); }},
+				{"iy", [&](Tensor::Vector<int,subDim> index)->real{ return index(1); }},
+				{"iz", [&](Tensor::Vector<int,subDim> index)->real{ return index(2); }},
+				{"rho", [&](Tensor::Vector<int,subDim> index)->real{ return stressEnergyPrimGrid(index).rho; }},
+				{"det_h", [&](Tensor::Vector<int,subDim> index)->real{ return Tensor::determinant33<real, TensorSLsub>(metricPrimGrid(index).hLL); }},
+				{"alpha-1", [&](Tensor::Vector<int,subDim> index)->real{ return metricPrimGrid(index).alphaMinusOne; }},
 #if 0	//within 1e-23			
-			{"ortho_error", [&](Tensor::Vector<int,subDim> index)->real{
-				const TensorSL &gLL = gLLs(index);
-				const TensorSU &gUU = gUUs(index);
-				real err = 0;
-				for (int a = 0; a < dim; ++a) {
-					for (int b = 0; b < dim; ++b) {
-						real sum = 0;
-						for (int c = 0; c < dim; ++c) {
-							sum += gLL(a,c) * gUU(c,b);
+				{"ortho_error", [&](Tensor::Vector<int,subDim> index)->real{
+					const TensorSL &gLL = gLLs(index);
+					const TensorSU &gUU = gUUs(index);
+					real err = 0;
+					for (int a = 0; a < dim; ++a) {
+						for (int b = 0; b < dim; ++b) {
+							real sum = 0;
+							for (int c = 0; c < dim; ++c) {
+								sum += gLL(a,c) * gUU(c,b);
+							}
+							err += fabs(sum - (real)(a == b));
 						}
-						err += fabs(sum - (real)(a == b));
 					}
-				}
-				return err;
-			}},
+					return err;
+				}},
 #endif
 #if 1		// numerical gravity is double what analytical gravity is ... and flips to negative as it passes the planet surface ...
-			{"gravity", [&](Tensor::Vector<int,subDim> index)->real{ return numericalGravity(index); }},
-		};
-		if (sphericalBody) {
-			cols.push_back({"analyticalGravity", [&](Tensor::Vector<int,subDim> index)->real{ return analyticalGravity(index); }});
-		}
-		std::vector<Col> moreCols = {
+				{"gravity", [&](Tensor::Vector<int,subDim> index)->real{ return numericalGravity(index); }},
+			};
+			if (sphericalBody) {
+				cols.push_back({"analyticalGravity", [&](Tensor::Vector<int,subDim> index)->real{ return analyticalGravity(index); }});
+			}
+			std::vector<Col> moreCols = {
 #endif
-			{"EFE_tt(g/cm^3)", [&](Tensor::Vector<int,subDim> index)->real{
-				return EFEGrid(index)(0,0) / (8. * M_PI) * c * c / G / 1000.;	// g/cm^3 ... so in absense of any curvature, the constraint error will now match the density
-			}},
-			{"EFE_ti", [&](Tensor::Vector<int,subDim> index)->real{ 
-				TensorSL &t = EFEGrid(index);
-				return sqrt( t(0,1)*t(0,1) + t(0,2)*t(0,2) + t(0,3)*t(0,3) ) * c;
-			}},
-			{"EFE_ij", [&](Tensor::Vector<int,subDim> index) -> real {
-				TensorSL &t = EFEGrid(index);
-				/* determinant
-				return t(1,1) * t(2,2) * t(3,3)
-					+ t(1,2) * t(2,3) * t(3,1)
-					+ t(1,3) * t(2,1) * t(3,2)
-					- t(1,3) * t(2,2) * t(3,1)
-					- t(1,1) * t(2,3) * t(3,2)
-					- t(1,2) * t(2,1) * t(3,3);
-				*/
-				// norm
-				real sum = 0;
-				for (int a = 1; a < dim; ++a) {
-					for (int b = 1; b < dim; ++b) {
-						sum += t(a,b)*t(a,b);
+				{"EFE_tt(g/cm^3)", [&](Tensor::Vector<int,subDim> index)->real{
+					return EFEGrid(index)(0,0) / (8. * M_PI) * c * c / G / 1000.;	// g/cm^3 ... so in absense of any curvature, the constraint error will now match the density
+				}},
+				{"EFE_ti", [&](Tensor::Vector<int,subDim> index)->real{ 
+					TensorSL &t = EFEGrid(index);
+					return sqrt( t(0,1)*t(0,1) + t(0,2)*t(0,2) + t(0,3)*t(0,3) ) * c;
+				}},
+				{"EFE_ij", [&](Tensor::Vector<int,subDim> index) -> real {
+					TensorSL &t = EFEGrid(index);
+					/* determinant
+					return t(1,1) * t(2,2) * t(3,3)
+						+ t(1,2) * t(2,3) * t(3,1)
+						+ t(1,3) * t(2,1) * t(3,2)
+						- t(1,3) * t(2,2) * t(3,1)
+						- t(1,1) * t(2,3) * t(3,2)
+						- t(1,2) * t(2,1) * t(3,3);
+					*/
+					// norm
+					real sum = 0;
+					for (int a = 1; a < dim; ++a) {
+						for (int b = 1; b < dim; ++b) {
+							sum += t(a,b)*t(a,b);
+						}
 					}
-				}
-				return sqrt(sum);
-			}},
+					return sqrt(sum);
+				}},
 #if 1
-			{"G_ab", [&](Tensor::Vector<int,subDim> index)->real{
-				TensorSL G = calc_EinsteinLL(index, gLLs, gUUs, GammaULLs);
-				real sum = 0;
-				for (int a = 0; a < dim; ++a) {
-					for (int b = 0; b < dim; ++b) {
-						sum += G(a,b) * G(a,b);
+				{"G_ab", [&](Tensor::Vector<int,subDim> index)->real{
+					TensorSL G = calc_EinsteinLL(*ctx.workspace, index);
+					real sum = 0;
+					for (int a = 0; a < dim; ++a) {
+						for (int b = 0; b < dim; ++b) {
+							sum += G(a,b) * G(a,b);
+						}
 					}
-				}
-				return sqrt(sum);
-			}},
+					return sqrt(sum);
+				}},
 #endif
-		};
-		cols.insert(cols.end(), moreCols.begin(), moreCols.end());
-
-		if (!lua["outputFilename"].isNil()) {
-			std::string outputFilename;
-			lua["outputFilename"] >> outputFilename;
+			};
+			cols.insert(cols.end(), moreCols.begin(), moreCols.end());
+
+			if (!config("outputFilename").isNil()) {
+				std::string outputFilename;
+				config("outputFilename") >> outputFilename;
+				//runs sharing the top-level filename each get their own: out.txt -> out_2.txt
+				if (numRuns > 1 && lua["runs"][runIndex+1]["outputFilename"].isNil()) {
+					size_t dot = outputFilename.find_last_of('.');
+					size_t slash = outputFilename.find_last_of('/');
+					if (dot == std::string::npos || (slash != std::string::npos && slash > dot)) dot = outputFilename.length();
+					outputFilename.insert(dot, "_" + std::to_string(runIndex+1));
+				}
 
-			std::ofstream file(outputFilename);
-			if (!file.good()) throw Common::Exception() << "failed to open file " << outputFilename;
+				std::ofstream file(outputFilename);
+				if (!file.good()) throw Common::Exception() << "failed to open file " << outputFilename;
 
-			file << "#";
-			{
-				const char* tab = "";
-				for (std::vector<Col>::iterator p = cols.begin(); p != cols.end(); ++p) {
-					file << tab << p->name;
-					tab = "\t";
-				}
-			}
-			file << std::endl;
-			time("outputting", [&]{
-				//this is printing output, so don't do it in parallel		
-				Tensor::RangeObj<subDim> range(Tensor::Vector<int,subDim>(), sizev);
-				for (Tensor::RangeObj<subDim>::iterator iter = range.begin(); iter != range.end(); ++iter) {
+				file << "#";
+				{
 					const char* tab = "";
 					for (std::vector<Col>::iterator p = cols.begin(); p != cols.end(); ++p) {
-						file << tab << std::setprecision(16) << p->func(iter.index) << std::setprecision(6);
+						file << tab << p->name;
 						tab = "\t";
 					}
-					file << std::endl;
 				}
-			});
-			
-			file.close();
+				file << std::endl;
+				time("outputting", [&]{
+					//this is printing output, so don't do it in parallel		
+					Tensor::RangeObj<subDim> range(Tensor::Vector<int,subDim>(), ctx.sizev);
+					for (Tensor::RangeObj<subDim>::iterator iter = range.begin(); iter != range.end(); ++iter) {
+						const char* tab = "";
+						for (std::vector<Col>::iterator p = cols.begin(); p != cols.end(); ++p) {
+							file << tab << std::setprecision(16) << p->func(iter.index) << std::setprecision(6);
+							tab = "\t";
+						}
+						file << std::endl;
+					}
+				});
+				
+				file.close();
+			}
 		}
-	}
 
 #if 0
-	{
-		Tensor::RangeObj<subDim> range(Tensor::Vector<int,subDim>(), sizev);
-		
-		real EFE_tt_min = std::numeric_limits<real>::infinity();
-		real EFE_tt_max = -std::numeric_limits<real>::infinity();
-		std::for_each(range.begin(), range.end(), [&](const Tensor::Vector<int, subDim>& index) {
-			real EFE_tt = EFEGrid(index)(0,0);
-			if (EFE_tt < EFE_tt_min) EFE_tt_min = EFE_tt;
-			if (EFE_tt > EFE_tt_max) EFE_tt_max = EFE_tt;
-		});
-		std::cout << "EFE_tt range: " << EFE_tt_min << " to " << EFE_tt_max << std::endl;
+		{
+			Tensor::RangeObj<subDim> range(Tensor::Vector<int,subDim>(), ctx.sizev);
+			
+			real EFE_tt_min = std::numeric_limits<real>::infinity();
+			real EFE_tt_max = -std::numeric_limits<real>::infinity();
+			std::for_each(range.begin(), range.end(), [&](const Tensor::Vector<int, subDim>& index) {
+				real EFE_tt = EFEGrid(index)(0,0);
+				if (EFE_tt < EFE_tt_min) EFE_tt_min = EFE_tt;
+				if (EFE_tt > EFE_tt_max) EFE_tt_max = EFE_tt;
+			});
+			std::cout << "EFE_tt range: " << EFE_tt_min << " to " << EFE_tt_max << std::endl;
+
+			int bins = 256;
+			std::vector<real> EFE_tt_distr(bins);
+			std::for_each(range.begin(), range.end(), [&](const Tensor::Vector<int, subDim>& index) {
+				real EFE_tt = EFEGrid(index)(0,0);
+				int bin = (int)((EFE_tt - EFE_tt_min) / (EFE_tt_max - EFE_tt_min) * (real)bins);
+				if (bin == bins) --bin;
+				++EFE_tt_distr[bin];
+			});
 
-		int bins = 256;
-		std::vector<real> EFE_tt_distr(bins);
-		std::for_each(range.begin(), range.end(), [&](const Tensor::Vector<int, subDim>& index) {
-			real EFE_tt = EFEGrid(index)(0,0);
-			int bin = (int)((EFE_tt - EFE_tt_min) / (EFE_tt_max - EFE_tt_min) * (real)bins);
-			if (bin == bins) --bin;
-			++EFE_tt_distr[bin];
-		});
+			std::cout << "EFE_tt:" << std::endl;
+			for (int i = 0; i < bins; ++i) {
+				real delta = EFE_tt_max - EFE_tt_min;
+				std::cout << (delta * (real)i / (real)bins + EFE_tt_min) << "\t" 
+						<< (delta * (real)(i+1) / (real)bins + EFE_tt_min) << "\t"
+						<< EFE_tt_distr[i] << std::endl;
+			}
+		}
+#endif
+
+		std::chrono::duration<double> runTime = std::chrono::high_resolution_clock::now() - runStart;
+		runReports.push_back({bodyName, ctx.sizev, levelReports.back().residual, gravityError, runTime.count()});
 
-		std::cout << "EFE_tt:" << std::endl;
-		for (int i = 0; i < bins; ++i) {
-			real delta = EFE_tt_max - EFE_tt_min;
-			std::cout << (delta * (real)i / (real)bins + EFE_tt_min) << "\t" 
-					<< (delta * (real)(i+1) / (real)bins + EFE_tt_min) << "\t"
-					<< EFE_tt_distr[i] << std::endl;
+		//keep the solution around for later runs to start from
+		if (runIndex < numRuns - 1) {
+			std::shared_ptr<Tensor::Grid<MetricPrims, subDim>> solvedMetricPrimGrid = std::make_shared<Tensor::Grid<MetricPrims, subDim>>(ctx.sizev);
+			std::copy(metricPrimGrid.v, metricPrimGrid.v + ctx.gridVolume, solvedMetricPrimGrid->v);
+			solvedRuns.push_back({bodyName, ctx.xmin, ctx.xmax, sphericalBody ? sphericalBody->mass : 0, ctx.sizev, solvedMetricPrimGrid});
+		}
+	}
+
+	if (numRuns > 1) {
+		std::cout << "run\tbody\tsize\tresidual\tgravity error\ttime(s)" << std::endl;
+		for (int runIndex = 0; runIndex < numRuns; ++runIndex) {
+			const RunReport& report = runReports[runIndex];
+			std::cout << (runIndex+1) << "\t" << report.bodyName << "\t" << report.sizev << "\t" << report.residual << "\t" << report.gravityError << "\t" << report.seconds << std::endl;
 		}
 	}
-#endif
 
 	std::cout << "done!" << std::endl;
 }
+#endif	//EFESOLN_LIBRARY